@@ -0,0 +1,624 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <atomic>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+#include <sdl/error.hpp>
+#include <sdl/mutex.hpp>
+#include <sdl/rwops.hpp>
+#include <sdl/thread.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides asynchronous positional reads over a native rw_ops.
+
+enum class async_rw_backend
+{
+  automatic  , // The io_uring backend if available, the thread pool backend otherwise.
+  io_uring   , // Linux only. Requires a file backed native rw_ops (e.g. from `sdl::rw_from_file`).
+  thread_pool
+};
+
+using async_read_result   = std::expected<std::size_t, std::string>;
+using async_read_callback = std::function<void(const async_read_result&)>;
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+// Minimal submission and completion queue pair over the raw io_uring system calls. Not thread safe.
+class io_uring_queue
+{
+public:
+  explicit io_uring_queue  (const std::uint32_t entries)
+  {
+    io_uring_params parameters {};
+    descriptor_ = static_cast<std::int32_t>(::syscall(__NR_io_uring_setup, entries, &parameters));
+    if (descriptor_ < 0)
+    {
+      set_error(std::string("io_uring_setup failed: ") + std::strerror(errno));
+      return;
+    }
+
+    sq_ring_size_ = parameters.sq_off.array + parameters.sq_entries * sizeof(std::uint32_t);
+    cq_ring_size_ = parameters.cq_off.cqes  + parameters.cq_entries * sizeof(io_uring_cqe);
+    if (parameters.features & IORING_FEAT_SINGLE_MMAP)
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    sqes_size_    = parameters.sq_entries * sizeof(io_uring_sqe);
+
+    sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor_, IORING_OFF_SQ_RING);
+    cq_ring_ = parameters.features & IORING_FEAT_SINGLE_MMAP ? sq_ring_ :
+               ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor_, IORING_OFF_CQ_RING);
+    sqes_    = ::mmap(nullptr, sqes_size_   , PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor_, IORING_OFF_SQES);
+    if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED)
+    {
+      set_error(std::string("io_uring mmap failed: ") + std::strerror(errno));
+      release();
+      return;
+    }
+
+    const auto sq_ring = static_cast<std::byte*>(sq_ring_);
+    const auto cq_ring = static_cast<std::byte*>(cq_ring_);
+    sq_head_  = reinterpret_cast<std::uint32_t*>(sq_ring + parameters.sq_off.head        );
+    sq_tail_  = reinterpret_cast<std::uint32_t*>(sq_ring + parameters.sq_off.tail        );
+    sq_mask_  = *reinterpret_cast<std::uint32_t*>(sq_ring + parameters.sq_off.ring_mask  );
+    sq_array_ = reinterpret_cast<std::uint32_t*>(sq_ring + parameters.sq_off.array       );
+    cq_head_  = reinterpret_cast<std::uint32_t*>(cq_ring + parameters.cq_off.head        );
+    cq_tail_  = reinterpret_cast<std::uint32_t*>(cq_ring + parameters.cq_off.tail        );
+    cq_mask_  = *reinterpret_cast<std::uint32_t*>(cq_ring + parameters.cq_off.ring_mask  );
+    cqes_     = reinterpret_cast<io_uring_cqe* >(cq_ring + parameters.cq_off.cqes        );
+
+    entries_            = parameters.sq_entries;
+    completion_entries_ = parameters.cq_entries;
+  }
+  io_uring_queue           (const io_uring_queue&  that) = delete;
+  io_uring_queue           (      io_uring_queue&& temp) = delete;
+ ~io_uring_queue           ()
+  {
+    release();
+  }
+  io_uring_queue& operator=(const io_uring_queue&  that) = delete;
+  io_uring_queue& operator=(      io_uring_queue&& temp) = delete;
+
+  // Returns false if the submission queue is full.
+  bool         push_readv(const std::int32_t descriptor, const iovec* vector, const std::int64_t offset, const std::uint64_t user_data)
+  {
+    return push(IORING_OP_READV, descriptor, reinterpret_cast<std::uint64_t>(vector), 1, offset, user_data);
+  }
+  bool         push_nop  (                                                                              const std::uint64_t user_data)
+  {
+    return push(IORING_OP_NOP  , -1        , 0                                      , 0, 0     , user_data);
+  }
+  // Submits the pushed entries. Returns the number of submitted entries, or the negated error number.
+  std::int32_t submit    ()
+  {
+    const auto count = *sq_tail_ - std::atomic_ref(*sq_head_).load(std::memory_order_acquire);
+    while (true)
+    {
+      const auto result = static_cast<std::int32_t>(::syscall(__NR_io_uring_enter, descriptor_, count, 0, 0, nullptr, 0));
+      if (result < 0 && errno == EINTR)
+        continue;
+      return result < 0 ? -errno : result;
+    }
+  }
+  // Removes the pushed entries which are not consumed by the kernel (e.g. after a failed submission), and returns their
+  // user data. The kernel only consumes entries within `submit()`, hence this must not be called concurrently with it.
+  std::vector<std::uint64_t> withdraw()
+  {
+    std::vector<std::uint64_t> result;
+    const auto                 head = std::atomic_ref(*sq_head_).load(std::memory_order_acquire);
+    for (auto tail = *sq_tail_; tail != head; --tail)
+      result.push_back(static_cast<io_uring_sqe*>(sqes_)[sq_array_[(tail - 1) & sq_mask_]].user_data);
+    std::atomic_ref(*sq_tail_).store(head, std::memory_order_release);
+    return result;
+  }
+  std::int32_t wait      ()
+  {
+    return static_cast<std::int32_t>(::syscall(__NR_io_uring_enter, descriptor_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+  }
+
+  // Invokes `function(user_data, result)` for each completion, and releases the entries back to the kernel.
+  template <typename function_type>
+  void         drain     (function_type&& function)
+  {
+    auto       head = *cq_head_;
+    const auto tail = std::atomic_ref(*cq_tail_).load(std::memory_order_acquire);
+    for (; head != tail; ++head)
+    {
+      const auto& entry = cqes_[head & cq_mask_];
+      function(entry.user_data, entry.res);
+    }
+    std::atomic_ref(*cq_head_).store(head, std::memory_order_release);
+  }
+
+  [[nodiscard]]
+  std::uint32_t entries           () const noexcept
+  {
+    return entries_;
+  }
+  // The number of completions the kernel can hold. Keeping at most this many entries in flight prevents the completion
+  // queue from overflowing, in which case kernels without IORING_FEAT_NODROP drop the completions.
+  [[nodiscard]]
+  std::uint32_t completion_entries() const noexcept
+  {
+    return completion_entries_;
+  }
+  [[nodiscard]]
+  std::int32_t  native            () const noexcept
+  {
+    return descriptor_;
+  }
+
+private:
+  bool push   (const std::uint8_t opcode, const std::int32_t descriptor, const std::uint64_t address, const std::uint32_t length, const std::int64_t offset, const std::uint64_t user_data)
+  {
+    const auto tail = *sq_tail_;
+    if (tail - std::atomic_ref(*sq_head_).load(std::memory_order_acquire) >= entries_)
+      return false;
+
+    const auto index = tail & sq_mask_;
+    auto&      entry = static_cast<io_uring_sqe*>(sqes_)[index];
+    std::memset(&entry, 0, sizeof(io_uring_sqe));
+    entry.opcode    = opcode;
+    entry.fd        = descriptor;
+    entry.addr      = address;
+    entry.len       = length;
+    entry.off       = static_cast<std::uint64_t>(offset);
+    entry.user_data = user_data;
+
+    sq_array_[index] = index;
+    std::atomic_ref(*sq_tail_).store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  void release()
+  {
+    if (sqes_    && sqes_    != MAP_FAILED)
+      ::munmap(sqes_   , sqes_size_   );
+    if (cq_ring_ && cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+      ::munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_ && sq_ring_ != MAP_FAILED)
+      ::munmap(sq_ring_, sq_ring_size_);
+    if (descriptor_ >= 0)
+      ::close(descriptor_);
+
+    sqes_       = nullptr;
+    cq_ring_    = nullptr;
+    sq_ring_    = nullptr;
+    descriptor_ = -1;
+  }
+
+  std::int32_t   descriptor_         {-1};
+  std::uint32_t  entries_            {};
+  std::uint32_t  completion_entries_ {};
+
+  void*          sq_ring_            {};
+  void*          cq_ring_            {};
+  void*          sqes_               {};
+  std::size_t    sq_ring_size_       {};
+  std::size_t    cq_ring_size_       {};
+  std::size_t    sqes_size_          {};
+
+  std::uint32_t* sq_head_            {};
+  std::uint32_t* sq_tail_            {};
+  std::uint32_t  sq_mask_            {};
+  std::uint32_t* sq_array_           {};
+  std::uint32_t* cq_head_            {};
+  std::uint32_t* cq_tail_            {};
+  std::uint32_t  cq_mask_            {};
+  io_uring_cqe*  cqes_               {};
+};
+#endif
+
+// Queues positional reads against a native rw_ops and completes them in the background.
+// Futures become ready as soon as the read completes. Callbacks are invoked on the thread calling `poll()` or `wait()`,
+// which allows the completions to be consumed from the frame loop.
+//
+// Reads from file backed native rw_ops are issued with positional reads (io_uring or `pread`) and never touch the
+// position of the native rw_ops. Reads from any other native rw_ops are serialized, and move its position.
+// The io_uring backend keeps at most as many reads in flight as its completion queue holds, and queues the rest.
+class async_rw_reader
+{
+public:
+  // The constructor cannot transmit error state. You should use `sdl::make_async_rw_reader(...)` to handle errors.
+  explicit async_rw_reader  (native_rw_ops* source, const std::size_t thread_count = 2, const std::uint32_t queue_depth = 64, const async_rw_backend backend = async_rw_backend::automatic)
+  : source_(source)
+  {
+#if !defined(_WIN32)
+    if (source_ && source_->type == SDL_RWOPS_STDFILE && source_->hidden.stdio.fp)
+      descriptor_ = ::fileno(source_->hidden.stdio.fp);
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    if (backend != async_rw_backend::thread_pool && descriptor_ >= 0)
+    {
+      auto queue = std::make_unique<io_uring_queue>(queue_depth);
+      if (queue->native() >= 0)
+      {
+        queue_   = std::move(queue);
+        backend_ = async_rw_backend::io_uring;
+        if (auto thread = make_thread([this] { return reap(); }, "async_rw_reaper"))
+          threads_.push_back(std::move(thread.value()));
+        return;
+      }
+    }
+#endif
+    if (backend == async_rw_backend::io_uring)
+    {
+      set_error("The io_uring backend is not available for this native rw_ops.");
+      return;
+    }
+
+    backend_ = async_rw_backend::thread_pool;
+    for (std::size_t i = 0; i < std::max<std::size_t>(thread_count, 1); ++i)
+      if (auto thread = make_thread([this] { return work(); }, "async_rw_worker"))
+        threads_.push_back(std::move(thread.value()));
+  }
+  async_rw_reader           (const async_rw_reader&  that) = delete;
+  async_rw_reader           (      async_rw_reader&& temp) = delete;
+ ~async_rw_reader           ()
+  {
+    if (!threads_.empty())
+      wait();
+
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+      if (queue_ && !threads_.empty() && failure_.empty() && queue_->push_nop(0)) // The null user data wakes up and stops the reaper.
+        while (queue_->submit() == -EAGAIN)
+          std::this_thread::yield();
+#endif
+    }
+    work_available_.notify_all();
+    threads_.clear(); // Joins the threads.
+  }
+  async_rw_reader& operator=(const async_rw_reader&  that) = delete;
+  async_rw_reader& operator=(      async_rw_reader&& temp) = delete;
+
+  // The buffer must remain valid until the read completes.
+  [[nodiscard]]
+  std::future<async_read_result> read   (const std::int64_t offset, const std::span<std::byte>& buffer)
+  {
+    auto request = std::make_unique<read_request>(offset, buffer);
+    request->has_promise = true;
+    auto result = request->promise.get_future();
+    enqueue(std::move(request));
+    return result;
+  }
+  // The buffer must remain valid until the read completes. The callback is invoked by `poll()` or `wait()`.
+  void                           read   (const std::int64_t offset, const std::span<std::byte>& buffer, async_read_callback callback)
+  {
+    auto request = std::make_unique<read_request>(offset, buffer);
+    request->callback = std::move(callback);
+    enqueue(std::move(request));
+  }
+
+  // Invokes the callbacks of the completed reads on the calling thread. Returns the number of invoked callbacks.
+  std::size_t                    poll   ()
+  {
+    std::vector<std::unique_ptr<read_request>> completed;
+    {
+      std::lock_guard lock(mutex_);
+      completed.swap(completed_);
+    }
+    for (auto& request : completed)
+      request->callback(request->result);
+    return completed.size();
+  }
+  // Blocks until all queued reads complete, then invokes their callbacks on the calling thread.
+  std::size_t                    wait   ()
+  {
+    {
+      std::lock_guard lock(mutex_);
+      while (outstanding_ > 0)
+        all_completed_.wait(mutex_);
+    }
+    return poll();
+  }
+
+  [[nodiscard]]
+  std::size_t                    pending() const
+  {
+    std::lock_guard lock(mutex_);
+    return outstanding_;
+  }
+  [[nodiscard]]
+  async_rw_backend               backend() const noexcept
+  {
+    return backend_;
+  }
+  [[nodiscard]]
+  bool                           is_running() const noexcept
+  {
+    return !threads_.empty();
+  }
+  [[nodiscard]]
+  native_rw_ops*                 source () const noexcept
+  {
+    return source_;
+  }
+
+private:
+  struct read_request
+  {
+    read_request(const std::int64_t offset, const std::span<std::byte>& buffer)
+    : offset(offset), buffer(buffer)
+    {
+
+    }
+
+    std::int64_t                          offset      ;
+    std::span<std::byte>                  buffer      ;
+    std::promise<async_read_result>       promise     {};
+    bool                                  has_promise {false};
+    async_read_callback                   callback    {};
+    async_read_result                     result      {};
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    iovec                                 vector      {};
+    std::size_t                           transferred {}; // By the previous (short) reads.
+#endif
+  };
+
+  void         enqueue (std::unique_ptr<read_request> request)
+  {
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+    if (queue_)
+    {
+      std::vector<std::unique_ptr<read_request>> failed;
+      {
+        std::lock_guard lock(mutex_);
+        ++outstanding_;
+        if (!failure_.empty())
+        {
+          request->result = std::unexpected(failure_);
+          failed.push_back(std::move(request));
+        }
+        else
+        {
+          queued_.push_back(std::move(request)); // Submitted as soon as the queues have room, otherwise by the reaper.
+          failed = submit_queued();
+        }
+      }
+      for (auto& current : failed)
+        complete(std::move(current));
+      return;
+    }
+#endif
+    std::lock_guard lock(mutex_);
+    ++outstanding_;
+    queued_.push_back(std::move(request));
+    work_available_.notify_one();
+  }
+  void         complete(std::unique_ptr<read_request> request)
+  {
+    if (request->has_promise)
+      request->promise.set_value(request->result);
+
+    std::lock_guard lock(mutex_);
+    if (request->callback)
+      completed_.push_back(std::move(request));
+    if (--outstanding_ == 0)
+      all_completed_.notify_all();
+  }
+
+  async_read_result execute(read_request& request)
+  {
+    std::size_t total = 0;
+#if !defined(_WIN32)
+    if (descriptor_ >= 0)
+    {
+      while (total < request.buffer.size())
+      {
+        const auto result = ::pread(descriptor_, request.buffer.data() + total, request.buffer.size() - total, static_cast<off_t>(request.offset + static_cast<std::int64_t>(total)));
+        if (result < 0 && errno == EINTR)
+          continue;
+        if (result < 0)
+          return std::unexpected(std::string("pread failed: ") + std::strerror(errno));
+        if (result == 0)
+          break;
+        total += static_cast<std::size_t>(result);
+      }
+      return total;
+    }
+#endif
+    std::lock_guard lock(source_mutex_);
+    if (SDL_RWseek(source_, request.offset, RW_SEEK_SET) < 0)
+      return std::unexpected(get_error());
+    while (total < request.buffer.size())
+    {
+      const auto result = SDL_RWread(source_, request.buffer.data() + total, 1, request.buffer.size() - total);
+      if (result == 0)
+        break;
+      total += result;
+    }
+    return total;
+  }
+  std::int32_t work    ()
+  {
+    while (true)
+    {
+      std::unique_ptr<read_request> request;
+      {
+        std::lock_guard lock(mutex_);
+        while (queued_.empty() && !stopping_)
+          work_available_.wait(mutex_);
+        if (queued_.empty())
+          return 0;
+
+        request = std::move(queued_.front());
+        queued_.pop_front();
+      }
+      request->result = execute(*request);
+      complete(std::move(request));
+    }
+  }
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+  // Moves the queued requests into the submission queue while the completion queue has room for their completions, and
+  // submits them. Returns the requests which failed to be submitted. Requires the mutex to be locked.
+  std::vector<std::unique_ptr<read_request>> submit_queued()
+  {
+    std::uint32_t pushed = 0;
+    while (!queued_.empty() && in_flight_.size() < queue_->completion_entries())
+    {
+      auto& request   = queued_.front();
+      request->vector = iovec {request->buffer.data() + request->transferred, request->buffer.size() - request->transferred};
+      if (!queue_->push_readv(descriptor_, &request->vector, request->offset + static_cast<std::int64_t>(request->transferred), reinterpret_cast<std::uint64_t>(request.get())))
+        break;
+      const auto key = request.get();
+      in_flight_.emplace(key, std::move(request)); // Referenced by the kernel until completion.
+      queued_.pop_front();
+      ++pushed;
+    }
+
+    std::vector<std::unique_ptr<read_request>> failed;
+    if (pushed == 0)
+      return failed;
+    if (const auto result = queue_->submit(); result < 0)
+    {
+      const auto error = std::string("io_uring submission failed: ") + std::strerror(-result);
+      for (const auto user_data : queue_->withdraw())
+      {
+        auto node = in_flight_.extract(reinterpret_cast<read_request*>(user_data));
+        node.mapped()->result = std::unexpected(error);
+        failed.push_back(std::move(node.mapped()));
+      }
+    }
+    return failed;
+  }
+  // Fails the queued and in flight requests, as well as the future ones, after the completion queue became unusable.
+  // The kernel may still write into the buffers of the reads in flight.
+  void         fail    (const std::string& error)
+  {
+    std::vector<std::unique_ptr<read_request>> failed;
+    {
+      std::lock_guard lock(mutex_);
+      failure_ = error;
+      for (auto& request : queued_)
+        failed.push_back(std::move(request));
+      for (auto& [key, request] : in_flight_)
+        failed.push_back(std::move(request));
+      queued_   .clear();
+      in_flight_.clear();
+    }
+    for (auto& request : failed)
+    {
+      request->result = std::unexpected(error);
+      complete(std::move(request));
+    }
+  }
+  std::int32_t reap    ()
+  {
+    std::vector<std::pair<std::uint64_t, std::int32_t>> completions;
+    std::vector<std::unique_ptr<read_request>>          finished   ;
+    while (true)
+    {
+      if (queue_->wait() < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+      {
+        fail(std::string("io_uring wait failed: ") + std::strerror(errno));
+        return -1;
+      }
+
+      completions.clear();
+      queue_->drain([&] (const std::uint64_t user_data, const std::int32_t result)
+      {
+        completions.emplace_back(user_data, result);
+      });
+
+      bool stop = false;
+      {
+        std::lock_guard lock(mutex_);
+        for (const auto& [user_data, result] : completions)
+        {
+          if (user_data == 0) // The null user data wakes up and stops the reaper.
+          {
+            stop = true;
+            continue;
+          }
+
+          auto node    = in_flight_.extract(reinterpret_cast<read_request*>(user_data));
+          auto request = std::move(node.mapped());
+          if (result < 0)
+            request->result = std::unexpected(std::string("io_uring read failed: ") + std::strerror(-result));
+          else
+          {
+            request->transferred += static_cast<std::size_t>(result);
+            // Short reads are resubmitted for the remainder, unless the end of the file is reached.
+            if (result > 0 && request->transferred < request->buffer.size())
+            {
+              queued_.push_front(std::move(request));
+              continue;
+            }
+            request->result = request->transferred;
+          }
+          finished.push_back(std::move(request));
+        }
+
+        auto failed = submit_queued();
+        std::ranges::move(failed, std::back_inserter(finished));
+      }
+
+      for (auto& request : finished)
+        complete(std::move(request));
+      finished.clear();
+
+      if (stop)
+        return 0;
+    }
+  }
+
+  std::unique_ptr<io_uring_queue>                                   queue_          {};
+  std::unordered_map<read_request*, std::unique_ptr<read_request>>  in_flight_      {}; // Submitted to the kernel.
+  std::string                                                       failure_        {};
+#endif
+
+  native_rw_ops*                                                    source_         {};
+  std::int32_t                                                      descriptor_     {-1};
+  async_rw_backend                                                  backend_        {async_rw_backend::thread_pool};
+
+  mutex                                                             mutex_          {};
+  mutex                                                             source_mutex_   {};
+  condition_variable                                                work_available_ {};
+  condition_variable                                                all_completed_  {};
+  std::deque <std::unique_ptr<read_request>>                        queued_         {};
+  std::vector<std::unique_ptr<read_request>>                        completed_      {};
+  std::size_t                                                       outstanding_    {};
+  bool                                                              stopping_       {false};
+
+  std::vector<std::unique_ptr<thread>>                              threads_        {}; // Declared last to be joined before the rest is destroyed.
+};
+
+[[nodiscard]]
+inline std::expected<std::unique_ptr<async_rw_reader>, std::string> make_async_rw_reader(native_rw_ops* source, const std::size_t thread_count = 2, const std::uint32_t queue_depth = 64, const async_rw_backend backend = async_rw_backend::automatic)
+{
+  auto result = std::make_unique<async_rw_reader>(source, thread_count, queue_depth, backend);
+  if (!result->is_running())
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
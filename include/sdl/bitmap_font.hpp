@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sdl/rect.hpp>
+#include <sdl/rwops.hpp>
+#include <sdl/surface.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides bitmap fonts (e.g. generated by AngelCode BMFont or Hiero), which
+// are read through `sdl::rw_ops` and drawn through `sdl::glyph_cache`.
+
+struct bitmap_glyph
+{
+  std::size_t                 page   ;
+  rectangle<std::int32_t>     area   ; // In pixels of the page.
+  std::array<std::int32_t, 2> offset ; // From the pen position (at the top of the line) to the top left of the glyph.
+  std::int32_t                advance; // Of the pen position after the glyph.
+};
+
+struct bitmap_font
+{
+  [[nodiscard]]
+  const bitmap_glyph* glyph  (const char32_t codepoint) const
+  {
+    const auto iterator = glyphs.find(codepoint);
+    return iterator != glyphs.end() ? &iterator->second : nullptr;
+  }
+  [[nodiscard]]
+  std::int32_t        kerning(const char32_t first, const char32_t second) const
+  {
+    const auto iterator = kernings.find(static_cast<std::uint64_t>(first) << 32 | second);
+    return iterator != kernings.end() ? iterator->second : 0;
+  }
+
+  std::string                                     face       {};
+  std::int32_t                                    size       {}; // The height of the em square in pixels, at which the glyphs are drawn.
+  std::int32_t                                    line_height{};
+  std::int32_t                                    base       {}; // From the top of the line to the baseline.
+  std::vector<surface>                            pages      {};
+  std::unordered_map<char32_t     , bitmap_glyph> glyphs     {};
+  std::unordered_map<std::uint64_t, std::int32_t> kernings   {}; // Keyed by the first codepoint in the upper and the second in the lower 32 bits.
+};
+
+// Loads a page of a bitmap font, given the file name in the descriptor.
+using bitmap_font_page_loader = std::function<std::expected<surface, std::string>(const std::string& filename)>;
+
+// Reads a descriptor in the text format of AngelCode BMFont, i.e. lines of a tag followed by `key=value` attributes:
+//
+//   info face="Sans" size=16
+//   common lineHeight=19 base=15 pages=1
+//   page id=0 file="sans_0.bmp"
+//   char id=65 x=0 y=0 width=10 height=12 xoffset=0 yoffset=3 xadvance=11 page=0
+//   kerning first=65 second=86 amount=-1
+//
+// Unknown tags and attributes are ignored.
+[[nodiscard]]
+inline std::expected<bitmap_font, std::string> load_bitmap_font(native_rw_ops* ops, const bitmap_font_page_loader& page_loader)
+{
+  const auto data = load_file_rw(ops);
+  if (!data)
+    return std::unexpected(data.error());
+
+  bitmap_font                                      result;
+  std::int32_t                                     page_count {};
+  std::vector<std::pair<std::size_t, std::string>> page_files; // The ids and files of the pages, in order of declaration.
+
+  const std::string_view text(reinterpret_cast<const char*>(data->data()), data->size());
+  for (std::size_t line_start = 0, line_number = 1; line_start < text.size(); ++line_number)
+  {
+    auto line_end = text.find('\n', line_start);
+    if (line_end == std::string_view::npos)
+      line_end = text.size();
+    auto line = text.substr(line_start, line_end - line_start);
+    line_start = line_end + 1;
+
+    // Splits the line into the tag and the attributes. Quoted values may contain spaces.
+    std::string_view                                           tag;
+    std::vector<std::pair<std::string_view, std::string_view>> attributes;
+    for (std::size_t i = 0; i < line.size();)
+    {
+      if (line[i] == ' ' || line[i] == '\t' || line[i] == '\r')
+      {
+        ++i;
+        continue;
+      }
+
+      const auto key_start = i;
+      while (i < line.size() && line[i] != '=' && line[i] != ' ' && line[i] != '\t' && line[i] != '\r')
+        ++i;
+      const auto key = line.substr(key_start, i - key_start);
+      if (i >= line.size() || line[i] != '=')
+      {
+        if (tag.empty())
+          tag = key;
+        continue;
+      }
+
+      std::string_view value;
+      if (++i < line.size() && line[i] == '"')
+      {
+        const auto value_end = line.find('"', i + 1);
+        if (value_end == std::string_view::npos)
+          return std::unexpected("Unterminated string in line " + std::to_string(line_number) + " of the bitmap font.");
+        value = line.substr(i + 1, value_end - i - 1);
+        i     = value_end + 1;
+      }
+      else
+      {
+        const auto value_start = i;
+        while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r')
+          ++i;
+        value = line.substr(value_start, i - value_start);
+      }
+      attributes.emplace_back(key, value);
+    }
+
+    std::string error;
+    const auto  attribute = [&] (const std::string_view& key) -> std::string_view
+    {
+      for (const auto& [current, value] : attributes)
+        if (current == key)
+          return value;
+      return {};
+    };
+    const auto  integer   = [&] (const std::string_view& key, const std::int32_t fallback = 0)
+    {
+      const auto   value  = attribute(key);
+      std::int32_t number = fallback;
+      if (!value.empty() && std::from_chars(value.data(), value.data() + value.size(), number).ec != std::errc())
+        error = "Invalid attribute \"" + std::string(key) + "\" in line " + std::to_string(line_number) + " of the bitmap font.";
+      return number;
+    };
+
+    if      (tag == "info")
+    {
+      result.face = attribute("face");
+      result.size = std::abs(integer("size")); // Negative sizes denote the height of the characters rather than the cells.
+    }
+    else if (tag == "common")
+    {
+      result.line_height = integer("lineHeight");
+      result.base        = integer("base");
+      page_count         = std::max(integer("pages", 1), 0);
+    }
+    else if (tag == "page")
+    {
+      // The ids are checked against the declared count, since the files are only allocated once all pages are read.
+      const auto id = integer("id", -1);
+      if (id < 0 || id >= page_count)
+        error = "Invalid page id in line " + std::to_string(line_number) + " of the bitmap font.";
+      page_files.emplace_back(static_cast<std::size_t>(std::max(id, 0)), attribute("file"));
+    }
+    else if (tag == "char")
+    {
+      const auto id = integer("id", -1);
+      if (id < 0)
+        error = "Missing character id in line " + std::to_string(line_number) + " of the bitmap font.";
+      result.glyphs[static_cast<char32_t>(id)] = bitmap_glyph
+      {
+        static_cast<std::size_t>(std::max(integer("page"), 0)),
+        rectangle<std::int32_t>(integer("x"), integer("y"), integer("width"), integer("height")),
+        {integer("xoffset"), integer("yoffset")},
+        integer("xadvance")
+      };
+    }
+    else if (tag == "kerning")
+      result.kernings[static_cast<std::uint64_t>(static_cast<char32_t>(integer("first"))) << 32 | static_cast<char32_t>(integer("second"))] = integer("amount");
+
+    if (!error.empty())
+      return std::unexpected(error);
+  }
+
+  if (result.line_height <= 0)
+    return std::unexpected("The bitmap font has no line height.");
+  if (result.size <= 0)
+    result.size = result.line_height;
+
+  // The files are allocated for as many pages as were read, rather than declared. Duplicate ids leave a page missing.
+  if (page_files.size() != static_cast<std::size_t>(page_count))
+    return std::unexpected("The bitmap font misses a page.");
+  std::vector<std::string> files(page_files.size());
+  for (auto& [id, file] : page_files)
+    files[id] = std::move(file);
+
+  for (const auto& file : files)
+  {
+    if (file.empty())
+      return std::unexpected("The bitmap font misses a page.");
+    auto page = page_loader(file);
+    if (!page)
+      return std::unexpected(page.error());
+    result.pages.push_back(std::move(page.value()));
+  }
+  for (const auto& [codepoint, glyph] : result.glyphs)
+  {
+    const auto& area = glyph.area;
+    if (glyph.page >= result.pages.size() || area.x < 0 || area.y < 0 || area.w < 0 || area.h < 0 ||
+        area.w > result.pages[glyph.page].size()[0] - area.x || area.h > result.pages[glyph.page].size()[1] - area.y)
+      return std::unexpected("The glyph of codepoint " + std::to_string(static_cast<std::uint32_t>(codepoint)) + " lies outside its page.");
+  }
+
+  return result;
+}
+
+// Conveniences.
+
+[[nodiscard]]
+inline std::expected<bitmap_font, std::string> load_bitmap_font(const rw_ops& descriptor, const bitmap_font_page_loader& page_loader)
+{
+  return load_bitmap_font(descriptor.native(), page_loader);
+}
+// Loads the pages as BMP files, relative to the directory of the descriptor.
+[[nodiscard]]
+inline std::expected<bitmap_font, std::string> load_bitmap_font(const std::string& filepath)
+{
+  auto descriptor = make_rw_ops(filepath, "rb");
+  if (!descriptor)
+    return std::unexpected(descriptor.error());
+
+  const auto separator = filepath.find_last_of("/\\");
+  const auto directory = separator != std::string::npos ? filepath.substr(0, separator + 1) : std::string();
+  return load_bitmap_font(descriptor.value(), [&] (const std::string& filename) -> std::expected<surface, std::string>
+  {
+    auto page = make_rw_ops(directory + filename, "rb");
+    if (!page)
+      return std::unexpected(page.error());
+    return make_surface(page->native());
+  });
+}
+}
\ No newline at end of file
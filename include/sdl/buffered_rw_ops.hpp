@@ -0,0 +1,387 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sdl/endian.hpp>
+#include <sdl/error.hpp>
+#include <sdl/rwops.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a read-ahead and write-behind buffer over any native rw_ops.
+
+inline constexpr std::size_t default_rw_buffer_size = 64 * 1024;
+
+// A `sdl::rw_source` which serves reads and writes smaller than the buffer from memory, and accesses the parent only to
+// refill or flush the buffer. Pending writes are flushed on seek, size query, read and close.
+class buffered_rw_source
+{
+public:
+  explicit buffered_rw_source  (native_rw_ops* parent, const std::size_t buffer_size = default_rw_buffer_size, const bool auto_close = false)
+  : parent_    (parent)
+  , buffer_    (std::max<std::size_t>(buffer_size, 1))
+  , auto_close_(auto_close)
+  {
+    base_ = std::max<std::int64_t>(SDL_RWtell(parent_), 0); // Non-seekable parents start at zero.
+  }
+  buffered_rw_source           (const buffered_rw_source&  that) = delete;
+  buffered_rw_source           (      buffered_rw_source&& temp) = delete;
+ ~buffered_rw_source           ()                                = default;
+  buffered_rw_source& operator=(const buffered_rw_source&  that) = delete;
+  buffered_rw_source& operator=(      buffered_rw_source&& temp) = delete;
+
+  std::expected<std::int64_t, std::string> size (                                                                )
+  {
+    if (const auto result = flush(); !result)
+      return std::unexpected(result.error());
+    return rw_size(parent_);
+  }
+  std::expected<std::int64_t, std::string> seek (const std::int64_t offset, const seek_mode origin               )
+  {
+    if (const auto result = flush(); !result)
+      return std::unexpected(result.error());
+
+    if (origin != seek_mode::end)
+    {
+      const auto target = origin == seek_mode::set ? offset : base_ + static_cast<std::int64_t>(position_) + offset;
+      if (mode_ == mode::reading && target >= base_ && target <= base_ + static_cast<std::int64_t>(end_))
+      {
+        position_ = static_cast<std::size_t>(target - base_);
+        return target;
+      }
+
+      auto result = rw_seek(parent_, target, seek_mode::set);
+      if (!result)
+        return std::unexpected(result.error());
+      reset(result.value());
+      return result;
+    }
+
+    auto result = rw_seek(parent_, offset, seek_mode::end);
+    if (!result)
+      return std::unexpected(result.error());
+    reset(result.value());
+    return result;
+  }
+  std::expected<std::size_t , std::string> read (      void* buffer, const std::size_t size, const std::size_t count)
+  {
+    const auto bytes = size * count;
+    if (read_buffered(buffer, bytes))
+      return count;
+    if (bytes == 0)
+      return 0;
+
+    if (const auto result = flush(); !result)
+      return std::unexpected(result.error());
+
+    auto destination = static_cast<std::byte*>(buffer);
+    auto copied      = end_ - position_;
+    std::memcpy(destination, buffer_.data() + position_, copied);
+    reset(base_ + static_cast<std::int64_t>(end_));
+
+    const auto remaining = bytes - copied;
+    if (remaining >= buffer_.size())
+    {
+      // Large reads bypass the buffer.
+      const auto read = SDL_RWread(parent_, destination + copied, 1, remaining);
+      base_  += static_cast<std::int64_t>(read);
+      copied += read;
+    }
+    else
+    {
+      end_   = SDL_RWread(parent_, buffer_.data(), 1, buffer_.size());
+      mode_  = mode::reading;
+
+      const auto read = std::min(remaining, end_);
+      std::memcpy(destination + copied, buffer_.data(), read);
+      position_ = read;
+      copied   += read;
+    }
+    return copied / size;
+  }
+  std::expected<std::size_t , std::string> write(const void* buffer, const std::size_t size, const std::size_t count)
+  {
+    const auto bytes = size * count;
+    if (write_buffered(buffer, bytes))
+      return count;
+    if (bytes == 0)
+      return 0;
+
+    if (mode_ == mode::reading)
+    {
+      // The parent is ahead of the logical position by the unread part of the buffer.
+      const auto position = base_ + static_cast<std::int64_t>(position_);
+      if (end_ != position_)
+        if (const auto result = rw_seek(parent_, position, seek_mode::set); !result)
+          return std::unexpected(result.error());
+      reset(position);
+    }
+    if (const auto result = flush(); !result)
+      return std::unexpected(result.error());
+
+    if (bytes >= buffer_.size())
+    {
+      // Large writes bypass the buffer.
+      const auto written = SDL_RWwrite(parent_, buffer, 1, bytes);
+      base_ += static_cast<std::int64_t>(written);
+      if (written < bytes)
+        return std::unexpected(get_error());
+      return count;
+    }
+
+    std::memcpy(buffer_.data(), buffer, bytes);
+    end_      = bytes;
+    position_ = bytes;
+    mode_     = mode::writing;
+    return count;
+  }
+  std::expected<void        , std::string> close()
+  {
+    auto result = flush();
+    if (auto_close_ && parent_)
+    {
+      if (auto close_result = rw_close(parent_); !close_result && result)
+        result = std::move(close_result);
+      parent_ = nullptr;
+    }
+    return result;
+  }
+
+  // Fast paths. Return false without side effects if the request cannot be served by the buffer alone.
+  bool                                     read_buffered (      void* buffer, const std::size_t bytes) noexcept
+  {
+    if (mode_ != mode::reading || bytes > end_ - position_)
+      return false;
+    std::memcpy(buffer, buffer_.data() + position_, bytes);
+    position_ += bytes;
+    return true;
+  }
+  bool                                     write_buffered(const void* buffer, const std::size_t bytes) noexcept
+  {
+    if (mode_ != mode::writing || bytes > buffer_.size() - end_)
+      return false;
+    std::memcpy(buffer_.data() + end_, buffer, bytes);
+    end_     += bytes;
+    position_ = end_;
+    return true;
+  }
+
+  std::expected<void        , std::string> flush()
+  {
+    if (mode_ != mode::writing || end_ == 0)
+      return {};
+
+    const auto pending = end_;
+    const auto written = SDL_RWwrite(parent_, buffer_.data(), 1, pending);
+    reset(base_ + static_cast<std::int64_t>(written));
+    if (written < pending)
+      return std::unexpected(get_error());
+    return {};
+  }
+
+  [[nodiscard]]
+  std::int64_t                             tell       () const noexcept
+  {
+    return base_ + static_cast<std::int64_t>(position_);
+  }
+  [[nodiscard]]
+  std::size_t                              buffer_size() const noexcept
+  {
+    return buffer_.size();
+  }
+  [[nodiscard]]
+  native_rw_ops*                           parent     () const noexcept
+  {
+    return parent_;
+  }
+
+private:
+  enum class mode
+  {
+    none   ,
+    reading,
+    writing
+  };
+
+  void reset(const std::int64_t base) noexcept
+  {
+    base_     = base;
+    position_ = 0;
+    end_      = 0;
+    mode_     = mode::none;
+  }
+
+  native_rw_ops*         parent_     {};
+  std::vector<std::byte> buffer_     ;
+  bool                   auto_close_ {};
+
+  mode                   mode_       {mode::none};
+  std::int64_t           base_       {}; // The position of the parent corresponding to the start of the buffer.
+  std::size_t            position_   {}; // The logical position within the buffer.
+  std::size_t            end_        {}; // The number of valid bytes (reading) or pending bytes (writing) in the buffer.
+};
+
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<native_rw_ops*, std::string> rw_from_buffered(native_rw_ops* parent, const std::size_t buffer_size = default_rw_buffer_size, const bool auto_close = false)
+{
+  return rw_from_source(std::make_unique<buffered_rw_source>(parent, buffer_size, auto_close));
+}
+
+// A `sdl::rw_ops` whose reads and writes bypass the native rw_ops and the indirect calls it implies when called directly.
+// The native rw_ops remains usable with the rest of SDL, and shares the buffer with this object.
+class buffered_rw_ops : public rw_ops
+{
+public:
+  // The constructor cannot transmit error state. You should use `sdl::make_buffered_rw_ops(...)` to handle errors.
+  explicit buffered_rw_ops  (native_rw_ops* parent, const std::size_t buffer_size = default_rw_buffer_size, const bool auto_close = false)
+  : rw_ops (std::make_unique<buffered_rw_source>(parent, buffer_size, auto_close))
+  , source_(native_ ? static_cast<buffered_rw_source*>(native_->hidden.unknown.data1) : nullptr)
+  {
+
+  }
+  buffered_rw_ops           (const buffered_rw_ops&  that) = delete;
+  buffered_rw_ops           (      buffered_rw_ops&& temp) noexcept
+  : rw_ops (std::move(temp))
+  , source_(std::exchange(temp.source_, nullptr))
+  {
+
+  }
+ ~buffered_rw_ops           ()                             = default;
+  buffered_rw_ops& operator=(const buffered_rw_ops&  that) = delete;
+  buffered_rw_ops& operator=(      buffered_rw_ops&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      rw_ops::operator=(std::move(temp));
+      std::swap(source_, temp.source_);
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  std::expected<std::int64_t, std::string> size            () const
+  {
+    return source_->size();
+  }
+  [[nodiscard]]
+  std::expected<std::int64_t, std::string> tell            () const
+  {
+    return source_->tell();
+  }
+  [[nodiscard]]
+  std::expected<std::int64_t, std::string> seek            (const std::int64_t offset, const seek_mode origin = seek_mode::set) const
+  {
+    return source_->seek(offset, origin);
+  }
+  [[nodiscard]]
+  std::expected<std::size_t , std::string> read            (      void* buffer, const std::size_t size, const std::size_t count) const
+  {
+    if (source_->read_buffered(buffer, size * count))
+      return count;
+
+    auto result = source_->read (buffer, size, count);
+    if (result && !result.value() && count)
+      return std::unexpected(std::string("End of stream."));
+    return result;
+  }
+
+  std::expected<std::size_t , std::string> write           (const void* buffer, const std::size_t size, const std::size_t count)
+  {
+    if (source_->write_buffered(buffer, size * count))
+      return count;
+
+    return source_->write(buffer, size, count);
+  }
+  std::expected<void        , std::string> flush           ()
+  {
+    return source_->flush();
+  }
+
+  template <typename type> requires std::is_trivially_copyable_v<type> [[nodiscard]]
+  std::expected<std::size_t , std::string> read_as         (const std::span<      type>& buffer) const
+  {
+    if (source_->read_buffered(buffer.data(), buffer.size_bytes()))
+      return buffer.size();
+    return rw_read_as <type>(native_, buffer);
+  }
+  template <typename type> requires std::is_trivially_copyable_v<type>
+  std::expected<std::size_t , std::string> write_as        (const std::span<const type>& buffer)
+  {
+    if (source_->write_buffered(buffer.data(), buffer.size_bytes()))
+      return buffer.size();
+    return rw_write_as<type>(native_, buffer);
+  }
+
+  template <std::integral type> [[nodiscard]]
+  std::expected<type        , std::string> read_le_integer () const
+  {
+    type value {};
+    if (source_->read_buffered(&value, sizeof(type)))
+      return byteswap_le(value);
+    if (const auto result = read(&value, sizeof(type), 1); !result)
+      return std::unexpected(result.error());
+    return byteswap_le(value);
+  }
+  template <std::integral type> [[nodiscard]]
+  std::expected<type        , std::string> read_be_integer () const
+  {
+    type value {};
+    if (source_->read_buffered(&value, sizeof(type)))
+      return byteswap_be(value);
+    if (const auto result = read(&value, sizeof(type), 1); !result)
+      return std::unexpected(result.error());
+    return byteswap_be(value);
+  }
+  template <std::integral type>
+  std::expected<void        , std::string> write_le_integer(const type& value)
+  {
+    const auto swapped = byteswap_le(value);
+    if (source_->write_buffered(&swapped, sizeof(type)))
+      return {};
+    if (const auto result = write(&swapped, sizeof(type), 1); !result)
+      return std::unexpected(result.error());
+    return {};
+  }
+  template <std::integral type>
+  std::expected<void        , std::string> write_be_integer(const type& value)
+  {
+    const auto swapped = byteswap_be(value);
+    if (source_->write_buffered(&swapped, sizeof(type)))
+      return {};
+    if (const auto result = write(&swapped, sizeof(type), 1); !result)
+      return std::unexpected(result.error());
+    return {};
+  }
+
+  [[nodiscard]]
+  buffered_rw_source*                      source          () const noexcept
+  {
+    return source_;
+  }
+
+private:
+  buffered_rw_source* source_ {};
+};
+
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<buffered_rw_ops, std::string> make_buffered_rw_ops(native_rw_ops* parent, const std::size_t buffer_size = default_rw_buffer_size, const bool auto_close = false)
+{
+  auto result = buffered_rw_ops(parent, buffer_size, auto_close);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
@@ -0,0 +1,639 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sdl/endian.hpp>
+#include <sdl/error.hpp>
+#include <sdl/rwops.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a block-wise compressed stream over any native rw_ops, using a
+// bundled LZ77 codec similar to the LZ4 block format.
+//
+// Layout: A 12 byte header (magic, version, block size), followed by the blocks (32-bit stored size whose top bit
+// marks uncompressed blocks, 32-bit raw size, payload), followed by the block index (64-bit offsets of the blocks) and
+// a 28 byte trailer (index offset, block count, total raw size, magic). All values are little endian.
+
+inline constexpr std::size_t  default_compressed_block_size = 64 * 1024;
+inline constexpr std::int32_t default_compression_level     = 3;
+inline constexpr std::int32_t max_compression_level         = 9;
+
+enum class compressed_rw_mode
+{
+  read ,
+  write
+};
+
+// Compresses the input and appends the result to the output. Level 0 copies the input, higher levels search longer
+// match chains. Matches may not reach further back than 64 KiB.
+inline void                                    lz_compress  (const std::span<const std::byte>& input, std::vector<std::byte>& output, const std::int32_t level = default_compression_level)
+{
+  constexpr std::size_t   min_match   = 4;
+  constexpr std::size_t   max_offset  = 65535;
+  constexpr std::uint32_t hash_bits   = 16;
+
+  const auto write_length = [&] (std::size_t length)
+  {
+    for (; length >= 255; length -= 255)
+      output.push_back(std::byte{255});
+    output.push_back(static_cast<std::byte>(length));
+  };
+  const auto write_sequence = [&] (const std::byte* literals, const std::size_t literal_length, const std::size_t offset, const std::size_t match_length)
+  {
+    const auto match_code = match_length ? match_length - min_match : 0;
+    output.push_back(static_cast<std::byte>((std::min<std::size_t>(literal_length, 15) << 4) | std::min<std::size_t>(match_code, 15)));
+    if (literal_length >= 15)
+      write_length(literal_length - 15);
+    output.insert(output.end(), literals, literals + literal_length);
+    if (match_length)
+    {
+      output.push_back(static_cast<std::byte>(offset & 0xFF));
+      output.push_back(static_cast<std::byte>(offset >> 8  ));
+      if (match_code >= 15)
+        write_length(match_code - 15);
+    }
+  };
+
+  const auto data = input.data();
+  const auto size = input.size();
+  if (level <= 0 || size < min_match)
+  {
+    write_sequence(data, size, 0, 0);
+    return;
+  }
+
+  const auto depth = std::size_t(1) << (std::min(level, max_compression_level) - 1);
+  const auto hash  = [&] (const std::size_t position)
+  {
+    std::uint32_t value;
+    std::memcpy(&value, data + position, sizeof(value));
+    return (value * 2654435761u) >> (32 - hash_bits);
+  };
+
+  std::vector<std::int32_t> head (std::size_t(1) << hash_bits, -1); // Inputs are limited to 2 GiB by the stream format.
+  std::vector<std::int32_t> chain(size, -1);
+  const auto insert = [&] (const std::size_t position)
+  {
+    auto& entry     = head[hash(position)];
+    chain[position] = entry;
+    entry           = static_cast<std::int32_t>(position);
+  };
+
+  std::size_t anchor   = 0;
+  std::size_t position = 0;
+  while (position + min_match <= size)
+  {
+    std::size_t best_length = 0;
+    std::size_t best_offset = 0;
+
+    auto candidate = head[hash(position)];
+    for (std::size_t i = 0; i < depth && candidate >= 0 && position - static_cast<std::size_t>(candidate) <= max_offset; ++i)
+    {
+      const auto start  = static_cast<std::size_t>(candidate);
+      std::size_t length = 0;
+      while (position + length < size && data[start + length] == data[position + length])
+        ++length;
+      if (length > best_length)
+      {
+        best_length = length;
+        best_offset = position - start;
+      }
+      candidate = chain[start];
+    }
+    insert(position);
+
+    if (best_length < min_match)
+    {
+      ++position;
+      continue;
+    }
+
+    write_sequence(data + anchor, position - anchor, best_offset, best_length);
+    for (auto end = position + best_length; ++position < end;)
+      if (position + min_match <= size)
+        insert(position);
+    anchor = position;
+  }
+  write_sequence(data + anchor, size - anchor, 0, 0); // The last sequence consists of literals only.
+}
+// Decompresses the input into the output, which must be large enough. Returns the number of bytes decompressed.
+[[nodiscard]]
+inline std::expected<std::size_t, std::string> lz_decompress(const std::span<const std::byte>& input, const std::span<std::byte>& output)
+{
+  auto       source      = input .data();
+  const auto source_end  = source + input .size();
+  auto       target      = output.data();
+  const auto target_end  = target + output.size();
+
+  const auto read_length = [&] (std::size_t& length) -> bool
+  {
+    for (std::byte value {255}; value == std::byte{255};)
+    {
+      if (source == source_end)
+        return false;
+      value   = *source++;
+      length += static_cast<std::size_t>(value);
+    }
+    return true;
+  };
+
+  while (source < source_end)
+  {
+    const auto  token          = static_cast<std::uint8_t>(*source++);
+    std::size_t literal_length = token >> 4;
+    if (literal_length == 15 && !read_length(literal_length))
+      return std::unexpected(std::string("Corrupt compressed block."));
+    if (literal_length > static_cast<std::size_t>(source_end - source) || literal_length > static_cast<std::size_t>(target_end - target))
+      return std::unexpected(std::string("Corrupt compressed block."));
+    std::memcpy(target, source, literal_length);
+    source += literal_length;
+    target += literal_length;
+
+    if (source == source_end)
+      break;
+
+    if (source_end - source < 2)
+      return std::unexpected(std::string("Corrupt compressed block."));
+    const auto  offset       = static_cast<std::size_t>(source[0]) | static_cast<std::size_t>(source[1]) << 8;
+    source += 2;
+    std::size_t match_length = token & 0x0F;
+    if (match_length == 15 && !read_length(match_length))
+      return std::unexpected(std::string("Corrupt compressed block."));
+    match_length += 4;
+    if (offset == 0 || offset > static_cast<std::size_t>(target - output.data()) || match_length > static_cast<std::size_t>(target_end - target))
+      return std::unexpected(std::string("Corrupt compressed block."));
+
+    const auto match = target - offset;
+    if (offset >= match_length)
+      std::memcpy(target, match, match_length);
+    else
+      for (std::size_t i = 0; i < match_length; ++i) // Overlapping matches repeat the last `offset` bytes.
+        target[i] = match[i];
+    target += match_length;
+  }
+  return static_cast<std::size_t>(target - output.data());
+}
+
+// A `sdl::rw_source` which compresses the data written to, or decompresses the data read from the parent block by
+// block. Streams opened for reading are seekable through the block index, streams opened for writing are append-only
+// and are finalized on close. The parent must be seekable for reading.
+class compressed_rw_source
+{
+public:
+  // The constructor cannot transmit error state. Check `is_open()` and `sdl::get_error()` after construction.
+  explicit compressed_rw_source  (
+    native_rw_ops*           parent                                    ,
+    const compressed_rw_mode mode                                      ,
+    const std::int32_t       level      = default_compression_level    ,
+    const std::size_t        block_size = default_compressed_block_size,
+    const bool               auto_close = false                        )
+  : parent_    (parent)
+  , mode_      (mode  )
+  , level_     (std::clamp(level, 0, max_compression_level))
+  , block_size_(std::clamp<std::size_t>(block_size, 1, 0x7FFFFFFF))
+  , auto_close_(auto_close)
+  {
+    is_open_ = mode_ == compressed_rw_mode::read ? open_for_reading() : open_for_writing();
+  }
+  compressed_rw_source           (const compressed_rw_source&  that) = delete;
+  compressed_rw_source           (      compressed_rw_source&& temp) = delete;
+ ~compressed_rw_source           ()                                  = default;
+  compressed_rw_source& operator=(const compressed_rw_source&  that) = delete;
+  compressed_rw_source& operator=(      compressed_rw_source&& temp) = delete;
+
+  [[nodiscard]]
+  std::expected<std::int64_t, std::string> size (                                                                ) const
+  {
+    return static_cast<std::int64_t>(size_);
+  }
+  std::expected<std::int64_t, std::string> seek (const std::int64_t offset, const seek_mode origin               )
+  {
+    const auto base   = origin == seek_mode::set ? 0 : origin == seek_mode::cur ? static_cast<std::int64_t>(position_) : static_cast<std::int64_t>(size_);
+    const auto target = base + offset;
+    if (target < 0)
+      return std::unexpected(std::string("Seek before the start of the stream."));
+    if (mode_ == compressed_rw_mode::write && static_cast<std::size_t>(target) != position_)
+      return std::unexpected(std::string("Compressed streams opened for writing can not seek."));
+    position_ = static_cast<std::size_t>(target);
+    return target;
+  }
+  std::expected<std::size_t , std::string> read (      void* buffer, const std::size_t size, const std::size_t count)
+  {
+    if (mode_ != compressed_rw_mode::read)
+      return std::unexpected(std::string("Compressed stream is not opened for reading."));
+    if (size == 0 || count == 0 || position_ >= size_)
+      return 0;
+
+    const auto objects = std::min(count, (size_ - position_) / size);
+    auto       target  = static_cast<std::byte*>(buffer);
+    for (auto remaining = objects * size; remaining > 0;)
+    {
+      const auto index = position_ / block_size_;
+      if (index != block_index_)
+        if (const auto result = load_block(index); !result)
+          return std::unexpected(result.error());
+
+      const auto start  = position_ - index * block_size_;
+      const auto length = std::min(remaining, block_.size() - start);
+      std::memcpy(target, block_.data() + start, length);
+      target    += length;
+      position_ += length;
+      remaining -= length;
+    }
+    return objects;
+  }
+  std::expected<std::size_t , std::string> write(const void* buffer, const std::size_t size, const std::size_t count)
+  {
+    if (mode_ != compressed_rw_mode::write)
+      return std::unexpected(std::string("Compressed stream is not opened for writing."));
+
+    auto source = static_cast<const std::byte*>(buffer);
+    for (auto remaining = size * count; remaining > 0;)
+    {
+      const auto length = std::min(remaining, block_size_ - block_.size());
+      block_.insert(block_.end(), source, source + length);
+      source    += length;
+      remaining -= length;
+      size_     += length; // The buffered bytes are committed to the stream, even if writing the block fails.
+      position_  = size_;
+      if (block_.size() == block_size_)
+        if (const auto result = write_block(); !result)
+          return std::unexpected(result.error());
+    }
+    return count;
+  }
+  std::expected<void        , std::string> close()
+  {
+    std::expected<void, std::string> result {};
+    if (mode_ == compressed_rw_mode::write && is_open_)
+      result = finalize();
+    is_open_ = false;
+
+    if (auto_close_ && parent_)
+    {
+      if (auto close_result = rw_close(parent_); !close_result && result)
+        result = std::move(close_result);
+      parent_ = nullptr;
+    }
+    return result;
+  }
+
+  [[nodiscard]]
+  bool                                     is_open        () const noexcept
+  {
+    return is_open_;
+  }
+  [[nodiscard]]
+  compressed_rw_mode                       mode           () const noexcept
+  {
+    return mode_;
+  }
+  [[nodiscard]]
+  std::int32_t                             level          () const noexcept
+  {
+    return level_;
+  }
+  [[nodiscard]]
+  std::size_t                              block_size     () const noexcept
+  {
+    return block_size_;
+  }
+  [[nodiscard]]
+  std::size_t                              block_count    () const noexcept
+  {
+    return offsets_.size();
+  }
+  // The number of bytes written to the parent so far, excluding the index and the trailer.
+  [[nodiscard]]
+  std::uint64_t                            compressed_size() const noexcept
+  {
+    return end_ - base_;
+  }
+  [[nodiscard]]
+  native_rw_ops*                           parent         () const noexcept
+  {
+    return parent_;
+  }
+
+private:
+  static constexpr std::array<std::byte, 4> magic          {std::byte{'S'}, std::byte{'D'}, std::byte{'L'}, std::byte{'Z'}};
+  static constexpr std::uint32_t            version        = 1;
+  static constexpr std::size_t              header_size    = 12;
+  static constexpr std::size_t              trailer_size   = 28;
+  static constexpr std::uint32_t            stored_flag    = 0x80000000u;
+  static constexpr std::size_t              no_block       = static_cast<std::size_t>(-1);
+
+  template <std::integral type>
+  static void put(std::vector<std::byte>& buffer, const type value)
+  {
+    const auto swapped = byteswap_le(value);
+    const auto bytes   = reinterpret_cast<const std::byte*>(&swapped);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(type));
+  }
+  template <std::integral type> [[nodiscard]]
+  static type get(const std::byte* buffer)
+  {
+    type value;
+    std::memcpy(&value, buffer, sizeof(type));
+    return byteswap_le(value);
+  }
+
+  std::expected<void, std::string> read_exactly (void* buffer, const std::size_t size) const
+  {
+    if (size == 0)
+      return {};
+    if (SDL_RWread(parent_, buffer, 1, size) != size)
+      return std::unexpected(std::string("Truncated compressed stream."));
+    return {};
+  }
+  std::expected<void, std::string> write_exactly(const std::vector<std::byte>& buffer)
+  {
+    const auto written = SDL_RWwrite(parent_, buffer.data(), 1, buffer.size());
+    end_ += written; // Partially written blocks are not indexed, but the next ones follow them.
+    if (written != buffer.size())
+      return std::unexpected(get_error());
+    return {};
+  }
+
+  bool open_for_reading()
+  {
+    const auto fail = [ ] (const std::string& message)
+    {
+      set_error(message);
+      return false;
+    };
+
+    const auto base = rw_tell(parent_);
+    if (!base)
+      return fail(base.error());
+    base_ = static_cast<std::uint64_t>(base.value());
+
+    std::array<std::byte, header_size> header;
+    if (const auto result = read_exactly(header.data(), header.size()); !result)
+      return fail(result.error());
+    if (!std::equal(magic.begin(), magic.end(), header.begin()) || get<std::uint32_t>(header.data() + 4) != version)
+      return fail("Not a compressed stream.");
+    block_size_ = get<std::uint32_t>(header.data() + 8);
+    if (block_size_ == 0 || block_size_ > 0x7FFFFFFF)
+      return fail("Corrupt compressed stream header.");
+
+    std::array<std::byte, trailer_size> trailer;
+    const auto trailer_offset = rw_seek(parent_, -static_cast<std::int64_t>(trailer_size), seek_mode::end);
+    if (!trailer_offset)
+      return fail(trailer_offset.error());
+    if (static_cast<std::uint64_t>(trailer_offset.value()) < base_ + header_size)
+      return fail("Compressed stream is missing its index. Was it closed?");
+    if (const auto result = read_exactly(trailer.data(), trailer.size()); !result)
+      return fail(result.error());
+    if (!std::equal(magic.begin(), magic.end(), trailer.begin() + 24))
+      return fail("Compressed stream is missing its index. Was it closed?");
+
+    // The trailer is validated against the parent before anything is allocated for it: the index lies between the header
+    // and the trailer, and the block count matches both the index and the size (computed without overflow).
+    const auto index_offset = get<std::uint64_t>(trailer.data()     );
+    const auto block_count  = get<std::uint64_t>(trailer.data() + 8 );
+    const auto size         = get<std::uint64_t>(trailer.data() + 16);
+    const auto index_end    = static_cast<std::uint64_t>(trailer_offset.value());
+    if (index_offset < base_ + header_size || index_offset > index_end || (index_end - index_offset) % sizeof(std::uint64_t) != 0)
+      return fail("Corrupt compressed stream index.");
+    if (block_count != (index_end - index_offset) / sizeof(std::uint64_t) || block_count != size / block_size_ + (size % block_size_ != 0 ? 1 : 0) ||
+        size > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+      return fail("Corrupt compressed stream index.");
+    size_ = static_cast<std::size_t>(size);
+
+    std::vector<std::byte> index(static_cast<std::size_t>(block_count) * sizeof(std::uint64_t));
+    if (const auto result = rw_seek(parent_, static_cast<std::int64_t>(index_offset), seek_mode::set); !result)
+      return fail(result.error());
+    if (const auto result = read_exactly(index.data(), index.size()); !result)
+      return fail(result.error());
+
+    offsets_.resize(block_count);
+    for (std::size_t i = 0; i < block_count; ++i)
+    {
+      offsets_[i] = get<std::uint64_t>(index.data() + i * sizeof(std::uint64_t));
+      if (offsets_[i] < base_ + header_size || offsets_[i] > index_offset - 8)
+        return fail("Corrupt compressed stream index.");
+    }
+    end_ = index_offset;
+    return true;
+  }
+  bool open_for_writing()
+  {
+    const auto base = SDL_RWtell(parent_);
+    base_ = end_ = static_cast<std::uint64_t>(std::max<std::int64_t>(base, 0)); // Non-seekable parents start at zero.
+
+    std::vector<std::byte> header(magic.begin(), magic.end());
+    put(header, version);
+    put(header, static_cast<std::uint32_t>(block_size_));
+    if (const auto result = write_exactly(header); !result)
+    {
+      set_error(result.error());
+      return false;
+    }
+    block_.reserve(block_size_);
+    return true;
+  }
+
+  std::expected<void, std::string> load_block (const std::size_t index)
+  {
+    block_index_ = no_block;
+
+    std::array<std::byte, 8> header;
+    if (const auto result = rw_seek(parent_, static_cast<std::int64_t>(offsets_[index]), seek_mode::set); !result)
+      return std::unexpected(result.error());
+    if (const auto result = read_exactly(header.data(), header.size()); !result)
+      return std::unexpected(result.error());
+
+    // The header is validated before anything is allocated for it: the stored bytes fit between this block and the next
+    // (or the index), and compressed blocks are smaller than raw ones, since blocks are only compressed if they shrink.
+    const auto stored_size = get<std::uint32_t>(header.data());
+    const auto raw_size    = get<std::uint32_t>(header.data() + 4);
+    const auto expected    = std::min(block_size_, size_ - index * block_size_);
+    const auto block_end   = index + 1 < offsets_.size() ? offsets_[index + 1] : end_;
+    if (raw_size != expected || block_end < offsets_[index] + header.size() ||
+        (stored_size & ~stored_flag) > block_end - offsets_[index] - header.size() ||
+        (!(stored_size & stored_flag) && stored_size >= raw_size))
+      return std::unexpected(std::string("Corrupt compressed block header."));
+
+    block_.resize(raw_size);
+    if (stored_size & stored_flag)
+    {
+      if ((stored_size & ~stored_flag) != raw_size)
+        return std::unexpected(std::string("Corrupt compressed block header."));
+      if (const auto result = read_exactly(block_.data(), raw_size); !result)
+        return std::unexpected(result.error());
+    }
+    else
+    {
+      scratch_.resize(stored_size);
+      if (const auto result = read_exactly(scratch_.data(), stored_size); !result)
+        return std::unexpected(result.error());
+      const auto result = lz_decompress(scratch_, block_);
+      if (!result)
+        return std::unexpected(result.error());
+      if (result.value() != raw_size)
+        return std::unexpected(std::string("Corrupt compressed block."));
+    }
+    block_index_ = index;
+    return {};
+  }
+  std::expected<void, std::string> write_block()
+  {
+    if (block_.empty())
+      return {};
+
+    scratch_.clear();
+    put(scratch_, std::uint64_t {}); // Placeholder for the block header.
+    if (level_ > 0)
+      lz_compress(block_, scratch_, level_);
+
+    const auto compressed_size = scratch_.size() - 8;
+    if (level_ == 0 || compressed_size >= block_.size())
+    {
+      scratch_.resize(8);
+      scratch_.insert(scratch_.end(), block_.begin(), block_.end());
+      const auto stored = byteswap_le(static_cast<std::uint32_t>(block_.size()) | stored_flag);
+      std::memcpy(scratch_.data(), &stored, sizeof(stored));
+    }
+    else
+    {
+      const auto stored = byteswap_le(static_cast<std::uint32_t>(compressed_size));
+      std::memcpy(scratch_.data(), &stored, sizeof(stored));
+    }
+    const auto raw = byteswap_le(static_cast<std::uint32_t>(block_.size()));
+    std::memcpy(scratch_.data() + 4, &raw, sizeof(raw));
+
+    const auto offset = end_;
+    if (const auto result = write_exactly(scratch_); !result)
+      return std::unexpected(result.error()); // The block remains buffered, and is written again by the next attempt.
+    offsets_.push_back(offset);
+    block_.clear();
+    return {};
+  }
+  std::expected<void, std::string> finalize   ()
+  {
+    if (const auto result = write_block(); !result)
+      return std::unexpected(result.error());
+
+    std::vector<std::byte> index;
+    index.reserve(offsets_.size() * sizeof(std::uint64_t) + trailer_size);
+    for (const auto offset : offsets_)
+      put(index, offset);
+    put(index, static_cast<std::uint64_t>(end_));
+    put(index, static_cast<std::uint64_t>(offsets_.size()));
+    put(index, static_cast<std::uint64_t>(size_));
+    index.insert(index.end(), magic.begin(), magic.end());
+    return write_exactly(index);
+  }
+
+  native_rw_ops*             parent_      {};
+  compressed_rw_mode         mode_        ;
+  std::int32_t               level_       ;
+  std::size_t                block_size_  ;
+  bool                       auto_close_  {};
+  bool                       is_open_     {false};
+
+  std::uint64_t              base_        {}; // The offset of the header in the parent.
+  std::uint64_t              end_         {}; // The offset of the end of the blocks in the parent.
+  std::vector<std::uint64_t> offsets_     ; // The block index.
+  std::size_t                size_        {}; // The uncompressed size.
+  std::size_t                position_    {}; // The uncompressed position.
+
+  std::vector<std::byte>     block_       ; // The decompressed block (reading) or the pending data (writing).
+  std::size_t                block_index_ {no_block};
+  std::vector<std::byte>     scratch_     ;
+};
+
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<native_rw_ops*, std::string> rw_from_compressed(
+  native_rw_ops*           parent                                    ,
+  const compressed_rw_mode mode                                      ,
+  const std::int32_t       level      = default_compression_level    ,
+  const std::size_t        block_size = default_compressed_block_size,
+  const bool               auto_close = false                        )
+{
+  auto source = std::make_unique<compressed_rw_source>(parent, mode, level, block_size, auto_close);
+  if (!source->is_open())
+  {
+    auto error = get_error();
+    (void) source->close(); // Closes the parent if owned.
+    return std::unexpected(std::move(error));
+  }
+  return rw_from_source(std::move(source));
+}
+
+// A `sdl::rw_ops` which provides access to the state of its `sdl::compressed_rw_source`.
+class compressed_rw_ops : public rw_ops
+{
+public:
+  // The constructor cannot transmit error state. You should use `sdl::make_compressed_rw_ops(...)` to handle errors.
+  explicit compressed_rw_ops  (
+    native_rw_ops*           parent                                    ,
+    const compressed_rw_mode mode                                      ,
+    const std::int32_t       level      = default_compression_level    ,
+    const std::size_t        block_size = default_compressed_block_size,
+    const bool               auto_close = false                        )
+  : rw_ops (std::make_unique<compressed_rw_source>(parent, mode, level, block_size, auto_close))
+  , source_(native_ ? static_cast<compressed_rw_source*>(native_->hidden.unknown.data1) : nullptr)
+  {
+
+  }
+  compressed_rw_ops           (const compressed_rw_ops&  that) = delete;
+  compressed_rw_ops           (      compressed_rw_ops&& temp) noexcept
+  : rw_ops (std::move(temp))
+  , source_(std::exchange(temp.source_, nullptr))
+  {
+
+  }
+ ~compressed_rw_ops           ()                               = default;
+  compressed_rw_ops& operator=(const compressed_rw_ops&  that) = delete;
+  compressed_rw_ops& operator=(      compressed_rw_ops&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      rw_ops::operator=(std::move(temp));
+      std::swap(source_, temp.source_);
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  compressed_rw_source* source() const noexcept
+  {
+    return source_;
+  }
+
+private:
+  compressed_rw_source* source_ {};
+};
+
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<compressed_rw_ops, std::string> make_compressed_rw_ops(
+  native_rw_ops*           parent                                    ,
+  const compressed_rw_mode mode                                      ,
+  const std::int32_t       level      = default_compression_level    ,
+  const std::size_t        block_size = default_compressed_block_size,
+  const bool               auto_close = false                        )
+{
+  auto result = compressed_rw_ops(parent, mode, level, block_size, auto_close);
+  if (!result.native())
+    return std::unexpected(get_error());
+  if (!result.source()->is_open())
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sdl/rect.hpp>
+#include <sdl/render.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/video.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides an accumulator of damaged areas, so that frames only redraw and
+// present what changed (rather than the whole window).
+
+using dirty_draw_callback = std::function<std::expected<void, std::string>(const rectangle<std::int32_t>&)>;
+
+// Two rectangles are merged into their bounding rectangle when the area they cover is at least `merge_threshold` of the
+// area of the bounding rectangle. Hence a threshold of 1 only merges rectangles which are contained in or aligned with
+// each other, whereas a threshold of 0 merges everything into a single rectangle. Lower thresholds trade redrawn pixels
+// for fewer rectangles (i.e. fewer draw passes and update calls). Beyond `max_rectangles`, the pair which wastes the
+// least area is merged regardless of the threshold.
+class dirty_region
+{
+public:
+  explicit dirty_region  (const std::optional<native_rect>& bounds = std::nullopt, const double merge_threshold = 0.5, const std::size_t max_rectangles = 16)
+  : bounds_(bounds), merge_threshold_(merge_threshold), max_rectangles_(std::max<std::size_t>(max_rectangles, 1))
+  {
+
+  }
+  dirty_region           (const dirty_region&  that) = default;
+  dirty_region           (      dirty_region&& temp) = default;
+ ~dirty_region           ()                          = default;
+  dirty_region& operator=(const dirty_region&  that) = default;
+  dirty_region& operator=(      dirty_region&& temp) = default;
+
+  // Clips the rectangle to the bounds, and merges it with the accumulated ones.
+  void                                         add                (const native_rect& rectangle)
+  {
+    auto current = sdl::rectangle<std::int32_t>(rectangle);
+    if (bounds_)
+    {
+      const auto clipped = intersect_rect(current, bounds_.value());
+      if (!clipped)
+        return;
+      current = clipped.value();
+    }
+    if (current.empty())
+      return;
+
+    // Merging may enable further merges with the other rectangles, hence repeats until none remain.
+    for (auto merged = true; merged; )
+    {
+      merged = false;
+      for (auto iterator = rectangles_.begin(); iterator != rectangles_.end(); ++iterator)
+      {
+        if (contains(*iterator, current))
+          return;
+        if (contains(current, *iterator) || coverage(current, *iterator) >= merge_threshold_)
+        {
+          current = current.merged(*iterator);
+          rectangles_.erase(iterator);
+          merged  = true;
+          break;
+        }
+      }
+    }
+    rectangles_.push_back(current);
+
+    if (rectangles_.size() > max_rectangles_)
+      merge_closest();
+  }
+  void                                         add                (const std::span<const native_rect>& rectangles)
+  {
+    for (const auto& rectangle : rectangles)
+      add(rectangle);
+  }
+  // Marks the whole bounds as damaged, e.g. after a resize.
+  void                                         add_all            ()
+  {
+    if (bounds_)
+      rectangles_.assign(1, bounds_.value());
+  }
+  void                                         clear              ()
+  {
+    rectangles_.clear();
+  }
+
+  [[nodiscard]]
+  bool                                         empty              () const noexcept
+  {
+    return rectangles_.empty();
+  }
+  [[nodiscard]]
+  std::span<const rectangle<std::int32_t>>     rectangles         () const noexcept
+  {
+    return rectangles_;
+  }
+  // The sum of the areas of the rectangles, which may count overlaps of rectangles which were not merged twice.
+  [[nodiscard]]
+  std::size_t                                  area               () const noexcept
+  {
+    std::size_t result = 0;
+    for (const auto& rectangle : rectangles_)
+      result += area(rectangle);
+    return result;
+  }
+
+  [[nodiscard]]
+  const std::optional<native_rect>&            bounds             () const noexcept
+  {
+    return bounds_;
+  }
+  // Changing the bounds (e.g. after a resize) marks the new bounds as damaged.
+  void                                         set_bounds         (const std::optional<native_rect>& bounds)
+  {
+    bounds_ = bounds;
+    rectangles_.clear();
+    add_all();
+  }
+  [[nodiscard]]
+  double                                       merge_threshold    () const noexcept
+  {
+    return merge_threshold_;
+  }
+  void                                         set_merge_threshold(const double merge_threshold) noexcept
+  {
+    merge_threshold_ = merge_threshold;
+  }
+  [[nodiscard]]
+  std::size_t                                  max_rectangles     () const noexcept
+  {
+    return max_rectangles_;
+  }
+
+  // Calls the function for each rectangle, with the clip rectangle of the surface (or renderer) set to it. The previous
+  // clip rectangle is restored afterwards.
+  std::expected<void, std::string>             draw               (const surface&  surface , const dirty_draw_callback& function) const
+  {
+    const auto previous = surface.clip_rect();
+    for (const auto& rectangle : rectangles_)
+    {
+      surface.set_clip_rect(rectangle);
+      if (auto result = function(rectangle); !result)
+      {
+        surface.set_clip_rect(previous);
+        return result;
+      }
+    }
+    surface.set_clip_rect(previous);
+    return {};
+  }
+  std::expected<void, std::string>             draw               (const renderer& renderer, const dirty_draw_callback& function) const
+  {
+    const auto previous = renderer.clip_rect();
+    for (const auto& rectangle : rectangles_)
+    {
+      if (auto result = renderer.set_clip_rect(rectangle); !result)
+        return result;
+      if (auto result = function(rectangle); !result)
+      {
+        static_cast<void>(renderer.set_clip_rect(previous));
+        return result;
+      }
+    }
+    return renderer.set_clip_rect(previous);
+  }
+  // Copies the rectangles of the window surface to the screen. Does nothing if there is no damage.
+  std::expected<void, std::string>             update_window      (native_window* window) const
+  {
+    if (rectangles_.empty())
+      return {};
+
+    std::vector<native_rect> natives(rectangles_.begin(), rectangles_.end());
+    return update_window_surface_rects(window, natives);
+  }
+
+private:
+  [[nodiscard]]
+  static std::size_t                           area               (const native_rect& rectangle) noexcept
+  {
+    return static_cast<std::size_t>(rectangle.w) * static_cast<std::size_t>(rectangle.h);
+  }
+  [[nodiscard]]
+  static bool                                  contains           (const native_rect& outer, const native_rect& inner) noexcept
+  {
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+  }
+  // The ratio of the area covered by the rectangles to the area of their bounding rectangle.
+  [[nodiscard]]
+  static double                                coverage           (const rectangle<std::int32_t>& lhs, const rectangle<std::int32_t>& rhs)
+  {
+    const auto overlap = lhs.intersect(rhs);
+    const auto covered = area(lhs) + area(rhs) - (overlap ? area(overlap.value()) : 0);
+    return static_cast<double>(covered) / static_cast<double>(area(lhs.merged(rhs)));
+  }
+  void                                         merge_closest      ()
+  {
+    std::size_t best_i     = 0;
+    std::size_t best_j     = 1;
+    auto        best_waste = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < rectangles_.size(); ++i)
+      for (std::size_t j = i + 1; j < rectangles_.size(); ++j)
+      {
+        const auto bounding = rectangles_[i].merged(rectangles_[j]);
+        const auto waste    = static_cast<double>(area(bounding)) * (1.0 - coverage(rectangles_[i], rectangles_[j]));
+        if (waste < best_waste)
+        {
+          best_i     = i;
+          best_j     = j;
+          best_waste = waste;
+        }
+      }
+
+    const auto merged = rectangles_[best_i].merged(rectangles_[best_j]);
+    rectangles_.erase(rectangles_.begin() + static_cast<std::ptrdiff_t>(best_j));
+    rectangles_.erase(rectangles_.begin() + static_cast<std::ptrdiff_t>(best_i));
+    add(merged); // The merged rectangle may contain or merge with others.
+  }
+
+  std::optional<native_rect>           bounds_         ;
+  double                               merge_threshold_;
+  std::size_t                          max_rectangles_ ;
+  std::vector<rectangle<std::int32_t>> rectangles_     {};
+};
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sdl/error.hpp>
+#include <sdl/rwops.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a growable alternative to `sdl::rw_from_mem`.
+
+inline constexpr std::size_t default_memory_chunk_size = 64 * 1024;
+
+// A `sdl::rw_source` which grows by appending fixed-size chunks, hence the data written so far is never copied or moved.
+// Seeking past the end is allowed, and the gap is filled with zeros on the next write.
+class dynamic_memory_source
+{
+public:
+  explicit dynamic_memory_source  (const std::size_t chunk_size = default_memory_chunk_size)
+  : chunk_size_(std::max<std::size_t>(chunk_size, 1))
+  {
+
+  }
+  dynamic_memory_source           (const dynamic_memory_source&  that) = delete;
+  dynamic_memory_source           (      dynamic_memory_source&& temp) = default;
+ ~dynamic_memory_source           ()                                   = default;
+  dynamic_memory_source& operator=(const dynamic_memory_source&  that) = delete;
+  dynamic_memory_source& operator=(      dynamic_memory_source&& temp) = default;
+
+  [[nodiscard]]
+  std::expected<std::int64_t, std::string> size (                                                                ) const
+  {
+    return static_cast<std::int64_t>(size_);
+  }
+  std::expected<std::int64_t, std::string> seek (const std::int64_t offset, const seek_mode origin               )
+  {
+    const auto base   = origin == seek_mode::set ? 0 : origin == seek_mode::cur ? static_cast<std::int64_t>(position_) : static_cast<std::int64_t>(size_);
+    const auto target = base + offset;
+    if (target < 0)
+      return std::unexpected(std::string("Seek before the start of the stream."));
+    position_ = static_cast<std::size_t>(target);
+    return target;
+  }
+  std::expected<std::size_t , std::string> read (      void* buffer, const std::size_t size, const std::size_t count)
+  {
+    if (size == 0 || count == 0 || position_ >= size_)
+      return 0;
+
+    const auto objects = std::min(count, (size_ - position_) / size);
+    auto       target  = static_cast<std::byte*>(buffer);
+    for_each_range(position_, objects * size, [&] (std::byte* chunk, const std::size_t bytes)
+    {
+      std::memcpy(target, chunk, bytes);
+      target += bytes;
+    });
+    position_ += objects * size;
+    return objects;
+  }
+  std::expected<std::size_t , std::string> write(const void* buffer, const std::size_t size, const std::size_t count)
+  {
+    const auto bytes = size * count;
+    if (bytes == 0)
+      return 0;
+
+    const auto end = position_ + bytes;
+    while (chunks_.size() * chunk_size_ < end)
+      chunks_.push_back(std::make_unique_for_overwrite<std::byte[]>(chunk_size_));
+
+    if (position_ > size_)
+      for_each_range(size_, position_ - size_, [ ] (std::byte* chunk, const std::size_t bytes)
+      {
+        std::memset(chunk, 0, bytes);
+      });
+
+    auto source = static_cast<const std::byte*>(buffer);
+    for_each_range(position_, bytes, [&] (std::byte* chunk, const std::size_t bytes)
+    {
+      std::memcpy(chunk, source, bytes);
+      source += bytes;
+    });
+    position_ = end;
+    size_     = std::max(size_, end);
+    return count;
+  }
+
+  // The chunks in order, with the last one trimmed to the size. Suitable for `sdl::rw_write_v`. The spans are
+  // invalidated by `clear` and `shrink_to_fit`, but not by further writes.
+  [[nodiscard]]
+  std::vector<std::span<const std::byte>> chunks       () const
+  {
+    std::vector<std::span<const std::byte>> result;
+    result.reserve(chunks_.size());
+    for_each_range(0, size_, [&] (const std::byte* chunk, const std::size_t bytes)
+    {
+      result.emplace_back(chunk, bytes);
+    });
+    return result;
+  }
+  // Copies the data into a single buffer.
+  [[nodiscard]]
+  std::vector<std::byte>                  contiguous   () const
+  {
+    std::vector<std::byte> result(size_);
+    auto                   target = result.data();
+    for_each_range(0, size_, [&] (const std::byte* chunk, const std::size_t bytes)
+    {
+      std::memcpy(target, chunk, bytes);
+      target += bytes;
+    });
+    return result;
+  }
+
+  // Resets the size and the position while retaining the chunks for reuse.
+  void                                    clear        () noexcept
+  {
+    size_     = 0;
+    position_ = 0;
+  }
+  // Releases the chunks which are beyond the size.
+  void                                    shrink_to_fit()
+  {
+    chunks_.resize((size_ + chunk_size_ - 1) / chunk_size_);
+  }
+
+  [[nodiscard]]
+  std::size_t                             chunk_size   () const noexcept
+  {
+    return chunk_size_;
+  }
+  [[nodiscard]]
+  std::size_t                             capacity     () const noexcept
+  {
+    return chunks_.size() * chunk_size_;
+  }
+  [[nodiscard]]
+  std::size_t                             position     () const noexcept
+  {
+    return position_;
+  }
+
+private:
+  // Invokes the function with the contiguous pieces of the range [offset, offset + bytes), which must be allocated.
+  template <typename function_type>
+  void for_each_range(std::size_t offset, std::size_t bytes, function_type&& function) const
+  {
+    while (bytes > 0)
+    {
+      const auto index  = offset / chunk_size_;
+      const auto start  = offset % chunk_size_;
+      const auto length = std::min(bytes, chunk_size_ - start);
+      function(chunks_[index].get() + start, length);
+      offset += length;
+      bytes  -= length;
+    }
+  }
+
+  std::size_t                               chunk_size_ ;
+  std::vector<std::unique_ptr<std::byte[]>> chunks_     ;
+  std::size_t                               size_       {};
+  std::size_t                               position_   {};
+};
+
+// Bad practice: You should use `std::stringstream` instead.
+[[nodiscard]]
+inline std::expected<native_rw_ops*, std::string> rw_from_dynamic_memory(const std::size_t chunk_size = default_memory_chunk_size)
+{
+  return rw_from_source(std::make_unique<dynamic_memory_source>(chunk_size));
+}
+
+// A `sdl::rw_ops` which provides access to the data of its `sdl::dynamic_memory_source`.
+class dynamic_memory_rw_ops : public rw_ops
+{
+public:
+  // The constructor cannot transmit error state. You should use `sdl::make_dynamic_memory_rw_ops(...)` to handle errors.
+  explicit dynamic_memory_rw_ops  (const std::size_t chunk_size = default_memory_chunk_size)
+  : rw_ops (std::make_unique<dynamic_memory_source>(chunk_size))
+  , source_(native_ ? static_cast<dynamic_memory_source*>(native_->hidden.unknown.data1) : nullptr)
+  {
+
+  }
+  dynamic_memory_rw_ops           (const dynamic_memory_rw_ops&  that) = delete;
+  dynamic_memory_rw_ops           (      dynamic_memory_rw_ops&& temp) noexcept
+  : rw_ops (std::move(temp))
+  , source_(std::exchange(temp.source_, nullptr))
+  {
+
+  }
+ ~dynamic_memory_rw_ops           ()                                   = default;
+  dynamic_memory_rw_ops& operator=(const dynamic_memory_rw_ops&  that) = delete;
+  dynamic_memory_rw_ops& operator=(      dynamic_memory_rw_ops&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      rw_ops::operator=(std::move(temp));
+      std::swap(source_, temp.source_);
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  std::vector<std::span<const std::byte>> chunks    () const
+  {
+    return source_->chunks();
+  }
+  [[nodiscard]]
+  std::vector<std::byte>                  contiguous() const
+  {
+    return source_->contiguous();
+  }
+  void                                    clear     () const noexcept
+  {
+    source_->clear();
+  }
+
+  [[nodiscard]]
+  dynamic_memory_source*                  source    () const noexcept
+  {
+    return source_;
+  }
+
+private:
+  dynamic_memory_source* source_ {};
+};
+
+// Bad practice: You should use `std::stringstream` instead.
+[[nodiscard]]
+inline std::expected<dynamic_memory_rw_ops, std::string> make_dynamic_memory_rw_ops(const std::size_t chunk_size = default_memory_chunk_size)
+{
+  auto result = dynamic_memory_rw_ops(chunk_size);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
@@ -1,10 +1,21 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <span>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #include <SDL_endian.h>
 
+#include <sdl/cpu_info.hpp>
+
 namespace sdl
 {
 // Bad practice: You should use `std::endian` instead. The design of this enum is based on `std::endian`.
@@ -120,4 +131,143 @@ constexpr type byteswap_be(type value) noexcept
     static_assert(sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4 || sizeof(type) == 8, "Unsupported type size.");
   return {};
 }
+
+// Swaps the bytes of `count` elements of `width` (2, 4 or 8) bytes in place.
+using byteswap_kernel = void (*) (std::byte* data, std::size_t count, std::size_t width);
+
+// Note: The array conversions are not a part of SDL.
+inline void           byteswap_scalar       (std::byte* data, const std::size_t count, const std::size_t width) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i, data += width)
+  {
+    if      (width == 2)
+    {
+      std::uint16_t value;
+      std::memcpy(&value, data, 2);
+      value = SDL_Swap16(value);
+      std::memcpy(data, &value, 2);
+    }
+    else if (width == 4)
+    {
+      std::uint32_t value;
+      std::memcpy(&value, data, 4);
+      value = SDL_Swap32(value);
+      std::memcpy(data, &value, 4);
+    }
+    else if (width == 8)
+    {
+      std::uint64_t value;
+      std::memcpy(&value, data, 8);
+      value = SDL_Swap64(value);
+      std::memcpy(data, &value, 8);
+    }
+  }
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+// Requires SSSE3 for `_mm_shuffle_epi8`. SDL does not query SSSE3, hence the caller checks for SSE4.1 which implies it.
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("ssse3")]]
+#endif
+inline void           byteswap_ssse3        (std::byte* data, const std::size_t count, const std::size_t width) noexcept
+{
+  const auto mask = width == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+                    width == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+                                 _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+  const auto  size = count * width;
+  std::size_t i    = 0;
+  for (; i + 16 <= size; i += 16)
+  {
+    const auto pointer = reinterpret_cast<__m128i*>(data + i);
+    _mm_storeu_si128(pointer, _mm_shuffle_epi8(_mm_loadu_si128(pointer), mask));
+  }
+  byteswap_scalar(data + i, (size - i) / width, width);
+}
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("avx2")]]
+#endif
+inline void           byteswap_avx2         (std::byte* data, const std::size_t count, const std::size_t width) noexcept
+{
+  // The shuffle operates within each 128-bit lane, hence the mask is repeated.
+  const auto mask = width == 2 ? _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+                    width == 4 ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+                                 _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+
+  const auto  size = count * width;
+  std::size_t i    = 0;
+  for (; i + 64 <= size; i += 64)
+  {
+    const auto first  = reinterpret_cast<__m256i*>(data + i);
+    const auto second = reinterpret_cast<__m256i*>(data + i + 32);
+    const auto a      = _mm256_loadu_si256(first );
+    const auto b      = _mm256_loadu_si256(second);
+    _mm256_storeu_si256(first , _mm256_shuffle_epi8(a, mask));
+    _mm256_storeu_si256(second, _mm256_shuffle_epi8(b, mask));
+  }
+  for (; i + 32 <= size; i += 32)
+  {
+    const auto pointer = reinterpret_cast<__m256i*>(data + i);
+    _mm256_storeu_si256(pointer, _mm256_shuffle_epi8(_mm256_loadu_si256(pointer), mask));
+  }
+  byteswap_scalar(data + i, (size - i) / width, width);
+}
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+inline void           byteswap_neon         (std::byte* data, const std::size_t count, const std::size_t width) noexcept
+{
+  const auto  size = count * width;
+  std::size_t i    = 0;
+  for (; i + 16 <= size; i += 16)
+  {
+    const auto pointer = reinterpret_cast<std::uint8_t*>(data + i);
+    const auto value   = vld1q_u8(pointer);
+    vst1q_u8(pointer, width == 2 ? vrev16q_u8(value) : width == 4 ? vrev32q_u8(value) : vrev64q_u8(value));
+  }
+  byteswap_scalar(data + i, (size - i) / width, width);
+}
+#endif
+
+template <typename type>
+concept byteswappable = (std::integral<type> || std::floating_point<type>) && (sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4 || sizeof(type) == 8);
+
+// The kernel is selected once, based on the features of the CPU at runtime.
+[[nodiscard]]
+inline byteswap_kernel get_byteswap_kernel  ()
+{
+  static const byteswap_kernel kernel = [ ]
+  {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    if (has_avx2 ())
+      return &byteswap_avx2;
+    if (has_sse41())
+      return &byteswap_ssse3;
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    if (has_neon ())
+      return &byteswap_neon;
+#endif
+    return &byteswap_scalar;
+  }();
+  return kernel;
+}
+
+template <byteswappable type>
+void                  byteswap_array        (const std::span<type>& values) noexcept
+{
+  if constexpr (sizeof(type) > 1)
+    get_byteswap_kernel()(reinterpret_cast<std::byte*>(values.data()), values.size(), sizeof(type));
+}
+// Converts between little endian and the native byte order in place.
+template <byteswappable type>
+void                  byteswap_le_array     (const std::span<type>& values) noexcept
+{
+  if constexpr (byte_order == endian::big)
+    byteswap_array(values);
+}
+// Converts between big endian and the native byte order in place.
+template <byteswappable type>
+void                  byteswap_be_array     (const std::span<type>& values) noexcept
+{
+  if constexpr (byte_order == endian::little)
+    byteswap_array(values);
 }
+}
\ No newline at end of file
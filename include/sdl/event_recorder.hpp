@@ -0,0 +1,435 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SDL_events.h>
+
+#include <sdl/endian.hpp>
+#include <sdl/error.hpp>
+#include <sdl/events.hpp>
+#include <sdl/rwops.hpp>
+#include <sdl/timer.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides recording and deterministic replay of the event stream, e.g. for
+// benchmarking under identical input on headless machines using the dummy video driver.
+//
+// Recording layout: An 8 byte header (magic, 16-bit version, 16-bit event size), followed by a record per event: The
+// timestamp delta in milliseconds (zigzag varint), the type (varint), a bit mask of the 8-byte words of the event which
+// differ from the previous event of the same type, and for each differing word a bit mask of its differing bytes followed
+// by those bytes. The timestamp is excluded from the words. Records are self-delimiting, hence a recording which is cut
+// short (e.g. by a crash) remains readable up to its last complete record.
+
+inline constexpr std::size_t default_event_recording_buffer_size = 16 * 1024;
+
+// Events which carry pointers (drops, text editing with `SDL_TEXTEDITING_EXT`, window manager and user events) are not
+// recordable, since the pointers would be dangling on replay.
+[[nodiscard]]
+constexpr bool is_recordable_event(const SDL_Event& event) noexcept
+{
+  switch (event.type)
+  {
+  case SDL_SYSWMEVENT      :
+  case SDL_TEXTEDITING_EXT :
+    return false;
+  case SDL_DROPFILE        :
+  case SDL_DROPTEXT        :
+  case SDL_DROPBEGIN       :
+  case SDL_DROPCOMPLETE    :
+    return event.drop.file == nullptr;
+  default:
+    return event.type < SDL_USEREVENT;
+  }
+}
+
+// Encodes the events into the native rw_ops, which must outlive the recorder. The records are buffered and written in
+// batches, call `flush` to write them immediately.
+class event_recorder
+{
+public:
+  explicit event_recorder  (native_rw_ops* ops, const std::size_t buffer_size = default_event_recording_buffer_size)
+  : ops_        (ops)
+  , buffer_size_(buffer_size)
+  {
+    buffer_.assign (magic.begin(), magic.end());
+    buffer_.reserve(buffer_size_ + max_record_size);
+    put_fixed(buffer_, version);
+    put_fixed(buffer_, static_cast<std::uint16_t>(sizeof(SDL_Event)));
+  }
+  event_recorder           (const event_recorder&  that) = delete;
+  event_recorder           (      event_recorder&& temp) = delete;
+ ~event_recorder           ()
+  {
+    stop ();
+    flush();
+  }
+  event_recorder& operator=(const event_recorder&  that) = delete;
+  event_recorder& operator=(      event_recorder&& temp) = delete;
+
+  // Records every event which is added to the SDL queue from now on, through an event watch. Thread-safe.
+  void                             start  ()
+  {
+    if (!watching_)
+      add_event_watch(&event_recorder::watch, this);
+    watching_ = true;
+  }
+  void                             stop   ()
+  {
+    if (watching_)
+      del_event_watch(&event_recorder::watch, this);
+    watching_ = false;
+  }
+
+  // Thread-safe. Unrecordable events are skipped, see `sdl::is_recordable_event`.
+  std::expected<void, std::string> record (const SDL_Event& event)
+  {
+    std::scoped_lock lock(mutex_);
+    return record_unlocked(event);
+  }
+  std::expected<void, std::string> record (const std::span<const SDL_Event>& events)
+  {
+    std::scoped_lock lock(mutex_);
+    for (const auto& event : events)
+      if (auto result = record_unlocked(event); !result)
+        return result;
+    return {};
+  }
+  std::expected<void, std::string> flush  ()
+  {
+    std::scoped_lock lock(mutex_);
+    return flush_unlocked();
+  }
+
+  // Thread-safe. The number of events recorded so far, and the number of bytes they were encoded into.
+  [[nodiscard]]
+  std::size_t                      count  () const
+  {
+    std::scoped_lock lock(mutex_);
+    return count_;
+  }
+  [[nodiscard]]
+  std::size_t                      size   () const
+  {
+    std::scoped_lock lock(mutex_);
+    return size_;
+  }
+  // Thread-safe. The first error encountered while recording through the event watch, if any. Returned by value, since
+  // the event watch may set it concurrently.
+  [[nodiscard]]
+  std::optional<std::string>       error  () const
+  {
+    std::scoped_lock lock(mutex_);
+    return error_;
+  }
+
+  using words_type = std::array<std::uint64_t, (sizeof(SDL_Event) + 7) / 8>;
+
+  static constexpr std::array<std::byte, 4> magic           {std::byte {'S'}, std::byte {'D'}, std::byte {'L'}, std::byte {'E'}};
+  static constexpr std::uint16_t            version         = 1;
+  static constexpr std::size_t              word_count      = std::tuple_size_v<words_type>;
+  static constexpr std::size_t              max_record_size = 2 * 10 + 1 + word_count * 9;
+
+  static_assert(word_count <= 8, "The word mask must fit into a byte.");
+
+private:
+  static std::int32_t watch     (void* user_data, SDL_Event* event)
+  {
+    const auto       recorder = static_cast<event_recorder*>(user_data);
+    std::scoped_lock lock(recorder->mutex_);
+    if (const auto result = recorder->record_unlocked(*event); !result && !recorder->error_)
+      recorder->error_ = result.error();
+    return 1;
+  }
+  static void        put_varint(std::vector<std::byte>& buffer, std::uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      buffer.push_back(static_cast<std::byte>(value | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back(static_cast<std::byte>(value));
+  }
+  template <std::integral type>
+  static void        put_fixed (std::vector<std::byte>& buffer, const type value)
+  {
+    const auto swapped = byteswap_le(value);
+    const auto bytes   = reinterpret_cast<const std::byte*>(&swapped);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(swapped));
+  }
+
+  std::expected<void, std::string> record_unlocked(const SDL_Event& event)
+  {
+    if (!is_recordable_event(event))
+      return {};
+
+    const auto timestamp = event.common.timestamp;
+    const auto delta     = static_cast<std::int32_t>(count_ ? timestamp - timestamp_ : 0);
+    timestamp_ = timestamp;
+
+    put_varint(buffer_, (static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31));
+    put_varint(buffer_, event.type);
+
+    // The timestamp is cleared from the words, and the last word is padded with zeros.
+    words_type words {};
+    std::memcpy(words.data(), &event, sizeof(SDL_Event));
+    std::memset(reinterpret_cast<std::byte*>(words.data()) + offsetof(SDL_CommonEvent, timestamp), 0, sizeof(std::uint32_t));
+
+    auto&      previous = previous_[event.type]; // Zero initialized for the first event of the type.
+    const auto mask     = buffer_.size();
+    buffer_.push_back(std::byte {0});
+    for (std::size_t i = 0; i < word_count; ++i)
+    {
+      if (words[i] == previous[i])
+        continue;
+      buffer_[mask] |= static_cast<std::byte>(1u << i);
+
+      const auto current = reinterpret_cast<const std::byte*>(&words   [i]);
+      const auto last    = reinterpret_cast<const std::byte*>(&previous[i]);
+      const auto bytes   = buffer_.size();
+      buffer_.push_back(std::byte {0});
+      for (std::size_t j = 0; j < 8; ++j)
+      {
+        if (current[j] == last[j])
+          continue;
+        buffer_[bytes] |= static_cast<std::byte>(1u << j);
+        buffer_.push_back(current[j]);
+      }
+    }
+    previous = words;
+    ++count_;
+
+    if (buffer_.size() >= buffer_size_)
+      return flush_unlocked();
+    return {};
+  }
+  std::expected<void, std::string> flush_unlocked ()
+  {
+    if (buffer_.empty())
+      return {};
+
+    const auto result = rw_write(ops_, buffer_.data(), 1, buffer_.size());
+    if (!result)
+      return std::unexpected(result.error());
+    size_ += buffer_.size();
+    buffer_.clear();
+    return {};
+  }
+
+  native_rw_ops*                                ops_         ;
+  std::size_t                                   buffer_size_ ;
+  std::vector<std::byte>                        buffer_      ;
+  std::unordered_map<std::uint32_t, words_type> previous_    ;
+  std::uint32_t                                 timestamp_   {};
+  std::size_t                                   count_       {};
+  std::size_t                                   size_        {};
+  bool                                          watching_    {};
+  std::optional<std::string>                    error_       ;
+  mutable std::mutex                            mutex_       ;
+};
+
+// Decodes the events recorded by a `sdl::event_recorder` from the native rw_ops, which must outlive the player, and pushes
+// them into the SDL queue. The timestamps of the decoded events are relative to the first recorded event.
+class event_player
+{
+public:
+  // The speed scales the elapsed time in `update`, e.g. 2.0 replays twice as fast, and infinity replays all events at
+  // once. The constructor cannot transmit error state. You should use `sdl::make_event_player(...)` to handle errors.
+  explicit event_player  (native_rw_ops* ops, const double speed = 1.0)
+  : ops_  (ops)
+  , speed_(speed)
+  {
+    fill(header_size);
+    if (buffer_.size() < header_size || !std::equal(event_recorder::magic.begin(), event_recorder::magic.end(), buffer_.begin()))
+    {
+      error_ = "Not an event recording.";
+      return;
+    }
+
+    std::uint16_t version, event_size;
+    std::memcpy(&version   , buffer_.data() + 4, sizeof(version   ));
+    std::memcpy(&event_size, buffer_.data() + 6, sizeof(event_size));
+    if (byteswap_le(version) != event_recorder::version || byteswap_le(event_size) != sizeof(SDL_Event))
+      error_ = "Unsupported event recording version or event size.";
+    position_ = header_size;
+  }
+  event_player           (const event_player&  that) = delete;
+  event_player           (      event_player&& temp) = default;
+ ~event_player           ()                          = default;
+  event_player& operator=(const event_player&  that) = delete;
+  event_player& operator=(      event_player&& temp) = default;
+
+  // Decodes the next event without pushing it.
+  std::expected<std::optional<SDL_Event>, std::string> next      ()
+  {
+    if (!pending_)
+      if (auto result = decode(); !result)
+        return std::unexpected(result.error());
+    return std::exchange(pending_, std::nullopt);
+  }
+  // Pushes the events recorded up to the time since the first event, and returns the number of events pushed. Stepping
+  // the time by a fixed amount per frame replays deterministically regardless of the frame rate.
+  std::expected<std::size_t, std::string>              push_until(const std::chrono::milliseconds time)
+  {
+    std::size_t count = 0;
+    while (true)
+    {
+      if (!pending_)
+        if (auto result = decode(); !result)
+          return std::unexpected(result.error());
+      if (!pending_ || std::chrono::milliseconds(pending_->common.timestamp) > time)
+        break;
+
+      if (const auto result = push_event(*pending_); !result)
+        return std::unexpected(result.error()); // The event remains pending, hence it is pushed again on the next call.
+      pending_.reset();
+      ++count;
+    }
+    return count;
+  }
+  // Pushes the events which are due at the original timing scaled by the speed. The clock starts on the first call.
+  std::expected<std::size_t, std::string>              update    ()
+  {
+    if (std::isinf(speed_))
+      return push_until(std::chrono::milliseconds::max());
+
+    const auto now = get_ticks_64();
+    if (!start_)
+      start_ = now;
+    return push_until(std::chrono::milliseconds(static_cast<std::int64_t>(static_cast<double>((now - *start_).count()) * speed_)));
+  }
+
+  [[nodiscard]]
+  bool                                                 finished  () const noexcept
+  {
+    return !pending_ && end_ && position_ == buffer_.size();
+  }
+  [[nodiscard]]
+  const std::optional<std::string>&                    error     () const noexcept
+  {
+    return error_;
+  }
+
+private:
+  static constexpr std::size_t header_size = 8;
+
+  // Ensures that at least the given number of bytes are buffered past the position, unless the end is reached.
+  void fill(const std::size_t bytes)
+  {
+    if (end_ || buffer_.size() - position_ >= bytes)
+      return;
+
+    buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(position_));
+    position_ = 0;
+
+    const auto offset = buffer_.size();
+    buffer_.resize(offset + default_event_recording_buffer_size);
+    const auto read = SDL_RWread(ops_, buffer_.data() + offset, 1, default_event_recording_buffer_size);
+    buffer_.resize(offset + read);
+    end_ = read == 0;
+    if (!end_)
+      fill(bytes);
+  }
+  std::expected<void, std::string> decode()
+  {
+    if (error_)
+      return std::unexpected(*error_);
+
+    fill(event_recorder::max_record_size);
+    if (position_ == buffer_.size())
+      return {};
+
+    const auto corrupt = [&]
+    {
+      error_ = "Corrupt event recording.";
+      return std::unexpected(*error_);
+    };
+    const auto get_byte   = [&] (std::byte& value)
+    {
+      if (position_ == buffer_.size())
+        return false;
+      value = buffer_[position_++];
+      return true;
+    };
+    const auto get_varint = [&] (std::uint64_t& value)
+    {
+      value = 0;
+      for (std::uint32_t shift = 0; shift < 64; shift += 7)
+      {
+        std::byte byte;
+        if (!get_byte(byte))
+          return false;
+        value |= static_cast<std::uint64_t>(byte & std::byte {0x7F}) << shift;
+        if ((byte & std::byte {0x80}) == std::byte {0})
+          return true;
+      }
+      return false;
+    };
+
+    std::uint64_t delta, type;
+    std::byte     mask;
+    if (!get_varint(delta) || !get_varint(type) || type > SDL_LASTEVENT || !get_byte(mask))
+      return corrupt();
+
+    auto& words = previous_[static_cast<std::uint32_t>(type)];
+    for (std::size_t i = 0; i < event_recorder::word_count; ++i)
+    {
+      if ((mask & static_cast<std::byte>(1u << i)) == std::byte {0})
+        continue;
+
+      std::byte bytes_mask;
+      if (!get_byte(bytes_mask))
+        return corrupt();
+      const auto bytes = reinterpret_cast<std::byte*>(&words[i]);
+      for (std::size_t j = 0; j < 8; ++j)
+        if ((bytes_mask & static_cast<std::byte>(1u << j)) != std::byte {0} && !get_byte(bytes[j]))
+          return corrupt();
+    }
+
+    const auto signed_delta = static_cast<std::int64_t>(delta >> 1) ^ -static_cast<std::int64_t>(delta & 1);
+    time_ = std::max<std::int64_t>(time_ + signed_delta, 0);
+
+    SDL_Event event;
+    std::memcpy(&event, words.data(), sizeof(SDL_Event));
+    event.common.timestamp = static_cast<std::uint32_t>(time_);
+    pending_ = event;
+    return {};
+  }
+
+  native_rw_ops*                                                ops_      ;
+  double                                                        speed_    ;
+  std::vector<std::byte>                                        buffer_   ;
+  std::size_t                                                   position_ {};
+  bool                                                          end_      {};
+  std::unordered_map<std::uint32_t, event_recorder::words_type> previous_ ;
+  std::int64_t                                                  time_     {};
+  std::optional<SDL_Event>                                      pending_  ;
+  std::optional<std::chrono::milliseconds>                      start_    ;
+  std::optional<std::string>                                    error_    ;
+};
+
+[[nodiscard]]
+inline std::expected<event_player, std::string> make_event_player(native_rw_ops* ops, const double speed = 1.0)
+{
+  auto result = event_player(ops, speed);
+  if (result.error())
+    return std::unexpected(*result.error());
+  return result;
+}
+}
\ No newline at end of file
@@ -0,0 +1,815 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <SDL_events.h>
+
+#include <sdl/atomic.hpp>
+#include <sdl/error.hpp>
+
+namespace sdl
+{
+// Note: The event types and structures are not wrapped. Use them directly.
+
+enum class event_action
+{
+  add  = SDL_ADDEVENT ,
+  peek = SDL_PEEKEVENT,
+  get  = SDL_GETEVENT
+};
+
+using native_event_filter = std::int32_t (*) (void* user_data, SDL_Event* event);
+
+inline void                                                 pump_events     ()
+{
+  SDL_PumpEvents();
+}
+// Does not pump the events. Use `sdl::pump_events` beforehand to update the queue.
+inline std::expected<std::size_t  , std::string>            peep_events     (const std::span<SDL_Event>& events, const event_action action, const std::uint32_t min_type = SDL_FIRSTEVENT, const std::uint32_t max_type = SDL_LASTEVENT)
+{
+  const auto result = SDL_PeepEvents(events.data(), static_cast<std::int32_t>(events.size()), static_cast<SDL_eventaction>(action), min_type, max_type);
+  if (result < 0)
+    return std::unexpected(get_error());
+  return static_cast<std::size_t>(result);
+}
+[[nodiscard]]
+inline bool                                                 has_event       (const std::uint32_t type)
+{
+  return static_cast<bool>(SDL_HasEvent(type));
+}
+[[nodiscard]]
+inline bool                                                 has_events      (const std::uint32_t min_type, const std::uint32_t max_type)
+{
+  return static_cast<bool>(SDL_HasEvents(min_type, max_type));
+}
+inline void                                                 flush_event     (const std::uint32_t type)
+{
+  SDL_FlushEvent(type);
+}
+inline void                                                 flush_events    (const std::uint32_t min_type, const std::uint32_t max_type)
+{
+  SDL_FlushEvents(min_type, max_type);
+}
+// Bad practice: You should use `sdl::event_queue` instead, which retrieves the events in batches.
+[[nodiscard]]
+inline std::optional<SDL_Event>                             poll_event      ()
+{
+  SDL_Event event;
+  if (!SDL_PollEvent(&event))
+    return std::nullopt;
+  return event;
+}
+[[nodiscard]]
+inline std::expected<SDL_Event    , std::string>            wait_event      ()
+{
+  SDL_Event event;
+  if (!SDL_WaitEvent(&event))
+    return std::unexpected(get_error());
+  return event;
+}
+// Returns an empty optional on timeout.
+[[nodiscard]]
+inline std::optional<SDL_Event>                             wait_event      (const std::chrono::milliseconds timeout)
+{
+  SDL_Event event;
+  if (!SDL_WaitEventTimeout(&event, static_cast<std::int32_t>(timeout.count())))
+    return std::nullopt;
+  return event;
+}
+// Returns false if the event is filtered.
+inline std::expected<bool         , std::string>            push_event      (SDL_Event event)
+{
+  const auto result = SDL_PushEvent(&event);
+  if (result < 0)
+    return std::unexpected(get_error());
+  return result == 1;
+}
+inline void                                                 set_event_filter(const native_event_filter filter, void* user_data = nullptr)
+{
+  SDL_SetEventFilter(filter, user_data);
+}
+[[nodiscard]]
+inline std::optional<std::pair<native_event_filter, void*>> get_event_filter()
+{
+  native_event_filter filter    {};
+  void*               user_data {};
+  if (!SDL_GetEventFilter(&filter, &user_data))
+    return std::nullopt;
+  return std::pair {filter, user_data};
+}
+inline void                                                 add_event_watch (const native_event_filter filter, void* user_data = nullptr)
+{
+  SDL_AddEventWatch(filter, user_data);
+}
+inline void                                                 del_event_watch (const native_event_filter filter, void* user_data = nullptr)
+{
+  SDL_DelEventWatch(filter, user_data);
+}
+inline void                                                 filter_events   (const native_event_filter filter, void* user_data = nullptr)
+{
+  SDL_FilterEvents(filter, user_data);
+}
+// Returns the previous state.
+inline bool                                                 set_event_state (const std::uint32_t type, const bool enabled)
+{
+  return SDL_EventState(type, enabled ? SDL_ENABLE : SDL_DISABLE) == SDL_ENABLE;
+}
+[[nodiscard]]
+inline bool                                                 get_event_state (const std::uint32_t type)
+{
+  return SDL_EventState(type, SDL_QUERY) == SDL_ENABLE;
+}
+// Returns the first of the `count` consecutive user event types.
+[[nodiscard]]
+inline std::expected<std::uint32_t, std::string>            register_events (const std::int32_t count = 1)
+{
+  const auto result = SDL_RegisterEvents(count);
+  if (result == static_cast<std::uint32_t>(-1))
+    return std::unexpected(std::string("Not enough user-defined events left."));
+  return result;
+}
+
+// Conveniences.
+inline constexpr std::size_t default_event_queue_capacity = 256;
+
+// Options for collapsing high-frequency events. Events are only merged within a run of `SDL_MOUSEMOTION` and
+// `SDL_SENSORUPDATE` events, hence their order relative to any other event is preserved.
+struct event_coalescing
+{
+  bool        mouse_motion   = true; // Merges the motion events of each mouse (per window) into the last one, summing the relative motion.
+  std::size_t sensor_samples = 1   ; // Retains the last samples of each sensor. Zero disables sensor coalescing.
+};
+
+// Retrieves the pending events in batches through `SDL_PeepEvents` into a buffer which is allocated once. The events
+// remain valid until the next call to `poll`. Events beyond the capacity are left in the SDL queue for the next call.
+class event_queue
+{
+public:
+  explicit event_queue  (const std::size_t capacity = default_event_queue_capacity, const std::optional<event_coalescing>& coalescing = std::nullopt)
+  : events_    (std::max<std::size_t>(capacity, 1))
+  , coalescing_(coalescing)
+  {
+
+  }
+  event_queue           (const event_queue&  that) = delete;
+  event_queue           (      event_queue&& temp) = default;
+ ~event_queue           ()                         = default;
+  event_queue& operator=(const event_queue&  that) = delete;
+  event_queue& operator=(      event_queue&& temp) = default;
+
+  // Pumps the events if requested, and retrieves up to `capacity()` events of the given types with a single call.
+  std::expected<std::span<const SDL_Event>, std::string> poll     (const bool pump = true, const std::uint32_t min_type = SDL_FIRSTEVENT, const std::uint32_t max_type = SDL_LASTEVENT)
+  {
+    if (pump)
+      SDL_PumpEvents();
+
+    size_      = 0;
+    collapsed_ = 0;
+    const auto result = peep_events(events_, event_action::get, min_type, max_type);
+    if (!result)
+      return std::unexpected(result.error());
+    size_ = result.value();
+    if (coalescing_)
+      coalesce(*coalescing_);
+    return events();
+  }
+  // Collapses the retrieved events in place, and returns the number of events which were removed. Called by `poll` if
+  // the queue was constructed with coalescing options.
+  std::size_t                                            coalesce (const event_coalescing& options)
+  {
+    // Traverses backwards so that the last event of each device is the one retained.
+    std::size_t target = size_;
+    for (auto i = size_; i-- > 0;)
+    {
+      const auto& event = events_[i];
+      if      (event.type == SDL_MOUSEMOTION && options.mouse_motion)
+      {
+        const auto key      = static_cast<std::uint64_t>(event.motion.windowID) << 32 | event.motion.which;
+        const auto iterator = std::ranges::find(devices_, key, &std::pair<std::uint64_t, std::size_t>::first);
+        if (iterator != devices_.end())
+        {
+          auto& last = events_[iterator->second].motion;
+          last.xrel += event.motion.xrel;
+          last.yrel += event.motion.yrel;
+          continue;
+        }
+        devices_.emplace_back(key, --target);
+      }
+      else if (event.type == SDL_SENSORUPDATE && options.sensor_samples > 0)
+      {
+        auto iterator = std::ranges::find(sensors_, event.sensor.which, &std::pair<std::int32_t, std::size_t>::first);
+        if (iterator == sensors_.end())
+          iterator = sensors_.emplace(sensors_.end(), event.sensor.which, 0);
+        if (iterator->second++ >= options.sensor_samples)
+          continue;
+        --target;
+      }
+      else
+      {
+        if (event.type != SDL_MOUSEMOTION && event.type != SDL_SENSORUPDATE)
+        {
+          devices_.clear();
+          sensors_.clear();
+        }
+        --target;
+      }
+
+      if (target != i)
+        events_[target] = event;
+    }
+    devices_.clear();
+    sensors_.clear();
+
+    // Moves the retained events, which were compacted towards the end, to the front.
+    const auto collapsed = target;
+    std::copy(events_.begin() + static_cast<std::ptrdiff_t>(target), events_.begin() + static_cast<std::ptrdiff_t>(size_), events_.begin());
+    size_      -= collapsed;
+    collapsed_ += collapsed;
+    return collapsed;
+  }
+  void                                                   clear    () noexcept
+  {
+    size_      = 0;
+    collapsed_ = 0;
+  }
+
+  [[nodiscard]]
+  std::span<const SDL_Event>                             events   () const noexcept
+  {
+    return {events_.data(), size_};
+  }
+  // The events of the type, e.g. `for (const auto& event : queue.of_type(SDL_KEYDOWN))`.
+  [[nodiscard]]
+  auto                                                   of_type  (const std::uint32_t type) const
+  {
+    return events() | std::views::filter([type] (const SDL_Event& event) { return event.type == type; });
+  }
+  // The events whose types are within [min_type, max_type], e.g. `queue.of_types(SDL_KEYDOWN, SDL_KEYUP)`.
+  [[nodiscard]]
+  auto                                                   of_types (const std::uint32_t min_type, const std::uint32_t max_type) const
+  {
+    return events() | std::views::filter([min_type, max_type] (const SDL_Event& event) { return event.type >= min_type && event.type <= max_type; });
+  }
+  [[nodiscard]]
+  bool                                                   contains (const std::uint32_t type) const noexcept
+  {
+    return std::ranges::any_of(events(), [type] (const SDL_Event& event) { return event.type == type; });
+  }
+
+  [[nodiscard]]
+  auto                                                   begin    () const noexcept
+  {
+    return events().begin();
+  }
+  [[nodiscard]]
+  auto                                                   end      () const noexcept
+  {
+    return events().end();
+  }
+  [[nodiscard]]
+  std::size_t                                            size     () const noexcept
+  {
+    return size_;
+  }
+  [[nodiscard]]
+  bool                                                   empty    () const noexcept
+  {
+    return size_ == 0;
+  }
+  // True if the last poll filled the buffer, in which case more events may be pending.
+  [[nodiscard]]
+  bool                                                   full     () const noexcept
+  {
+    return size_ == events_.size();
+  }
+  [[nodiscard]]
+  std::size_t                                            capacity () const noexcept
+  {
+    return events_.size();
+  }
+  // The number of events collapsed by coalescing since the last poll.
+  [[nodiscard]]
+  std::size_t                                            collapsed() const noexcept
+  {
+    return collapsed_;
+  }
+
+private:
+  std::vector<SDL_Event>                             events_     ;
+  std::size_t                                        size_       {};
+  std::optional<event_coalescing>                    coalescing_ ;
+  std::size_t                                        collapsed_  {};
+  std::vector<std::pair<std::uint64_t, std::size_t>> devices_    ; // The mice within the current run, and their retained event.
+  std::vector<std::pair<std::int32_t , std::size_t>> sensors_    ; // The sensors within the current run, and their sample count.
+};
+
+// The member of the event corresponding to the type, or the event itself if there is none.
+template <std::uint32_t type>
+constexpr const auto&                                    get_event_data  (const SDL_Event& event) noexcept
+{
+  if      constexpr (type == SDL_QUIT)
+    return event.quit;
+  else if constexpr (type == SDL_DISPLAYEVENT)
+    return event.display;
+  else if constexpr (type == SDL_WINDOWEVENT)
+    return event.window;
+  else if constexpr (type == SDL_KEYDOWN || type == SDL_KEYUP)
+    return event.key;
+  else if constexpr (type == SDL_TEXTEDITING)
+    return event.edit;
+  else if constexpr (type == SDL_TEXTINPUT)
+    return event.text;
+  else if constexpr (type == SDL_MOUSEMOTION)
+    return event.motion;
+  else if constexpr (type == SDL_MOUSEBUTTONDOWN || type == SDL_MOUSEBUTTONUP)
+    return event.button;
+  else if constexpr (type == SDL_MOUSEWHEEL)
+    return event.wheel;
+  else if constexpr (type == SDL_JOYAXISMOTION)
+    return event.jaxis;
+  else if constexpr (type == SDL_JOYBUTTONDOWN || type == SDL_JOYBUTTONUP)
+    return event.jbutton;
+  else if constexpr (type == SDL_JOYDEVICEADDED || type == SDL_JOYDEVICEREMOVED)
+    return event.jdevice;
+  else if constexpr (type == SDL_CONTROLLERAXISMOTION)
+    return event.caxis;
+  else if constexpr (type == SDL_CONTROLLERBUTTONDOWN || type == SDL_CONTROLLERBUTTONUP)
+    return event.cbutton;
+  else if constexpr (type == SDL_CONTROLLERDEVICEADDED || type == SDL_CONTROLLERDEVICEREMOVED || type == SDL_CONTROLLERDEVICEREMAPPED)
+    return event.cdevice;
+  else if constexpr (type == SDL_AUDIODEVICEADDED || type == SDL_AUDIODEVICEREMOVED)
+    return event.adevice;
+  else if constexpr (type == SDL_FINGERDOWN || type == SDL_FINGERUP || type == SDL_FINGERMOTION)
+    return event.tfinger;
+  else if constexpr (type == SDL_DROPFILE || type == SDL_DROPTEXT || type == SDL_DROPBEGIN || type == SDL_DROPCOMPLETE)
+    return event.drop;
+  else if constexpr (type == SDL_SENSORUPDATE)
+    return event.sensor;
+  else if constexpr (type >= SDL_USEREVENT && type <= SDL_LASTEVENT)
+    return event.user;
+  else
+    return event;
+}
+
+// A handler for the event types, or for all unhandled event types if none are given. See `sdl::on`.
+template <typename function_type, std::uint32_t... types>
+struct event_handler
+{
+  function_type function;
+};
+
+// Creates a handler for `sdl::event_dispatcher`. The function is invoked with the member of the event corresponding to
+// the type (e.g. `const SDL_KeyboardEvent&` for `SDL_KEYDOWN`) if it accepts it, and with the `const SDL_Event&` otherwise.
+template <std::uint32_t... types, typename function_type>
+constexpr auto                                           on              (function_type&& function)
+{
+  return event_handler<std::decay_t<function_type>, types...> {std::forward<function_type>(function)};
+}
+
+// Dispatches events to the handlers through a jump table which is built at compile time. The type is resolved to a slot
+// in two byte-sized lookups (the high and the low byte of the type), followed by a single indirect call. There is no
+// type erasure, hence the handlers may be inlined into their slots.
+template <typename... handler_types>
+class event_dispatcher
+{
+public:
+  explicit event_dispatcher  (handler_types... handlers)
+  : handlers_(std::move(handlers)...)
+  {
+
+  }
+  event_dispatcher           (const event_dispatcher&  that) = default;
+  event_dispatcher           (      event_dispatcher&& temp) = default;
+ ~event_dispatcher           ()                              = default;
+  event_dispatcher& operator=(const event_dispatcher&  that) = default;
+  event_dispatcher& operator=(      event_dispatcher&& temp) = default;
+
+  void operator()(const SDL_Event& event)
+  {
+    const auto type = event.type;
+    const auto& table = get_table();
+    const auto  slot  = type > 0xFFFF ? std::uint8_t(0) : table.slots[table.rows[type >> 8]][type & 0xFF];
+    table.functions[slot](*this, event);
+  }
+  void operator()(const std::span<const SDL_Event>& events)
+  {
+    for (const auto& event : events)
+      operator()(event);
+  }
+
+  [[nodiscard]]
+  std::tuple<handler_types...>&       handlers()       noexcept
+  {
+    return handlers_;
+  }
+  [[nodiscard]]
+  const std::tuple<handler_types...>& handlers() const noexcept
+  {
+    return handlers_;
+  }
+
+private:
+  using slot_function = void (*) (event_dispatcher&, const SDL_Event&);
+
+  template <typename handler_type>
+  struct handler_traits;
+  template <typename function_type, std::uint32_t... types>
+  struct handler_traits<event_handler<function_type, types...>>
+  {
+    static constexpr std::array<std::uint32_t, sizeof...(types)> handled_types {types...};
+
+    template <std::size_t index>
+    static constexpr std::array<slot_function, sizeof...(types)> functions()
+    {
+      return {&invoke<index, types>...};
+    }
+  };
+
+  template <std::size_t index, std::uint32_t type>
+  static void invoke  (event_dispatcher& dispatcher, const SDL_Event& event)
+  {
+    auto& function = std::get<index>(dispatcher.handlers_).function;
+    if constexpr (std::is_invocable_v<decltype(function), const std::remove_cvref_t<decltype(get_event_data<type>(event))>&>)
+      function(get_event_data<type>(event));
+    else
+      function(event);
+  }
+  template <std::size_t index>
+  static void fallback(event_dispatcher& dispatcher, const SDL_Event& event)
+  {
+    std::get<index>(dispatcher.handlers_).function(event);
+  }
+  static void ignore  (event_dispatcher&, const SDL_Event&)
+  {
+
+  }
+
+  static constexpr std::size_t type_count = (handler_traits<handler_types>::handled_types.size() + ... + 0);
+
+  struct jump_table
+  {
+    std::array<std::uint8_t, 256>                             rows     {}; // The high byte of the type to a row of slots.
+    std::array<std::array<std::uint8_t, 256>, type_count + 1> slots    {}; // The low byte of the type to a slot, within each row. Row 0 is empty.
+    std::array<slot_function, type_count + 1>                 functions{};
+    bool                                                      valid    {true}; // False if a type exceeds 0xFFFF or is handled twice.
+  };
+
+  static constexpr jump_table make_table()
+  {
+    jump_table result;
+    result.functions[0] = &ignore;
+
+    std::size_t slot    = 1;
+    std::size_t row     = 1;
+    const auto  add     = [&] (const std::uint32_t type, const slot_function function)
+    {
+      if (type > 0xFFFF)
+      {
+        result.valid = false;
+        return;
+      }
+      auto& entry = result.rows[type >> 8];
+      if (entry == 0)
+        entry = static_cast<std::uint8_t>(row++);
+      if (result.slots[entry][type & 0xFF] != 0)
+      {
+        result.valid = false;
+        return;
+      }
+      result.slots[entry][type & 0xFF] = static_cast<std::uint8_t>(slot);
+      result.functions[slot++]         = function;
+    };
+
+    [&] <std::size_t... indices> (std::index_sequence<indices...>)
+    {
+      ([&]
+      {
+        using traits = handler_traits<std::tuple_element_t<indices, std::tuple<handler_types...>>>;
+        if constexpr (traits::handled_types.empty())
+          result.functions[0] = &fallback<indices>;
+        else
+        {
+          const auto functions = traits::template functions<indices>();
+          for (std::size_t i = 0; i < functions.size(); ++i)
+            add(traits::handled_types[i], functions[i]);
+        }
+      }(), ...);
+    }(std::index_sequence_for<handler_types...> {});
+
+    // Unused types and rows resolve to slot 0, which holds the fallback.
+    return result;
+  }
+
+  static const jump_table& get_table()
+  {
+    static_assert(type_count < 256, "At most 255 event types can be handled by a dispatcher.");
+    static constexpr jump_table table = make_table();
+    static_assert(table.valid, "Event types must be unique within a dispatcher, and at most 0xFFFF.");
+    return table;
+  }
+
+  std::tuple<handler_types...> handlers_;
+};
+
+template <typename... handler_types> [[nodiscard]]
+constexpr auto                                           make_event_dispatcher(handler_types&&... handlers)
+{
+  return event_dispatcher<std::decay_t<handler_types>...>(std::forward<handler_types>(handlers)...);
+}
+
+// A bounded multi-producer single-consumer channel which carries values from any thread to the thread handling the
+// events, without taking the lock of the SDL event queue for each value. The first value sent after the consumer has
+// started receiving pushes a single event of `event_type()` (whose `user.data1` is the channel), later values are
+// batched under it. The values are stored in a ring of cells which is allocated once, on construction.
+//
+// Typical usage: Call `receive` when `is_event(event)` is true for a polled event.
+template <typename type>
+class user_event_channel
+{
+public:
+  static_assert(std::is_nothrow_move_constructible_v<type>, "The payload must be nothrow move constructible.");
+
+  // The capacity is rounded up to a power of two. The constructor cannot transmit error state. You should use
+  // `sdl::make_user_event_channel<type>(...)` to handle errors.
+  explicit user_event_channel  (const std::size_t capacity = 1024, const std::uint32_t event_type = static_cast<std::uint32_t>(-1))
+  : capacity_  (std::bit_ceil(std::max<std::size_t>(capacity, 2)))
+  , cells_     (std::make_unique<cell[]>(capacity_))
+  , event_type_(event_type != static_cast<std::uint32_t>(-1) ? event_type : register_events().value_or(static_cast<std::uint32_t>(-1)))
+  {
+    for (std::size_t i = 0; i < capacity_; ++i)
+      cells_[i].sequence.store(static_cast<std::int32_t>(i));
+  }
+  user_event_channel           (const user_event_channel&  that) = delete;
+  user_event_channel           (      user_event_channel&& temp) = delete;
+ ~user_event_channel           ()
+  {
+    receive([ ] (type&&) { });
+  }
+  user_event_channel& operator=(const user_event_channel&  that) = delete;
+  user_event_channel& operator=(      user_event_channel&& temp) = delete;
+
+  // Thread-safe. Returns false if the channel is full. Returns an error if the value is stored but the wake-up event
+  // could not be pushed, in which case the wake-up remains pending and is retried by the next value sent.
+  template <typename... argument_types>
+  std::expected<bool, std::string> try_emplace(argument_types&&... arguments)
+  {
+    auto position = static_cast<std::uint32_t>(tail_.load());
+    cell* target;
+    while (true)
+    {
+      target = &cells_[position & (capacity_ - 1)];
+      const auto difference = static_cast<std::int32_t>(static_cast<std::uint32_t>(target->sequence.load()) - position);
+      if      (difference == 0)
+      {
+        if (tail_.compare_exchange(static_cast<std::int32_t>(position), static_cast<std::int32_t>(position + 1)))
+          break;
+        position = static_cast<std::uint32_t>(tail_.load());
+      }
+      else if (difference < 0)
+        return false;
+      else
+        position = static_cast<std::uint32_t>(tail_.load());
+    }
+
+    ::new (static_cast<void*>(target->storage)) type(std::forward<argument_types>(arguments)...);
+    // Publishes the payload. `SDL_AtomicAdd` is a full barrier whereas `SDL_AtomicSet` is only an acquire barrier.
+    target->sequence.fetch_add(1);
+
+    if (auto result = wake(); !result)
+      return std::unexpected(result.error());
+    return true;
+  }
+  // Thread-safe. Returns false if the channel is full. See `try_emplace` for the error case.
+  std::expected<bool, std::string> try_send   (type value)
+  {
+    return try_emplace(std::move(value));
+  }
+
+  // Must only be called from a single thread at a time. Invokes the function with each value in the order they were
+  // sent, and returns the number of values received.
+  template <std::invocable<type&&> function_type>
+  std::size_t                      receive    (function_type&& function)
+  {
+    pending_.store(wake_up_idle); // Values sent from now on push a new event.
+
+    std::size_t count = 0;
+    while (true)
+    {
+      auto& source = cells_[head_ & (capacity_ - 1)];
+      if (static_cast<std::uint32_t>(source.sequence.load()) != head_ + 1)
+        break;
+
+      auto& value = *std::launder(reinterpret_cast<type*>(source.storage));
+      function(std::move(value));
+      value.~type();
+      source.sequence.fetch_add(static_cast<std::int32_t>(capacity_) - 1);
+      ++head_;
+      ++count;
+    }
+    return count;
+  }
+  // Must only be called from a single thread at a time. Moves up to `values.size()` values into the span.
+  std::size_t                      receive    (const std::span<type>& values)
+  {
+    pending_.store(wake_up_idle);
+
+    std::size_t count = 0;
+    for (; count < values.size(); ++count)
+    {
+      auto& source = cells_[head_ & (capacity_ - 1)];
+      if (static_cast<std::uint32_t>(source.sequence.load()) != head_ + 1)
+        break;
+
+      auto& value = *std::launder(reinterpret_cast<type*>(source.storage));
+      values[count] = std::move(value);
+      value.~type();
+      source.sequence.fetch_add(static_cast<std::int32_t>(capacity_) - 1);
+      ++head_;
+    }
+    if (count == values.size() && has_pending())
+      static_cast<void>(wake()); // Values are left behind, hence an event must remain queued for them.
+    return count;
+  }
+
+  [[nodiscard]]
+  bool                             is_event   (const SDL_Event& event) const noexcept
+  {
+    return event.type == event_type_ && event.user.data1 == this;
+  }
+  [[nodiscard]]
+  std::uint32_t                    event_type () const noexcept
+  {
+    return event_type_;
+  }
+  [[nodiscard]]
+  std::size_t                      capacity   () const noexcept
+  {
+    return capacity_;
+  }
+
+private:
+  struct cell
+  {
+    atomic_int              sequence;
+    alignas(type) std::byte storage[sizeof(type)];
+  };
+
+  // The states of `pending_`.
+  static constexpr std::int32_t wake_up_idle   = 0; // No wake-up event is in the SDL queue.
+  static constexpr std::int32_t wake_up_queued = 1; // A wake-up event is in the SDL queue, or being pushed.
+  static constexpr std::int32_t wake_up_failed = 2; // Pushing the wake-up event failed, the next value retries.
+
+  std::expected<void, std::string> wake()
+  {
+    if (!pending_.compare_exchange(wake_up_idle, wake_up_queued) && !pending_.compare_exchange(wake_up_failed, wake_up_queued))
+      return {};
+
+    SDL_Event event {};
+    event.user.type  = event_type_;
+    event.user.data1 = this;
+    const auto result = SDL_PushEvent(&event);
+    if (result < 0)
+    {
+      auto error = get_error();
+      pending_.compare_exchange(wake_up_queued, wake_up_failed);
+      return std::unexpected(std::move(error));
+    }
+    if (result == 0)
+      pending_.compare_exchange(wake_up_queued, wake_up_idle); // Filtered, let the next value push another one.
+    return {};
+  }
+  [[nodiscard]]
+  bool has_pending()
+  {
+    return static_cast<std::uint32_t>(cells_[head_ & (capacity_ - 1)].sequence.load()) == head_ + 1;
+  }
+
+  std::size_t               capacity_   ;
+  std::unique_ptr<cell[]>   cells_      ;
+  std::uint32_t             event_type_ ;
+
+  alignas(64) atomic_int    tail_       ; // Shared by the producers.
+  alignas(64) atomic_int    pending_    ; // One of the `wake_up_` states.
+  alignas(64) std::uint32_t head_       {}; // Owned by the consumer.
+};
+
+template <typename type> [[nodiscard]]
+std::expected<std::unique_ptr<user_event_channel<type>>, std::string> make_user_event_channel(const std::size_t capacity = 1024)
+{
+  auto result = std::make_unique<user_event_channel<type>>(capacity);
+  if (result->event_type() == static_cast<std::uint32_t>(-1))
+    return std::unexpected(std::string("Not enough user-defined events left."));
+  return result;
+}
+
+// Adds the function as an event watch for the lifetime of the object. The function is invoked with each event added to
+// the queue, from the thread adding it, hence it must be thread-safe. Unlike `sdl::hint_callback`, the function is not
+// type-erased: The trampoline is instantiated per function type, so each event costs a single indirect call.
+template <std::invocable<const SDL_Event&> function_type>
+class event_watch
+{
+public:
+  explicit event_watch  (function_type function)
+  : function_(std::move(function))
+  {
+    add_event_watch(&event_watch::trampoline, this);
+  }
+  event_watch           (const event_watch&  that) = delete;
+  event_watch           (      event_watch&& temp) = delete;
+ ~event_watch           ()
+  {
+    del_event_watch(&event_watch::trampoline, this);
+  }
+  event_watch& operator=(const event_watch&  that) = delete;
+  event_watch& operator=(      event_watch&& temp) = delete;
+
+  [[nodiscard]]
+  function_type&       function()       noexcept
+  {
+    return function_;
+  }
+  [[nodiscard]]
+  const function_type& function() const noexcept
+  {
+    return function_;
+  }
+
+private:
+  static std::int32_t trampoline(void* user_data, SDL_Event* event)
+  {
+    static_cast<event_watch*>(user_data)->function_(std::as_const(*event));
+    return 1; // The return value of watches is ignored.
+  }
+
+  function_type function_;
+};
+
+// Sets the function as the event filter for the lifetime of the object, and restores the previous filter afterwards,
+// hence filters must be destroyed in the reverse order of their construction. The function may modify the event, and
+// returns false to drop it. See `sdl::event_watch` for the threading requirements and the dispatch cost.
+template <typename function_type> requires std::convertible_to<std::invoke_result_t<function_type&, SDL_Event&>, bool>
+class event_filter
+{
+public:
+  explicit event_filter  (function_type function)
+  : function_(std::move(function))
+  , previous_(get_event_filter())
+  {
+    set_event_filter(&event_filter::trampoline, this);
+  }
+  event_filter           (const event_filter&  that) = delete;
+  event_filter           (      event_filter&& temp) = delete;
+ ~event_filter           ()
+  {
+    if (previous_)
+      set_event_filter(previous_->first, previous_->second);
+    else
+      set_event_filter(nullptr);
+  }
+  event_filter& operator=(const event_filter&  that) = delete;
+  event_filter& operator=(      event_filter&& temp) = delete;
+
+  // Removes the events in the queue which do not pass the filter.
+  void                 apply   ()
+  {
+    filter_events(&event_filter::trampoline, this);
+  }
+
+  [[nodiscard]]
+  function_type&       function()       noexcept
+  {
+    return function_;
+  }
+  [[nodiscard]]
+  const function_type& function() const noexcept
+  {
+    return function_;
+  }
+
+private:
+  static std::int32_t trampoline(void* user_data, SDL_Event* event)
+  {
+    return static_cast<bool>(static_cast<event_filter*>(user_data)->function_(*event)) ? 1 : 0;
+  }
+
+  function_type                                        function_;
+  std::optional<std::pair<native_event_filter, void*>> previous_;
+};
+}
\ No newline at end of file
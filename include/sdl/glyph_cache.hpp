@@ -0,0 +1,380 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sdl/bitmap_font.hpp>
+#include <sdl/rect.hpp>
+#include <sdl/render.hpp>
+#include <sdl/sprite_batch.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/texture_atlas.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a cache of glyphs in a texture atlas, and a text layout which emits
+// the glyphs as sprites of `sdl::sprite_batch`, hence text is drawn with a draw call per atlas page.
+
+struct cached_glyph
+{
+  std::optional<texture_atlas::handle> handle ; // None for glyphs without pixels, e.g. spaces.
+  std::array<float, 2>                 offset ; // From the pen position (at the top of the line) to the top left of the glyph.
+  std::array<float, 2>                 size   ;
+  float                                advance;
+};
+
+struct glyph_cache_statistics
+{
+  std::size_t hits  ;
+  std::size_t misses;
+};
+
+// Glyphs are rasterized into the atlas on first use, keyed by font, size and codepoint. Sizes other than the size of the
+// font are scaled (linearly) from its pages. Codepoints missing in the font are drawn as U+FFFD or '?', if present.
+//
+// The cache never evicts: Each new combination of font, size and codepoint stays in the atlas, which adds a page whenever
+// it is full. Text in many sizes (e.g. animated zoom) grows it without bound, hence call `clear` when
+// `atlas().page_count()` exceeds a budget, once the sprites referencing the atlas have been drawn.
+class glyph_cache
+{
+public:
+  using font_handle = std::size_t;
+
+  explicit glyph_cache  (const std::array<std::int32_t, 2>& page_size = default_texture_atlas_page_size, const std::int32_t padding = 1)
+  : atlas_(page_size, SDL_PIXELFORMAT_ARGB8888, padding)
+  {
+
+  }
+  glyph_cache           (const glyph_cache&  that) = delete;
+  glyph_cache           (      glyph_cache&& temp) = default;
+  // The textures of the atlas must be destroyed before their renderer.
+ ~glyph_cache           ()                         = default;
+  glyph_cache& operator=(const glyph_cache&  that) = delete;
+  glyph_cache& operator=(      glyph_cache&& temp) = default;
+
+  // The font is referenced rather than copied, hence must outlive the cache.
+  font_handle                                          add_font    (const bitmap_font& font)
+  {
+    fonts_.push_back(font_entry {&font});
+    return fonts_.size() - 1;
+  }
+
+  // Returns the cached glyph, rasterizing it into the atlas on a miss. The glyph remains valid until `clear`.
+  [[nodiscard]]
+  std::expected<const cached_glyph*, std::string>      glyph       (const font_handle font, const std::int32_t size, const char32_t codepoint)
+  {
+    if (font >= fonts_.size() || font > std::numeric_limits<std::uint16_t>::max())
+      return std::unexpected("Invalid font.");
+    if (size <= 0 || size > std::numeric_limits<std::uint16_t>::max())
+      return std::unexpected("Invalid font size.");
+
+    const auto key = static_cast<std::uint64_t>(font) << 48 | static_cast<std::uint64_t>(size) << 32 | codepoint;
+    if (const auto iterator = glyphs_.find(key); iterator != glyphs_.end())
+    {
+      ++statistics_.hits;
+      return &iterator->second;
+    }
+    ++statistics_.misses;
+
+    auto& entry = fonts_[font];
+    const auto& source = *entry.font;
+    const auto* glyph  = source.glyph(codepoint);
+    if (!glyph)
+      glyph = source.glyph(U'\uFFFD');
+    if (!glyph)
+      glyph = source.glyph(U'?');
+    if (!glyph)
+      return &glyphs_.emplace(key, cached_glyph {std::nullopt, {0.0f, 0.0f}, {0.0f, 0.0f}, 0.0f}).first->second;
+
+    const auto   scale  = static_cast<float>(size) / static_cast<float>(source.size);
+    cached_glyph result {
+      std::nullopt,
+      {static_cast<float>(glyph->offset[0]) * scale, static_cast<float>(glyph->offset[1]) * scale},
+      {0.0f, 0.0f},
+      static_cast<float>(glyph->advance) * scale};
+
+    if (!glyph->area.empty())
+    {
+      std::expected<texture_atlas::handle, std::string> handle;
+      if (size == source.size)
+        handle = atlas_.insert(source.pages[glyph->page], glyph->area);
+      else
+      {
+        // The pages are converted to the format of the atlas once, since stretching requires matching formats.
+        if (entry.converted_pages.empty())
+          for (const auto& page : source.pages)
+          {
+            auto converted = page.convert(SDL_PIXELFORMAT_ARGB8888);
+            if (!converted)
+            {
+              entry.converted_pages.clear();
+              return std::unexpected(converted.error());
+            }
+            entry.converted_pages.push_back(std::move(converted.value()));
+          }
+
+        const std::array scaled_size {
+          std::max(static_cast<std::int32_t>(std::lround(static_cast<float>(glyph->area.w) * scale)), 1),
+          std::max(static_cast<std::int32_t>(std::lround(static_cast<float>(glyph->area.h) * scale)), 1)};
+        auto scaled = make_surface(scaled_size, SDL_PIXELFORMAT_ARGB8888);
+        if (!scaled)
+          return std::unexpected(scaled.error());
+        if (auto stretched = soft_stretch_linear(entry.converted_pages[glyph->page].native(), glyph->area, scaled->native()); !stretched)
+          return std::unexpected(stretched.error());
+        handle = atlas_.insert(scaled.value());
+      }
+      if (!handle)
+        return std::unexpected(handle.error());
+
+      const auto& area = atlas_.region(handle.value()).area;
+      result.handle = handle.value();
+      result.size   = {static_cast<float>(area.w), static_cast<float>(area.h)};
+    }
+    return &glyphs_.emplace(key, result).first->second;
+  }
+  [[nodiscard]]
+  float                                                kerning     (const font_handle font, const std::int32_t size, const char32_t first, const char32_t second) const
+  {
+    const auto& source = *fonts_[font].font;
+    return static_cast<float>(source.kerning(first, second)) * static_cast<float>(size) / static_cast<float>(source.size);
+  }
+  [[nodiscard]]
+  float                                                line_height (const font_handle font, const std::int32_t size) const
+  {
+    const auto& source = *fonts_[font].font;
+    return static_cast<float>(source.line_height) * static_cast<float>(size) / static_cast<float>(source.size);
+  }
+
+  // Uploads the glyphs rasterized since the previous upload. Call before drawing the glyphs.
+  std::expected<void, std::string>                     upload      (const renderer& renderer)
+  {
+    return atlas_.upload(renderer);
+  }
+  // Removes all glyphs and the pages of the atlas, which is the only way to release them. The fonts are retained. The
+  // textures of the pages are destroyed, hence sprites laid out before must not be drawn afterwards.
+  void                                                 clear       ()
+  {
+    glyphs_.clear();
+    atlas_ .reset();
+  }
+
+  [[nodiscard]]
+  const texture_atlas&                                 atlas       () const noexcept
+  {
+    return atlas_;
+  }
+  // The number of cached glyphs.
+  [[nodiscard]]
+  std::size_t                                          size        () const noexcept
+  {
+    return glyphs_.size();
+  }
+  [[nodiscard]]
+  const glyph_cache_statistics&                        statistics  () const noexcept
+  {
+    return statistics_;
+  }
+
+private:
+  struct font_entry
+  {
+    const bitmap_font*   font           ;
+    std::vector<surface> converted_pages{};
+  };
+
+  texture_atlas                                   atlas_      ;
+  std::vector<font_entry>                         fonts_      {};
+  std::unordered_map<std::uint64_t, cached_glyph> glyphs_     {}; // Keyed by the font, the size and the codepoint.
+  glyph_cache_statistics                          statistics_ {};
+};
+
+enum class text_alignment
+{
+  left  ,
+  center,
+  right
+};
+
+struct text_style
+{
+  glyph_cache::font_handle    font        {};
+  std::int32_t                size        {16};
+  std::array<std::uint8_t, 4> color       {255, 255, 255, 255};
+  float                       max_width   {};     // Lines are wrapped at spaces beyond the width, unless zero.
+  float                       line_spacing{1.0f}; // Relative to the line height of the font.
+  text_alignment              alignment   {text_alignment::left};
+  std::int32_t                layer       {};
+};
+
+struct text_layout
+{
+  native_frect bounds; // Of the lines, from the top of the first to the bottom of the last.
+  std::size_t  lines ;
+  std::size_t  glyphs; // The number of emitted sprites.
+};
+
+// Invalid sequences are decoded as U+FFFD.
+[[nodiscard]]
+inline std::u32string decode_utf8(const std::string_view& text)
+{
+  std::u32string result;
+  result.reserve(text.size());
+  for (std::size_t i = 0; i < text.size();)
+  {
+    const auto lead   = static_cast<std::uint8_t>(text[i]);
+    const auto length = lead < 0x80 ? 1 : (lead >> 5) == 0x06 ? 2 : (lead >> 4) == 0x0E ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (length == 0 || i + length > text.size())
+    {
+      result.push_back(U'\uFFFD');
+      ++i;
+      continue;
+    }
+
+    auto codepoint = static_cast<char32_t>(length == 1 ? lead : lead & (0x7F >> length));
+    auto valid     = true;
+    for (std::size_t j = 1; j < static_cast<std::size_t>(length); ++j)
+    {
+      const auto continuation = static_cast<std::uint8_t>(text[i + j]);
+      valid     = valid && (continuation & 0xC0) == 0x80;
+      codepoint = codepoint << 6 | (continuation & 0x3F);
+    }
+    // Rejects overlong encodings, surrogates and codepoints beyond U+10FFFF.
+    constexpr std::array<char32_t, 5> minimum {0, 0, 0x80, 0x800, 0x10000};
+    if (!valid || codepoint < minimum[length] || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+    {
+      result.push_back(U'\uFFFD');
+      ++i;
+      continue;
+    }
+    result.push_back(codepoint);
+    i += static_cast<std::size_t>(length);
+  }
+  return result;
+}
+
+// Lays out the UTF-8 text from the position (the top left of the first line), and appends a sprite per visible glyph.
+// Missing glyphs are rasterized and uploaded, hence the sprites reference the textures of the atlas pages.
+[[nodiscard]]
+inline std::expected<text_layout, std::string> layout_text(glyph_cache& cache, const renderer& renderer, const std::string_view& text, const native_fpoint& position, const text_style& style, std::vector<sprite>& sprites)
+{
+  const auto codepoints = decode_utf8(text);
+
+  // Caches the glyphs and breaks the lines, before any sprite is emitted.
+  struct line
+  {
+    std::size_t begin;
+    std::size_t end  ;
+    float       width;
+  };
+  std::vector<const cached_glyph*> glyphs(codepoints.size());
+  std::vector<line>                lines;
+
+  const auto advance = [&] (const std::size_t begin, const std::size_t index)
+  {
+    return glyphs[index]->advance + (index > begin ? cache.kerning(style.font, style.size, codepoints[index - 1], codepoints[index]) : 0.0f);
+  };
+
+  constexpr auto no_space  = std::numeric_limits<std::size_t>::max();
+  std::size_t    begin     = 0;
+  float          pen       = 0.0f;
+  std::size_t    space     = no_space; // The last space of the line, at which it may be broken.
+  float          space_pen = 0.0f;
+  for (std::size_t i = 0; i < codepoints.size(); ++i)
+  {
+    if (codepoints[i] == U'\n')
+    {
+      lines.push_back(line {begin, i, pen});
+      begin = i + 1;
+      pen   = 0.0f;
+      space = no_space;
+      continue;
+    }
+
+    const auto glyph = cache.glyph(style.font, style.size, codepoints[i]);
+    if (!glyph)
+      return std::unexpected(glyph.error());
+    glyphs[i] = glyph.value();
+
+    // Breaks at the last space (which is dropped) when the glyph exceeds the width.
+    if (style.max_width > 0.0f && codepoints[i] != U' ' && space != no_space && pen + advance(begin, i) - glyphs[i]->advance + glyphs[i]->offset[0] + glyphs[i]->size[0] > style.max_width)
+    {
+      lines.push_back(line {begin, space, space_pen});
+      begin = space + 1;
+      pen   = 0.0f;
+      for (std::size_t j = begin; j < i; ++j)
+        pen += advance(begin, j);
+      space = no_space;
+    }
+    if (codepoints[i] == U' ')
+    {
+      space     = i;
+      space_pen = pen;
+    }
+    pen += advance(begin, i);
+  }
+  lines.push_back(line {begin, codepoints.size(), pen});
+
+  if (auto result = cache.upload(renderer); !result)
+    return std::unexpected(result.error());
+
+  float width = style.max_width;
+  for (const auto& current : lines)
+    width = std::max(width, current.width);
+
+  const auto  line_height = cache.line_height(style.font, style.size) * style.line_spacing;
+  const auto  alignment   = style.alignment == text_alignment::left ? 0.0f : style.alignment == text_alignment::center ? 0.5f : 1.0f;
+  std::size_t emitted     = 0;
+  auto        left        = std::numeric_limits<float>::max();
+  auto        right       = std::numeric_limits<float>::lowest();
+  for (std::size_t line_index = 0; line_index < lines.size(); ++line_index)
+  {
+    const auto& current = lines[line_index];
+    const auto  y       = position.y + static_cast<float>(line_index) * line_height;
+    auto        x       = position.x + (width - current.width) * alignment;
+    left  = std::min(left , x);
+    right = std::max(right, x + current.width);
+
+    for (std::size_t i = current.begin; i < current.end; ++i)
+    {
+      const auto& glyph = *glyphs[i];
+      if (glyph.handle)
+      {
+        const auto& region = cache.atlas().region(glyph.handle.value());
+        sprite result;
+        result.texture     = cache.atlas().page_texture(region.page);
+        result.destination = native_frect {x + (i > current.begin ? cache.kerning(style.font, style.size, codepoints[i - 1], codepoints[i]) : 0.0f) + glyph.offset[0], y + glyph.offset[1], glyph.size[0], glyph.size[1]};
+        result.source      = region.area;
+        result.color       = style.color;
+        result.layer       = style.layer;
+        sprites.push_back(result);
+        ++emitted;
+      }
+      x += advance(current.begin, i);
+    }
+  }
+
+  return text_layout {native_frect {left, position.y, right - left, static_cast<float>(lines.size()) * line_height}, lines.size(), emitted};
+}
+
+// Conveniences.
+
+[[nodiscard]]
+inline std::expected<text_layout, std::string> layout_text(glyph_cache& cache, const renderer& renderer, const std::string_view& text, const native_fpoint& position, const text_style& style, sprite_batch& batch)
+{
+  std::vector<sprite> sprites;
+  auto result = layout_text(cache, renderer, text, position, style, sprites);
+  if (result)
+    batch.draw(sprites);
+  return result;
+}
+}
\ No newline at end of file
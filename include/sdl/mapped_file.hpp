@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <sdl/error.hpp>
+#include <sdl/rwops.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a read-only memory mapped alternative to `sdl::rw_from_file`.
+
+enum class mapped_file_access
+{
+  normal    ,
+  sequential,
+  random
+};
+
+// Maps the whole file into memory as read-only. The mapping remains valid for the lifetime of the object.
+class mapped_file
+{
+public:
+  // The constructor cannot transmit error state. You should use `sdl::make_mapped_file(...)` to handle errors.
+  explicit mapped_file  (const std::string& filepath, const mapped_file_access access = mapped_file_access::normal)
+  {
+#if defined(_WIN32)
+    const auto wide_size = MultiByteToWideChar(CP_UTF8, 0, filepath.c_str(), -1, nullptr, 0);
+    std::wstring wide_filepath(static_cast<std::size_t>(std::max(wide_size, 1)), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, filepath.c_str(), -1, wide_filepath.data(), wide_size);
+
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if      (access == mapped_file_access::sequential)
+      flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    else if (access == mapped_file_access::random)
+      flags |= FILE_FLAG_RANDOM_ACCESS;
+
+    const auto file = CreateFileW(wide_filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      set_error("Couldn't open " + filepath + " (error code " + std::to_string(GetLastError()) + ").");
+      return;
+    }
+
+    LARGE_INTEGER file_size {};
+    if (!GetFileSizeEx(file, &file_size))
+    {
+      set_error("Couldn't query the size of " + filepath + " (error code " + std::to_string(GetLastError()) + ").");
+      CloseHandle(file);
+      return;
+    }
+
+    if (file_size.QuadPart > 0)
+    {
+      const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (!mapping)
+      {
+        set_error("Couldn't map " + filepath + " (error code " + std::to_string(GetLastError()) + ").");
+        CloseHandle(file);
+        return;
+      }
+      data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping); // The view keeps the mapping alive.
+      if (!data_)
+      {
+        set_error("Couldn't map " + filepath + " (error code " + std::to_string(GetLastError()) + ").");
+        CloseHandle(file);
+        return;
+      }
+    }
+    CloseHandle(file);
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+    const auto descriptor = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+    {
+      set_error("Couldn't open " + filepath + ": " + std::strerror(errno));
+      return;
+    }
+
+    struct stat status {};
+    if (::fstat(descriptor, &status) < 0)
+    {
+      set_error("Couldn't query the size of " + filepath + ": " + std::strerror(errno));
+      ::close(descriptor);
+      return;
+    }
+
+    if (status.st_size > 0)
+    {
+      const auto data = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (data == MAP_FAILED)
+      {
+        set_error("Couldn't map " + filepath + ": " + std::strerror(errno));
+        ::close(descriptor);
+        return;
+      }
+      data_ = data;
+
+      if      (access == mapped_file_access::sequential)
+        ::madvise(data_, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+      else if (access == mapped_file_access::random)
+        ::madvise(data_, static_cast<std::size_t>(status.st_size), MADV_RANDOM);
+    }
+    ::close(descriptor); // The mapping keeps the file alive.
+    size_ = static_cast<std::size_t>(status.st_size);
+#endif
+    is_open_ = true;
+  }
+  mapped_file           (const mapped_file&  that) = delete;
+  mapped_file           (      mapped_file&& temp) noexcept
+  : data_   (std::exchange(temp.data_   , nullptr))
+  , size_   (std::exchange(temp.size_   , 0      ))
+  , is_open_(std::exchange(temp.is_open_, false  ))
+  {
+
+  }
+ ~mapped_file           ()
+  {
+    unmap();
+  }
+  mapped_file& operator=(const mapped_file&  that) = delete;
+  mapped_file& operator=(      mapped_file&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      unmap();
+
+      data_    = std::exchange(temp.data_   , nullptr);
+      size_    = std::exchange(temp.size_   , 0      );
+      is_open_ = std::exchange(temp.is_open_, false  );
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  std::span<const std::byte> data   () const noexcept
+  {
+    return {static_cast<const std::byte*>(data_), size_};
+  }
+  [[nodiscard]]
+  std::size_t                size   () const noexcept
+  {
+    return size_;
+  }
+  [[nodiscard]]
+  bool                       is_open() const noexcept
+  {
+    return is_open_;
+  }
+
+private:
+  void unmap()
+  {
+    if (data_)
+    {
+#if defined(_WIN32)
+      UnmapViewOfFile(data_);
+#else
+      ::munmap(data_, size_);
+#endif
+    }
+    data_    = nullptr;
+    size_    = 0;
+    is_open_ = false;
+  }
+
+  void*       data_    {};
+  std::size_t size_    {};
+  bool        is_open_ {false};
+};
+
+// A read-only `sdl::rw_source` over a mapped file, or a window of it. Unlike `sdl::rw_from_const_mem`, it is not limited
+// to 2 GiB.
+class mapped_file_source
+{
+public:
+  explicit mapped_file_source  (std::shared_ptr<const mapped_file> file)
+  : file_(std::move(file))
+  , data_(file_->data())
+  {
+
+  }
+  // The window is clamped to the file.
+  explicit mapped_file_source  (std::shared_ptr<const mapped_file> file, const std::size_t offset, const std::size_t size)
+  : file_(std::move(file))
+  , data_(file_->data().subspan(std::min(offset, file_->size()), std::min(size, file_->size() - std::min(offset, file_->size()))))
+  {
+
+  }
+  mapped_file_source           (const mapped_file_source&  that) = delete;
+  mapped_file_source           (      mapped_file_source&& temp) = default;
+ ~mapped_file_source           ()                                = default;
+  mapped_file_source& operator=(const mapped_file_source&  that) = delete;
+  mapped_file_source& operator=(      mapped_file_source&& temp) = default;
+
+  [[nodiscard]]
+  std::expected<std::int64_t, std::string> size (                                                                ) const
+  {
+    return static_cast<std::int64_t>(data_.size());
+  }
+  std::expected<std::int64_t, std::string> seek (const std::int64_t offset, const seek_mode origin               )
+  {
+    const auto size = static_cast<std::int64_t>(data_.size());
+    const auto base = origin == seek_mode::set ? 0 : origin == seek_mode::cur ? position_ : size;
+    position_ = std::clamp<std::int64_t>(base + offset, 0, size);
+    return position_;
+  }
+  std::expected<std::size_t , std::string> read (      void* buffer, const std::size_t size, const std::size_t count)
+  {
+    if (size == 0 || count == 0)
+      return 0;
+
+    const auto available = static_cast<std::size_t>(static_cast<std::int64_t>(data_.size()) - position_);
+    const auto objects   = std::min(count, available / size);
+    if (objects == 0)
+      return 0;
+
+    std::memcpy(buffer, data_.data() + position_, objects * size);
+    position_ += static_cast<std::int64_t>(objects * size);
+    return objects;
+  }
+  std::expected<std::size_t , std::string> write(const void*, const std::size_t, const std::size_t)
+  {
+    return std::unexpected(std::string("Mapped files are read-only."));
+  }
+  // Copies directly from the mapping, hence slices of the mapped file may be read concurrently.
+  std::expected<std::size_t , std::string> read_at (const std::int64_t offset,       void* buffer, const std::size_t size) const
+  {
+    if (offset < 0)
+      return std::unexpected(std::string("Negative offset."));
+    if (offset >= static_cast<std::int64_t>(data_.size()))
+      return 0;
+    const auto count = std::min(size, data_.size() - static_cast<std::size_t>(offset));
+    std::memcpy(buffer, data_.data() + offset, count);
+    return count;
+  }
+
+  [[nodiscard]]
+  std::span<const std::byte>                data    () const noexcept
+  {
+    return data_;
+  }
+  [[nodiscard]]
+  const std::shared_ptr<const mapped_file>& file    () const noexcept
+  {
+    return file_;
+  }
+  [[nodiscard]]
+  std::int64_t                              position() const noexcept
+  {
+    return position_;
+  }
+
+private:
+  std::shared_ptr<const mapped_file> file_     ;
+  std::span<const std::byte>         data_     ;
+  std::int64_t                       position_ {};
+};
+
+[[nodiscard]]
+inline std::expected<mapped_file   , std::string> make_mapped_file   (const std::string& filepath, const mapped_file_access access = mapped_file_access::normal)
+{
+  mapped_file result(filepath, access);
+  if (!result.is_open())
+    return std::unexpected(get_error());
+  return result;
+}
+
+// The native rw_ops shares the ownership of the mapping, hence the file may be destroyed before the native rw_ops is closed.
+[[nodiscard]]
+inline std::expected<native_rw_ops*, std::string> rw_from_mapped_file(std::shared_ptr<const mapped_file> file)
+{
+  return rw_from_source(std::make_unique<mapped_file_source>(std::move(file)));
+}
+[[nodiscard]]
+inline std::expected<native_rw_ops*, std::string> rw_from_mapped_file(const std::string& filepath, const mapped_file_access access = mapped_file_access::sequential)
+{
+  auto file = make_mapped_file(filepath, access);
+  if (!file)
+    return std::unexpected(file.error());
+  return rw_from_mapped_file(std::make_shared<const mapped_file>(std::move(file.value())));
+}
+
+[[nodiscard]]
+inline std::expected<rw_ops        , std::string> make_mapped_rw_ops (std::shared_ptr<const mapped_file> file)
+{
+  return make_rw_ops(std::make_unique<mapped_file_source>(std::move(file)));
+}
+[[nodiscard]]
+inline std::expected<rw_ops        , std::string> make_mapped_rw_ops (const std::string& filepath, const mapped_file_access access = mapped_file_access::sequential)
+{
+  auto file = make_mapped_file(filepath, access);
+  if (!file)
+    return std::unexpected(file.error());
+  return make_mapped_rw_ops(std::make_shared<const mapped_file>(std::move(file.value())));
+}
+}
\ No newline at end of file
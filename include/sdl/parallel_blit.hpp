@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <SDL_surface.h>
+
+#include <sdl/cpu_info.hpp>
+#include <sdl/error.hpp>
+#include <sdl/mutex.hpp>
+#include <sdl/rect.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/thread.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a blitter which splits the destination into row bands and blits
+// them on a worker pool.
+
+// About the size of a per-core L2 cache. Each band spans as many rows of the source and the destination as fit in it.
+inline constexpr std::size_t  default_parallel_blit_band_size   = 256 * 1024;
+inline constexpr std::int32_t default_parallel_blit_band_height = 8;
+
+// The output is bit-identical to `sdl::blit_surface`, since SDL blits each pixel independently of the others.
+//
+// SDL keeps the blit state in the blit map of the source surface, hence concurrent blits between the same surfaces are
+// not safe. Instead, each participating thread blits between its own surfaces which share the pixels, the format and the
+// attributes of the originals. Surfaces which must be locked (e.g. RLE encoded) or with fewer than 8 bits per pixel, blits
+// whose source and destination pixels overlap in memory (e.g. scrolling within a surface), and blits with a single band,
+// are blitted serially on the calling thread, since the bands would otherwise read rows which other bands write.
+//
+// Scaled blits are not supported, since SDL derives the sampling positions from the rectangles of each call, hence the
+// bands would not be bit-identical to a single scaled blit.
+class parallel_blitter
+{
+public:
+  // The thread count includes the calling thread, which blits bands as well. The constructor cannot transmit error state.
+  // You should use `sdl::make_parallel_blitter(...)` to handle errors.
+  explicit parallel_blitter  (
+    const std::size_t  thread_count        = static_cast<std::size_t>(std::max(get_cpu_count(), 1)),
+    const std::int32_t minimum_band_height = default_parallel_blit_band_height,
+    const std::size_t  band_size           = default_parallel_blit_band_size)
+  : minimum_band_height_(std::max(minimum_band_height, 1)), band_size_(band_size)
+  {
+    for (std::size_t i = 1; i < std::max<std::size_t>(thread_count, 1); ++i)
+      if (auto thread = make_thread([this] { return work(); }, "parallel_blit_worker"))
+        threads_.push_back(std::move(thread.value()));
+      else
+        break;
+  }
+  parallel_blitter           (const parallel_blitter&  that) = delete;
+  parallel_blitter           (      parallel_blitter&& temp) = delete;
+ ~parallel_blitter           ()
+  {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    work_available_.notify_all();
+    threads_.clear(); // Joins the threads.
+  }
+  parallel_blitter& operator=(const parallel_blitter&  that) = delete;
+  parallel_blitter& operator=(      parallel_blitter&& temp) = delete;
+
+  // Clips the rectangles as `sdl::blit_surface` does. Returns the destination rectangle after clipping.
+  std::expected<native_rect, std::string> blit                   (native_surface* source, const std::optional<native_rect>& source_rectangle, native_surface* destination, const native_rect& destination_rectangle = {})
+  {
+    if (!source || !destination)
+      return std::unexpected("Invalid surface.");
+    if (source->locked || destination->locked)
+      return std::unexpected("Surfaces must not be locked during blit.");
+
+    // The clipping of `SDL_UpperBlit`.
+    auto target = destination_rectangle;
+    auto origin = source_rectangle.value_or(native_rect {0, 0, source->w, source->h});
+    if (source_rectangle)
+    {
+      if (origin.x < 0)
+      {
+        origin.w += origin.x;
+        target.x -= origin.x;
+        origin.x  = 0;
+      }
+      if (origin.y < 0)
+      {
+        origin.h += origin.y;
+        target.y -= origin.y;
+        origin.y  = 0;
+      }
+      origin.w = std::min(origin.w, source->w - origin.x);
+      origin.h = std::min(origin.h, source->h - origin.y);
+    }
+
+    const auto& clip = destination->clip_rect;
+    if (const auto dx = clip.x - target.x; dx > 0)
+    {
+      origin.w -= dx;
+      target.x += dx;
+      origin.x += dx;
+    }
+    if (const auto dx = target.x + origin.w - clip.x - clip.w; dx > 0)
+      origin.w -= dx;
+    if (const auto dy = clip.y - target.y; dy > 0)
+    {
+      origin.h -= dy;
+      target.y += dy;
+      origin.y += dy;
+    }
+    if (const auto dy = target.y + origin.h - clip.y - clip.h; dy > 0)
+      origin.h -= dy;
+
+    if (origin.w <= 0 || origin.h <= 0)
+    {
+      target.w = target.h = 0;
+      return target;
+    }
+    target.w = origin.w;
+    target.h = origin.h;
+
+    const auto row_size    = static_cast<std::size_t>(origin.w) * (source->format->BytesPerPixel + destination->format->BytesPerPixel);
+    const auto band_height = std::max(minimum_band_height_, static_cast<std::int32_t>(std::min<std::size_t>(band_size_ / std::max<std::size_t>(row_size, 1), origin.h)));
+    const auto band_count  = (origin.h + band_height - 1) / band_height;
+    if (threads_.empty() || band_count < 2 || SDL_MUSTLOCK(source) || SDL_MUSTLOCK(destination) || source->format->BitsPerPixel < 8 || destination->format->BitsPerPixel < 8 ||
+        overlaps(source, origin, destination, target))
+    {
+      if (auto result = lower_blit(source, origin, destination, target); !result)
+        return std::unexpected(result.error());
+      return target;
+    }
+
+    std::lock_guard blit_lock(blit_mutex_);
+
+    const auto participants = std::min(threads_.size() + 1, static_cast<std::size_t>(band_count));
+    views_.resize(participants);
+    for (auto& [source_view, destination_view] : views_)
+    {
+      auto source_result      = make_view(source     );
+      auto destination_result = make_view(destination);
+      if (!source_result || !destination_result)
+        return std::unexpected(!source_result ? source_result.error() : destination_result.error());
+      source_view      = std::move(source_result     .value());
+      destination_view = std::move(destination_result.value());
+    }
+
+    job current {origin, target, band_height, band_count};
+    {
+      std::lock_guard lock(mutex_);
+      job_     = &current;
+      pending_ = threads_.size();
+      ++generation_;
+    }
+    work_available_.notify_all();
+    execute(current);
+    {
+      std::lock_guard lock(mutex_);
+      while (pending_ > 0)
+        all_completed_.wait(mutex_);
+      job_ = nullptr;
+    }
+
+    views_.clear();
+    if (!current.error.empty())
+      return std::unexpected(current.error);
+    return target;
+  }
+  std::expected<native_rect, std::string> blit                   (const surface& source, const surface& target, const native_point& position = {}, const std::optional<native_rect>& source_rectangle = std::nullopt)
+  {
+    return blit(source.native(), source_rectangle, target.native(), native_rect {position.x, position.y, 0, 0});
+  }
+
+  [[nodiscard]]
+  std::size_t                             thread_count           () const noexcept
+  {
+    return threads_.size() + 1;
+  }
+  [[nodiscard]]
+  std::int32_t                            minimum_band_height    () const noexcept
+  {
+    return minimum_band_height_;
+  }
+  void                                    set_minimum_band_height(const std::int32_t height) noexcept
+  {
+    minimum_band_height_ = std::max(height, 1);
+  }
+  [[nodiscard]]
+  std::size_t                             band_size              () const noexcept
+  {
+    return band_size_;
+  }
+  void                                    set_band_size          (const std::size_t size) noexcept
+  {
+    band_size_ = size;
+  }
+
+private:
+  struct surface_deleter
+  {
+    void operator()(native_surface* surface) const
+    {
+      SDL_FreeSurface(surface);
+    }
+  };
+  using surface_view = std::unique_ptr<native_surface, surface_deleter>;
+
+  struct job
+  {
+    native_rect               source       ;
+    native_rect               destination  ;
+    std::int32_t              band_height  ;
+    std::int32_t              band_count   ;
+    std::atomic<std::int32_t> next_band    {0};
+    std::atomic<std::size_t>  next_view    {0};
+    std::string               error        {}; // Guarded by the mutex.
+  };
+
+  // Whether the memory spanned by the rows of the rectangles intersects. Conservative for rectangles side by side, which
+  // share a range of addresses without sharing pixels.
+  static bool                                     overlaps (const native_surface* source, const native_rect& source_rectangle, const native_surface* destination, const native_rect& destination_rectangle)
+  {
+    const auto span = [ ] (const native_surface* surface, const native_rect& rectangle)
+    {
+      const auto begin = reinterpret_cast<std::uintptr_t>(surface->pixels) + static_cast<std::uintptr_t>(rectangle.y) * static_cast<std::uintptr_t>(surface->pitch) + static_cast<std::uintptr_t>(rectangle.x) * surface->format->BytesPerPixel;
+      const auto end   = begin + static_cast<std::uintptr_t>(rectangle.h - 1) * static_cast<std::uintptr_t>(surface->pitch) + static_cast<std::uintptr_t>(rectangle.w) * surface->format->BytesPerPixel;
+      return std::pair {begin, end};
+    };
+    const auto [source_begin     , source_end     ] = span(source     , source_rectangle     );
+    const auto [destination_begin, destination_end] = span(destination, destination_rectangle);
+    return source_begin < destination_end && destination_begin < source_end;
+  }
+  // A surface sharing the pixels, the format and the attributes of the original, with an own blit map.
+  static std::expected<surface_view, std::string> make_view(native_surface* original)
+  {
+    surface_view result(SDL_CreateRGBSurfaceWithFormatFrom(original->pixels, original->w, original->h, original->format->BitsPerPixel, original->pitch, original->format->format));
+    if (!result)
+      return std::unexpected(get_error());
+
+    std::uint8_t  red, green, blue, alpha;
+    SDL_BlendMode mode;
+    std::uint32_t key;
+    if ((original->format->palette && SDL_SetSurfacePalette(result.get(), original->format->palette) < 0) ||
+        SDL_GetSurfaceColorMod  (original, &red, &green, &blue) < 0 || SDL_SetSurfaceColorMod  (result.get(), red, green, blue) < 0 ||
+        SDL_GetSurfaceAlphaMod  (original, &alpha)              < 0 || SDL_SetSurfaceAlphaMod  (result.get(), alpha)            < 0 ||
+        SDL_GetSurfaceBlendMode (original, &mode)               < 0 || SDL_SetSurfaceBlendMode (result.get(), mode)             < 0 ||
+        (SDL_HasColorKey(original) && (SDL_GetColorKey(original, &key) < 0 || SDL_SetColorKey(result.get(), SDL_TRUE, key) < 0)))
+      return std::unexpected(get_error());
+    return result;
+  }
+
+  void         execute(job& current)
+  {
+    const auto view = current.next_view.fetch_add(1);
+    if (view >= views_.size())
+      return;
+
+    const auto& [source, destination] = views_[view];
+    for (auto band = current.next_band.fetch_add(1); band < current.band_count; band = current.next_band.fetch_add(1))
+    {
+      const auto offset = band * current.band_height;
+      const auto height = std::min(current.band_height, current.source.h - offset);
+      native_rect origin {current.source     .x, current.source     .y + offset, current.source.w, height};
+      native_rect target {current.destination.x, current.destination.y + offset, current.source.w, height};
+      if (SDL_LowerBlit(source.get(), &origin, destination.get(), &target) < 0)
+      {
+        std::lock_guard lock(mutex_);
+        if (current.error.empty())
+          current.error = get_error();
+      }
+    }
+  }
+  std::int32_t work   ()
+  {
+    std::uint64_t generation = 0;
+    while (true)
+    {
+      job* current;
+      {
+        std::lock_guard lock(mutex_);
+        while (generation_ == generation && !stopping_)
+          work_available_.wait(mutex_);
+        if (stopping_)
+          return 0;
+        generation = generation_;
+        current    = job_;
+      }
+
+      execute(*current);
+
+      std::lock_guard lock(mutex_);
+      if (--pending_ == 0)
+        all_completed_.notify_all();
+    }
+  }
+
+  std::int32_t                                        minimum_band_height_;
+  std::size_t                                         band_size_          ;
+  std::vector<std::pair<surface_view, surface_view>>  views_              {};
+
+  mutex                                               blit_mutex_         {};
+  mutex                                               mutex_              {};
+  condition_variable                                  work_available_     {};
+  condition_variable                                  all_completed_      {};
+  job*                                                job_                {};
+  std::size_t                                         pending_            {};
+  std::uint64_t                                       generation_         {};
+  bool                                                stopping_           {false};
+
+  std::vector<std::unique_ptr<thread>>                threads_            {}; // Declared last to be joined before the rest is destroyed.
+};
+
+[[nodiscard]]
+inline std::expected<std::unique_ptr<parallel_blitter>, std::string> make_parallel_blitter(
+  const std::size_t  thread_count        = static_cast<std::size_t>(std::max(get_cpu_count(), 1)),
+  const std::int32_t minimum_band_height = default_parallel_blit_band_height,
+  const std::size_t  band_size           = default_parallel_blit_band_size)
+{
+  auto result = std::make_unique<parallel_blitter>(thread_count, minimum_band_height, band_size);
+  if (result->thread_count() != std::max<std::size_t>(thread_count, 1))
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
@@ -0,0 +1,507 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <SDL_surface.h>
+
+#include <sdl/cpu_info.hpp>
+#include <sdl/endian.hpp>
+#include <sdl/pixels.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides vectorized conversions for the common pixel format pairs, which
+// `sdl::convert_pixels` uses before falling back to `SDL_ConvertPixels`:
+// - RGB24, BGR24 and the 32-bit RGB formats to the 32-bit formats with alpha (ARGB8888, RGBA8888, ABGR8888, BGRA8888).
+// - IYUV, YV12, NV12 and NV21 to ARGB8888 and ABGR8888.
+
+// The 6-bit fixed-point YUV to RGB coefficients of SDL. The results are identical to SDL as long as no channel sum
+// leaves the range [-128, 384) * 64, e.g. for luma in [16, 235] and chroma in [80, 176]. Beyond it, the kernels saturate
+// to 0 or 255 whereas SDL wraps around (through the `& 511` of its lookup table, or the 16-bit additions of SSE2).
+struct yuv_coefficients
+{
+  std::int16_t y_offset;
+  std::int16_t y_factor;
+  std::int16_t v_r     ;
+  std::int16_t u_g     ;
+  std::int16_t v_g     ;
+  std::int16_t u_b     ;
+};
+
+inline constexpr yuv_coefficients yuv_coefficients_jpeg  { 0, 64,  90, -22, -46, 113};
+inline constexpr yuv_coefficients yuv_coefficients_bt601 {16, 75, 102, -25, -52, 129};
+inline constexpr yuv_coefficients yuv_coefficients_bt709 {16, 75, 115, -14, -34, 135};
+
+// The byte offsets of the red, green, blue and alpha channels of a pixel in memory. Absent channels are 255.
+struct pixel_byte_layout
+{
+  std::size_t                 width   ;
+  std::array<std::uint8_t, 4> channels;
+};
+
+// Converts a row of `count` pixels of `source_width` (3 or 4) bytes to 4 bytes, where the destination byte `i` is the
+// source byte `order[i]`, or opaque if `order[i]` is 255.
+using pixel_shuffle_kernel = void (*) (const std::byte* source, std::size_t source_width, std::byte* destination, std::size_t count, const std::array<std::uint8_t, 4>& order);
+// Converts a row of `count` pixels of 4:2:0 YUV to blue, green, red, alpha bytes (or red, green, blue, alpha if
+// `swap_red_blue` is set). The chroma samples are `chroma_step` bytes apart, which is 1 for planar and 2 for semi-planar
+// formats.
+using yuv_row_kernel       = void (*) (const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, std::size_t chroma_step, std::byte* destination, std::size_t count, const yuv_coefficients& coefficients, bool swap_red_blue);
+
+struct pixel_conversion_kernels
+{
+  const char*          name   ;
+  pixel_shuffle_kernel shuffle;
+  yuv_row_kernel       yuv    ;
+};
+
+// The layouts apply to little endian only, since the 32-bit formats are packed.
+[[nodiscard]]
+constexpr std::optional<pixel_byte_layout> get_pixel_byte_layout(const std::uint32_t format) noexcept
+{
+  switch (format)
+  {
+  case SDL_PIXELFORMAT_RGB24   : return pixel_byte_layout {3, {0, 1, 2, 255}};
+  case SDL_PIXELFORMAT_BGR24   : return pixel_byte_layout {3, {2, 1, 0, 255}};
+  case SDL_PIXELFORMAT_XRGB8888: return pixel_byte_layout {4, {2, 1, 0, 255}};
+  case SDL_PIXELFORMAT_XBGR8888: return pixel_byte_layout {4, {0, 1, 2, 255}};
+  case SDL_PIXELFORMAT_ARGB8888: return pixel_byte_layout {4, {2, 1, 0, 3  }};
+  case SDL_PIXELFORMAT_RGBA8888: return pixel_byte_layout {4, {3, 2, 1, 0  }};
+  case SDL_PIXELFORMAT_ABGR8888: return pixel_byte_layout {4, {0, 1, 2, 3  }};
+  case SDL_PIXELFORMAT_BGRA8888: return pixel_byte_layout {4, {1, 2, 3, 0  }};
+  default                      : return std::nullopt;
+  }
+}
+[[nodiscard]]
+constexpr bool                             is_yuv_420_format    (const std::uint32_t format) noexcept
+{
+  return format == SDL_PIXELFORMAT_IYUV || format == SDL_PIXELFORMAT_YV12 || format == SDL_PIXELFORMAT_NV12 || format == SDL_PIXELFORMAT_NV21;
+}
+[[nodiscard]]
+constexpr bool                             has_vectorized_pixel_conversion(const std::uint32_t source_format, const std::uint32_t destination_format) noexcept
+{
+  if (byte_order != endian::little || source_format == destination_format)
+    return false;
+  if (is_yuv_420_format(source_format))
+    return destination_format == SDL_PIXELFORMAT_ARGB8888 || destination_format == SDL_PIXELFORMAT_ABGR8888;
+
+  const auto source      = get_pixel_byte_layout(source_format     );
+  const auto destination = get_pixel_byte_layout(destination_format);
+  return source && destination && destination->channels[3] != 255;
+}
+
+inline void shuffle_pixels_scalar (const std::byte* source, const std::size_t source_width, std::byte* destination, const std::size_t count, const std::array<std::uint8_t, 4>& order) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i, source += source_width, destination += 4)
+    for (std::size_t j = 0; j < 4; ++j)
+      destination[j] = order[j] == 255 ? std::byte {255} : source[order[j]];
+}
+inline void convert_yuv_row_scalar(const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, const std::size_t chroma_step, std::byte* destination, const std::size_t count, const yuv_coefficients& coefficients, const bool swap_red_blue) noexcept
+{
+  const auto clamp = [ ] (const std::int32_t value)
+  {
+    return static_cast<std::byte>(std::clamp(value >> 6, 0, 255));
+  };
+
+  for (std::size_t i = 0; i < count; ++i, destination += 4)
+  {
+    const std::int32_t luma  = (y[i] - coefficients.y_offset) * coefficients.y_factor;
+    const std::int32_t cb    = u[i / 2 * chroma_step] - 128;
+    const std::int32_t cr    = v[i / 2 * chroma_step] - 128;
+    const auto         red   = clamp(luma + cr * coefficients.v_r);
+    const auto         green = clamp(luma + cb * coefficients.u_g + cr * coefficients.v_g);
+    const auto         blue  = clamp(luma + cb * coefficients.u_b);
+    destination[0] = swap_red_blue ? red  : blue;
+    destination[1] = green;
+    destination[2] = swap_red_blue ? blue : red ;
+    destination[3] = std::byte {255};
+  }
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+// Requires SSSE3 for `_mm_shuffle_epi8`. SDL does not query SSSE3, hence the caller checks for SSE4.1 which implies it.
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("ssse3")]]
+#endif
+inline void shuffle_pixels_ssse3  (const std::byte* source, const std::size_t source_width, std::byte* destination, const std::size_t count, const std::array<std::uint8_t, 4>& order) noexcept
+{
+  // Each iteration converts 4 pixels. Indices with the high bit set produce zero, which the opaque mask fills.
+  std::array<std::uint8_t, 16> indices {}, opaque {};
+  for (std::size_t i = 0; i < 4; ++i)
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      indices[i * 4 + j] = order[j] == 255 ? 0x80 : static_cast<std::uint8_t>(i * source_width + order[j]);
+      opaque [i * 4 + j] = order[j] == 255 ? 0xFF : 0x00;
+    }
+  const auto mask  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices.data()));
+  const auto alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(opaque .data()));
+
+  // The loads are 16 bytes wide, hence the last pixels of 3-byte rows are left to the scalar path.
+  const auto  size = count * source_width;
+  std::size_t i    = 0;
+  for (; i * source_width + 16 <= size; i += 4)
+  {
+    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * source_width));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_or_si128(_mm_shuffle_epi8(value, mask), alpha));
+  }
+  shuffle_pixels_scalar(source + i * source_width, source_width, destination + i * 4, count - i, order);
+}
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("avx2")]]
+#endif
+inline void shuffle_pixels_avx2   (const std::byte* source, const std::size_t source_width, std::byte* destination, const std::size_t count, const std::array<std::uint8_t, 4>& order) noexcept
+{
+  // Each iteration converts 8 pixels. The shuffle operates within each 128-bit lane, hence each lane is loaded from the
+  // start of its 4 pixels and the mask is repeated.
+  std::array<std::uint8_t, 16> indices {}, opaque {};
+  for (std::size_t i = 0; i < 4; ++i)
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      indices[i * 4 + j] = order[j] == 255 ? 0x80 : static_cast<std::uint8_t>(i * source_width + order[j]);
+      opaque [i * 4 + j] = order[j] == 255 ? 0xFF : 0x00;
+    }
+  const auto mask  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices.data())));
+  const auto alpha = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(opaque .data())));
+
+  const auto  size = count * source_width;
+  std::size_t i    = 0;
+  for (; (i + 4) * source_width + 16 <= size; i += 8)
+  {
+    const auto low   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source +  i      * source_width));
+    const auto high  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + (i + 4) * source_width));
+    const auto value = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(value, mask), alpha));
+  }
+  shuffle_pixels_scalar(source + i * source_width, source_width, destination + i * 4, count - i, order);
+}
+
+// Adds the chroma term to the luma terms of 16 pixels, each chroma sample covering two pixels, and packs the channel.
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("sse2")]]
+#endif
+inline __m128i yuv_channel_sse2   (const __m128i luma_low, const __m128i luma_high, const __m128i chroma) noexcept
+{
+  const auto low  = _mm_srai_epi16(_mm_adds_epi16(luma_low , _mm_unpacklo_epi16(chroma, chroma)), 6);
+  const auto high = _mm_srai_epi16(_mm_adds_epi16(luma_high, _mm_unpackhi_epi16(chroma, chroma)), 6);
+  return _mm_packus_epi16(low, high);
+}
+// The sums saturate only if the result exceeds 255, hence 16-bit lanes produce the same results as the scalar path.
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("sse2")]]
+#endif
+inline void convert_yuv_row_sse2  (const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, const std::size_t chroma_step, std::byte* destination, const std::size_t count, const yuv_coefficients& coefficients, const bool swap_red_blue) noexcept
+{
+  const auto zero     = _mm_setzero_si128  ();
+  const auto bias     = _mm_set1_epi16     (128);
+  const auto byte     = _mm_set1_epi16     (0x00FF);
+  const auto opaque   = _mm_set1_epi8      (-1);
+  const auto y_offset = _mm_set1_epi16     (coefficients.y_offset);
+  const auto y_factor = _mm_set1_epi16     (coefficients.y_factor);
+  const auto v_r      = _mm_set1_epi16     (coefficients.v_r);
+  const auto u_g      = _mm_set1_epi16     (coefficients.u_g);
+  const auto v_g      = _mm_set1_epi16     (coefficients.v_g);
+  const auto u_b      = _mm_set1_epi16     (coefficients.u_b);
+  const auto pairs    = std::min(u, v);
+
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    __m128i cb, cr;
+    if (chroma_step == 1)
+    {
+      cb = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + i / 2)), zero);
+      cr = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + i / 2)), zero);
+    }
+    else
+    {
+      const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pairs + i));
+      const auto first = _mm_and_si128  (value, byte);
+      const auto other = _mm_srli_epi16 (value, 8);
+      cb = u < v ? first : other;
+      cr = u < v ? other : first;
+    }
+    cb = _mm_sub_epi16(cb, bias);
+    cr = _mm_sub_epi16(cr, bias);
+
+    const auto luma      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+    const auto luma_low  = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(luma, zero), y_offset), y_factor);
+    const auto luma_high = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(luma, zero), y_offset), y_factor);
+    const auto red       = yuv_channel_sse2(luma_low, luma_high, _mm_mullo_epi16(cr, v_r));
+    const auto green     = yuv_channel_sse2(luma_low, luma_high, _mm_add_epi16(_mm_mullo_epi16(cb, u_g), _mm_mullo_epi16(cr, v_g)));
+    const auto blue      = yuv_channel_sse2(luma_low, luma_high, _mm_mullo_epi16(cb, u_b));
+    const auto first     = swap_red_blue ? red  : blue;
+    const auto third     = swap_red_blue ? blue : red ;
+
+    const auto low       = _mm_unpacklo_epi8(first, green );
+    const auto high      = _mm_unpackhi_epi8(first, green );
+    const auto low_a     = _mm_unpacklo_epi8(third, opaque);
+    const auto high_a    = _mm_unpackhi_epi8(third, opaque);
+    const auto target    = reinterpret_cast<__m128i*>(destination + i * 4);
+    _mm_storeu_si128(target    , _mm_unpacklo_epi16(low , low_a ));
+    _mm_storeu_si128(target + 1, _mm_unpackhi_epi16(low , low_a ));
+    _mm_storeu_si128(target + 2, _mm_unpacklo_epi16(high, high_a));
+    _mm_storeu_si128(target + 3, _mm_unpackhi_epi16(high, high_a));
+  }
+  convert_yuv_row_scalar(y + i, u + i / 2 * chroma_step, v + i / 2 * chroma_step, chroma_step, destination + i * 4, count - i, coefficients, swap_red_blue);
+}
+
+// The 256-bit variant of `yuv_channel_sse2` for 32 pixels. The chroma samples are in order, whereas the unpack and pack
+// instructions operate within each 128-bit lane, hence the permutations.
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("avx2")]]
+#endif
+inline __m256i yuv_channel_avx2   (const __m256i luma_low, const __m256i luma_high, const __m256i chroma) noexcept
+{
+  const auto first  = _mm256_unpacklo_epi16(chroma, chroma);
+  const auto second = _mm256_unpackhi_epi16(chroma, chroma);
+  const auto low    = _mm256_srai_epi16(_mm256_adds_epi16(luma_low , _mm256_permute2x128_si256(first, second, 0x20)), 6);
+  const auto high   = _mm256_srai_epi16(_mm256_adds_epi16(luma_high, _mm256_permute2x128_si256(first, second, 0x31)), 6);
+  return _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+}
+#if defined(__GNUC__) || defined(__clang__)
+[[gnu::target("avx2")]]
+#endif
+inline void convert_yuv_row_avx2  (const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, const std::size_t chroma_step, std::byte* destination, const std::size_t count, const yuv_coefficients& coefficients, const bool swap_red_blue) noexcept
+{
+  const auto bias     = _mm256_set1_epi16(128);
+  const auto byte     = _mm256_set1_epi16(0x00FF);
+  const auto opaque   = _mm256_set1_epi8 (-1);
+  const auto y_offset = _mm256_set1_epi16(coefficients.y_offset);
+  const auto y_factor = _mm256_set1_epi16(coefficients.y_factor);
+  const auto v_r      = _mm256_set1_epi16(coefficients.v_r);
+  const auto u_g      = _mm256_set1_epi16(coefficients.u_g);
+  const auto v_g      = _mm256_set1_epi16(coefficients.v_g);
+  const auto u_b      = _mm256_set1_epi16(coefficients.u_b);
+  const auto pairs    = std::min(u, v);
+
+  std::size_t i = 0;
+  for (; i + 32 <= count; i += 32)
+  {
+    __m256i cb, cr;
+    if (chroma_step == 1)
+    {
+      cb = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u + i / 2)));
+      cr = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + i / 2)));
+    }
+    else
+    {
+      const auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs + i));
+      const auto first = _mm256_and_si256  (value, byte);
+      const auto other = _mm256_srli_epi16 (value, 8);
+      cb = u < v ? first : other;
+      cr = u < v ? other : first;
+    }
+    cb = _mm256_sub_epi16(cb, bias);
+    cr = _mm256_sub_epi16(cr, bias);
+
+    const auto luma      = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+    const auto luma_low  = _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128   (luma   )), y_offset), y_factor);
+    const auto luma_high = _mm256_mullo_epi16(_mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(luma, 1)), y_offset), y_factor);
+    const auto red       = yuv_channel_avx2(luma_low, luma_high, _mm256_mullo_epi16(cr, v_r));
+    const auto green     = yuv_channel_avx2(luma_low, luma_high, _mm256_add_epi16(_mm256_mullo_epi16(cb, u_g), _mm256_mullo_epi16(cr, v_g)));
+    const auto blue      = yuv_channel_avx2(luma_low, luma_high, _mm256_mullo_epi16(cb, u_b));
+    const auto first     = swap_red_blue ? red  : blue;
+    const auto third     = swap_red_blue ? blue : red ;
+
+    // Each quarter holds the pixels [0, 4) | [16, 20), [4, 8) | [20, 24), [8, 12) | [24, 28) and [12, 16) | [28, 32).
+    const auto low       = _mm256_unpacklo_epi8 (first, green );
+    const auto high      = _mm256_unpackhi_epi8 (first, green );
+    const auto low_a     = _mm256_unpacklo_epi8 (third, opaque);
+    const auto high_a    = _mm256_unpackhi_epi8 (third, opaque);
+    const auto quarter_0 = _mm256_unpacklo_epi16(low , low_a );
+    const auto quarter_1 = _mm256_unpackhi_epi16(low , low_a );
+    const auto quarter_2 = _mm256_unpacklo_epi16(high, high_a);
+    const auto quarter_3 = _mm256_unpackhi_epi16(high, high_a);
+    const auto target    = reinterpret_cast<__m256i*>(destination + i * 4);
+    _mm256_storeu_si256(target    , _mm256_permute2x128_si256(quarter_0, quarter_1, 0x20));
+    _mm256_storeu_si256(target + 1, _mm256_permute2x128_si256(quarter_2, quarter_3, 0x20));
+    _mm256_storeu_si256(target + 2, _mm256_permute2x128_si256(quarter_0, quarter_1, 0x31));
+    _mm256_storeu_si256(target + 3, _mm256_permute2x128_si256(quarter_2, quarter_3, 0x31));
+  }
+  convert_yuv_row_scalar(y + i, u + i / 2 * chroma_step, v + i / 2 * chroma_step, chroma_step, destination + i * 4, count - i, coefficients, swap_red_blue);
+}
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+inline void shuffle_pixels_neon   (const std::byte* source, const std::size_t source_width, std::byte* destination, const std::size_t count, const std::array<std::uint8_t, 4>& order) noexcept
+{
+  const auto  opaque = vdupq_n_u8(255);
+  std::size_t i      = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    const auto  pointer = reinterpret_cast<const std::uint8_t*>(source + i * source_width);
+    uint8x16_t  channels[4];
+    if (source_width == 3)
+    {
+      const auto value = vld3q_u8(pointer);
+      channels[0] = value.val[0];
+      channels[1] = value.val[1];
+      channels[2] = value.val[2];
+      channels[3] = opaque;
+    }
+    else
+    {
+      const auto value = vld4q_u8(pointer);
+      channels[0] = value.val[0];
+      channels[1] = value.val[1];
+      channels[2] = value.val[2];
+      channels[3] = value.val[3];
+    }
+
+    uint8x16x4_t result;
+    for (std::size_t j = 0; j < 4; ++j)
+      result.val[j] = order[j] == 255 ? opaque : channels[order[j]];
+    vst4q_u8(reinterpret_cast<std::uint8_t*>(destination + i * 4), result);
+  }
+  shuffle_pixels_scalar(source + i * source_width, source_width, destination + i * 4, count - i, order);
+}
+
+inline uint8x16_t yuv_channel_neon(const int16x8_t luma_low, const int16x8_t luma_high, const int16x8_t chroma) noexcept
+{
+  const auto pairs = vzipq_s16(chroma, chroma);
+  const auto low   = vshrq_n_s16(vqaddq_s16(luma_low , pairs.val[0]), 6);
+  const auto high  = vshrq_n_s16(vqaddq_s16(luma_high, pairs.val[1]), 6);
+  return vcombine_u8(vqmovun_s16(low), vqmovun_s16(high));
+}
+inline void convert_yuv_row_neon  (const std::uint8_t* y, const std::uint8_t* u, const std::uint8_t* v, const std::size_t chroma_step, std::byte* destination, const std::size_t count, const yuv_coefficients& coefficients, const bool swap_red_blue) noexcept
+{
+  const auto bias     = vdupq_n_s16(128);
+  const auto opaque   = vdupq_n_u8 (255);
+  const auto y_offset = vdupq_n_s16(coefficients.y_offset);
+  const auto y_factor = vdupq_n_s16(coefficients.y_factor);
+  const auto pairs    = std::min(u, v);
+
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    uint8x8_t cb_bytes, cr_bytes;
+    if (chroma_step == 1)
+    {
+      cb_bytes = vld1_u8(u + i / 2);
+      cr_bytes = vld1_u8(v + i / 2);
+    }
+    else
+    {
+      const auto value = vld2_u8(pairs + i);
+      cb_bytes = u < v ? value.val[0] : value.val[1];
+      cr_bytes = u < v ? value.val[1] : value.val[0];
+    }
+    const auto cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb_bytes)), bias);
+    const auto cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr_bytes)), bias);
+
+    const auto luma      = vld1q_u8(y + i);
+    const auto luma_low  = vmulq_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8 (luma))), y_offset), y_factor);
+    const auto luma_high = vmulq_s16(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(luma))), y_offset), y_factor);
+    const auto red       = yuv_channel_neon(luma_low, luma_high, vmulq_n_s16(cr, coefficients.v_r));
+    const auto green     = yuv_channel_neon(luma_low, luma_high, vaddq_s16(vmulq_n_s16(cb, coefficients.u_g), vmulq_n_s16(cr, coefficients.v_g)));
+    const auto blue      = yuv_channel_neon(luma_low, luma_high, vmulq_n_s16(cb, coefficients.u_b));
+
+    uint8x16x4_t result;
+    result.val[0] = swap_red_blue ? red  : blue;
+    result.val[1] = green;
+    result.val[2] = swap_red_blue ? blue : red ;
+    result.val[3] = opaque;
+    vst4q_u8(reinterpret_cast<std::uint8_t*>(destination + i * 4), result);
+  }
+  convert_yuv_row_scalar(y + i, u + i / 2 * chroma_step, v + i / 2 * chroma_step, chroma_step, destination + i * 4, count - i, coefficients, swap_red_blue);
+}
+#endif
+
+inline constexpr pixel_conversion_kernels pixel_conversion_kernels_scalar {"scalar", &shuffle_pixels_scalar, &convert_yuv_row_scalar};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+inline constexpr pixel_conversion_kernels pixel_conversion_kernels_sse2   {"sse2"  , &shuffle_pixels_scalar, &convert_yuv_row_sse2  };
+inline constexpr pixel_conversion_kernels pixel_conversion_kernels_ssse3  {"ssse3" , &shuffle_pixels_ssse3 , &convert_yuv_row_sse2  };
+inline constexpr pixel_conversion_kernels pixel_conversion_kernels_avx2   {"avx2"  , &shuffle_pixels_avx2  , &convert_yuv_row_avx2  };
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+inline constexpr pixel_conversion_kernels pixel_conversion_kernels_neon   {"neon"  , &shuffle_pixels_neon  , &convert_yuv_row_neon  };
+#endif
+
+// The kernels are selected once, based on the features of the CPU at runtime. Returns `nullptr` if the CPU has no vector
+// extension, in which case the conversions are left to SDL.
+[[nodiscard]]
+inline const pixel_conversion_kernels* get_pixel_conversion_kernels()
+{
+  static const pixel_conversion_kernels* kernels = [ ] () -> const pixel_conversion_kernels*
+  {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    if (has_avx2 ())
+      return &pixel_conversion_kernels_avx2;
+    if (has_sse41())
+      return &pixel_conversion_kernels_ssse3;
+    if (has_sse2 ())
+      return &pixel_conversion_kernels_sse2;
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+    if (has_neon ())
+      return &pixel_conversion_kernels_neon;
+#endif
+    return nullptr;
+  }();
+  return kernels;
+}
+
+// Converts the pixels with the kernels and returns true if the format pair has a vectorized conversion (see
+// `has_vectorized_pixel_conversion`), returns false otherwise. The pitches are in bytes. The YUV planes follow each
+// other as in `SDL_ConvertPixels`, and the coefficients are selected by `SDL_GetYUVConversionModeForResolution`.
+inline bool                                convert_pixels_vectorized(
+  const pixel_conversion_kernels&    kernels           ,
+  const std::array<std::int32_t, 2>& size              ,
+  const std::uint32_t                source_format     ,
+  const void*                        source            ,
+  const std::int32_t                 source_pitch      ,
+  const std::uint32_t                destination_format,
+  void*                              destination       ,
+  const std::int32_t                 destination_pitch )
+{
+  if (size[0] <= 0 || size[1] <= 0 || !source || !destination || !has_vectorized_pixel_conversion(source_format, destination_format))
+    return false;
+
+  const auto width  = static_cast<std::size_t>(size[0]);
+  const auto input  = static_cast<const std::uint8_t*>(source);
+  const auto output = static_cast<std::byte*>         (destination);
+
+  if (is_yuv_420_format(source_format))
+  {
+    const auto semi_planar   = source_format == SDL_PIXELFORMAT_NV12 || source_format == SDL_PIXELFORMAT_NV21;
+    const auto chroma_step   = semi_planar ? std::size_t(2) : std::size_t(1);
+    const auto chroma_pitch  = semi_planar ? static_cast<std::ptrdiff_t>((source_pitch + 1) / 2 * 2) : static_cast<std::ptrdiff_t>((source_pitch + 1) / 2);
+    const auto first_plane   = input + static_cast<std::ptrdiff_t>(size[1]) * source_pitch;
+    const auto second_plane  = semi_planar ? first_plane + 1 : first_plane + static_cast<std::ptrdiff_t>((size[1] + 1) / 2) * chroma_pitch;
+    const auto u_first       = source_format == SDL_PIXELFORMAT_IYUV || source_format == SDL_PIXELFORMAT_NV12;
+    const auto u             = u_first ? first_plane  : second_plane;
+    const auto v             = u_first ? second_plane : first_plane ;
+    const auto swap_red_blue = destination_format == SDL_PIXELFORMAT_ABGR8888;
+
+    const yuv_coefficients* coefficients;
+    switch (SDL_GetYUVConversionModeForResolution(size[0], size[1]))
+    {
+    case SDL_YUV_CONVERSION_JPEG : coefficients = &yuv_coefficients_jpeg ; break;
+    case SDL_YUV_CONVERSION_BT709: coefficients = &yuv_coefficients_bt709; break;
+    default                      : coefficients = &yuv_coefficients_bt601; break;
+    }
+
+    for (std::int32_t row = 0; row < size[1]; ++row)
+    {
+      const auto chroma_offset = static_cast<std::ptrdiff_t>(row / 2) * chroma_pitch;
+      kernels.yuv(input + static_cast<std::ptrdiff_t>(row) * source_pitch, u + chroma_offset, v + chroma_offset, chroma_step, output + static_cast<std::ptrdiff_t>(row) * destination_pitch, width, *coefficients, swap_red_blue);
+    }
+    return true;
+  }
+
+  const auto source_layout      = get_pixel_byte_layout(source_format     ).value();
+  const auto destination_layout = get_pixel_byte_layout(destination_format).value();
+  std::array<std::uint8_t, 4> order {};
+  for (std::size_t channel = 0; channel < 4; ++channel)
+    order[destination_layout.channels[channel]] = source_layout.channels[channel];
+
+  for (std::int32_t row = 0; row < size[1]; ++row)
+    kernels.shuffle(reinterpret_cast<const std::byte*>(input) + static_cast<std::ptrdiff_t>(row) * source_pitch, source_layout.width, output + static_cast<std::ptrdiff_t>(row) * destination_pitch, width, order);
+  return true;
+}
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <SDL_pixels.h>
+
+#include <sdl/error.hpp>
+
+namespace sdl
+{
+using native_color        = SDL_Color      ;
+using native_palette      = SDL_Palette    ;
+using native_pixel_format = SDL_PixelFormat;
+
+struct pixel_format_masks
+{
+  std::int32_t  bits_per_pixel;
+  std::uint32_t red           ;
+  std::uint32_t green         ;
+  std::uint32_t blue          ;
+  std::uint32_t alpha         ;
+};
+
+[[nodiscard]]
+constexpr std::uint32_t                                      bits_per_pixel            (const std::uint32_t format) noexcept
+{
+  return SDL_BITSPERPIXEL(format);
+}
+[[nodiscard]]
+constexpr std::uint32_t                                      bytes_per_pixel           (const std::uint32_t format) noexcept
+{
+  return SDL_BYTESPERPIXEL(format);
+}
+[[nodiscard]]
+constexpr bool                                               is_pixel_format_fourcc    (const std::uint32_t format) noexcept
+{
+  return SDL_ISPIXELFORMAT_FOURCC(format);
+}
+[[nodiscard]]
+constexpr bool                                               is_pixel_format_indexed   (const std::uint32_t format) noexcept
+{
+  return SDL_ISPIXELFORMAT_INDEXED(format);
+}
+[[nodiscard]]
+constexpr bool                                               is_pixel_format_alpha     (const std::uint32_t format) noexcept
+{
+  return SDL_ISPIXELFORMAT_ALPHA(format);
+}
+
+[[nodiscard]]
+inline std::string                                           get_pixel_format_name     (const std::uint32_t format)
+{
+  return SDL_GetPixelFormatName(format);
+}
+[[nodiscard]]
+inline std::expected<pixel_format_masks  , std::string>      pixel_format_enum_to_masks(const std::uint32_t format)
+{
+  pixel_format_masks result {};
+  if (SDL_PixelFormatEnumToMasks(format, &result.bits_per_pixel, &result.red, &result.green, &result.blue, &result.alpha) == SDL_FALSE)
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::uint32_t                                         masks_to_pixel_format_enum(const pixel_format_masks& masks)
+{
+  return SDL_MasksToPixelFormatEnum(masks.bits_per_pixel, masks.red, masks.green, masks.blue, masks.alpha);
+}
+
+[[nodiscard]]
+inline std::expected<native_pixel_format*, std::string>      alloc_format              (const std::uint32_t format)
+{
+  const auto result = SDL_AllocFormat(format);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+inline void                                                  free_format               (native_pixel_format* format)
+{
+  SDL_FreeFormat(format);
+}
+
+[[nodiscard]]
+inline std::expected<native_palette*     , std::string>      alloc_palette             (const std::int32_t color_count)
+{
+  const auto result = SDL_AllocPalette(color_count);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void                , std::string>      set_pixel_format_palette  (native_pixel_format* format, native_palette* palette)
+{
+  if (SDL_SetPixelFormatPalette(format, palette) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                , std::string>      set_palette_colors        (native_palette* palette, const std::span<const native_color>& colors, const std::int32_t first_color = 0)
+{
+  if (SDL_SetPaletteColors(palette, colors.data(), first_color, static_cast<std::int32_t>(colors.size())) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline void                                                  free_palette              (native_palette* palette)
+{
+  SDL_FreePalette(palette);
+}
+
+[[nodiscard]]
+inline std::uint32_t                                         map_rgb                   (const native_pixel_format* format, const std::array<std::uint8_t, 3>& color)
+{
+  return SDL_MapRGB (format, color[0], color[1], color[2]);
+}
+[[nodiscard]]
+inline std::uint32_t                                         map_rgba                  (const native_pixel_format* format, const std::array<std::uint8_t, 4>& color)
+{
+  return SDL_MapRGBA(format, color[0], color[1], color[2], color[3]);
+}
+[[nodiscard]]
+inline std::array<std::uint8_t, 3>                           get_rgb                   (const native_pixel_format* format, const std::uint32_t pixel)
+{
+  std::array<std::uint8_t, 3> result {};
+  SDL_GetRGB (pixel, format, &result[0], &result[1], &result[2]);
+  return result;
+}
+[[nodiscard]]
+inline std::array<std::uint8_t, 4>                           get_rgba                  (const native_pixel_format* format, const std::uint32_t pixel)
+{
+  std::array<std::uint8_t, 4> result {};
+  SDL_GetRGBA(pixel, format, &result[0], &result[1], &result[2], &result[3]);
+  return result;
+}
+
+[[nodiscard]]
+inline std::array<std::uint16_t, 256>                        calculate_gamma_ramp      (const float gamma)
+{
+  std::array<std::uint16_t, 256> result {};
+  SDL_CalculateGammaRamp(gamma, result.data());
+  return result;
+}
+
+// Conveniences.
+
+// A process-wide cache of interned pixel formats. `SDL_AllocFormat` shares the formats as well, but frees them once the
+// last reference is freed, hence formats which are allocated and freed every frame are allocated every frame. The cache
+// retains the formats until they are trimmed, even when no handle refers to them.
+class pixel_format_cache
+{
+public:
+  struct entry
+  {
+    native_pixel_format*     native    ;
+    std::atomic<std::size_t> references;
+  };
+
+  pixel_format_cache           ()                                = default;
+  pixel_format_cache           (const pixel_format_cache&  that) = delete;
+  pixel_format_cache           (      pixel_format_cache&& temp) = delete;
+ ~pixel_format_cache           ()
+  {
+    for (const auto& [format, current] : entries_)
+      SDL_FreeFormat(current->native);
+  }
+  pixel_format_cache& operator=(const pixel_format_cache&  that) = delete;
+  pixel_format_cache& operator=(      pixel_format_cache&& temp) = delete;
+
+  // Returns the entry with an additional reference, which is released with `release`.
+  [[nodiscard]]
+  std::expected<entry*, std::string> acquire(const std::uint32_t format)
+  {
+    std::lock_guard lock(mutex_);
+    auto& current = entries_[format];
+    if (!current)
+    {
+      const auto native = SDL_AllocFormat(format);
+      if (!native)
+      {
+        entries_.erase(format);
+        return std::unexpected(get_error());
+      }
+      current = std::make_unique<entry>(native, 0);
+    }
+    current->references.fetch_add(1, std::memory_order_relaxed);
+    return current.get();
+  }
+  static void                        release(entry* current) noexcept
+  {
+    current->references.fetch_sub(1, std::memory_order_release);
+  }
+
+  // Frees the formats which no handle refers to. Returns the number of freed formats.
+  std::size_t                        trim   ()
+  {
+    std::lock_guard lock(mutex_);
+    return std::erase_if(entries_, [ ] (const auto& iterator)
+    {
+      if (iterator.second->references.load(std::memory_order_acquire) != 0)
+        return false;
+      SDL_FreeFormat(iterator.second->native);
+      return true;
+    });
+  }
+  [[nodiscard]]
+  std::size_t                        size   () const
+  {
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+  }
+
+private:
+  mutable std::mutex                                        mutex_  ;
+  std::unordered_map<std::uint32_t, std::unique_ptr<entry>> entries_;
+};
+
+[[nodiscard]]
+inline pixel_format_cache& get_pixel_format_cache()
+{
+  static pixel_format_cache cache;
+  return cache;
+}
+
+// A refcounted handle to a format of the pixel format cache. The native format is resolved once, hence mapping colors
+// involves no lookup.
+class pixel_format
+{
+public:
+  pixel_format           ()                          = default;
+  // The constructor cannot transmit error state. You should use `sdl::make_pixel_format(...)` to handle errors.
+  explicit pixel_format  (const std::uint32_t format)
+  : entry_(get_pixel_format_cache().acquire(format).value_or(nullptr))
+  {
+
+  }
+  pixel_format           (const pixel_format&  that) noexcept
+  : entry_(that.entry_)
+  {
+    if (entry_)
+      entry_->references.fetch_add(1, std::memory_order_relaxed);
+  }
+  pixel_format           (      pixel_format&& temp) noexcept
+  : entry_(std::exchange(temp.entry_, nullptr))
+  {
+
+  }
+ ~pixel_format           ()
+  {
+    if (entry_)
+      pixel_format_cache::release(entry_);
+  }
+  pixel_format& operator=(const pixel_format&  that) noexcept
+  {
+    if (this != &that)
+    {
+      pixel_format copy(that);
+      std::swap(entry_, copy.entry_);
+    }
+    return *this;
+  }
+  pixel_format& operator=(      pixel_format&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      if (entry_)
+        pixel_format_cache::release(entry_);
+      entry_ = std::exchange(temp.entry_, nullptr);
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  std::uint32_t               format         () const
+  {
+    return entry_->native->format;
+  }
+  [[nodiscard]]
+  std::uint32_t               bits_per_pixel () const
+  {
+    return entry_->native->BitsPerPixel;
+  }
+  [[nodiscard]]
+  std::uint32_t               bytes_per_pixel() const
+  {
+    return entry_->native->BytesPerPixel;
+  }
+  [[nodiscard]]
+  std::size_t                 use_count      () const noexcept
+  {
+    return entry_ ? entry_->references.load(std::memory_order_relaxed) : 0;
+  }
+
+  [[nodiscard]]
+  std::uint32_t               map_rgb        (const std::array<std::uint8_t, 3>& color) const
+  {
+    return SDL_MapRGB (entry_->native, color[0], color[1], color[2]);
+  }
+  [[nodiscard]]
+  std::uint32_t               map_rgba       (const std::array<std::uint8_t, 4>& color) const
+  {
+    return SDL_MapRGBA(entry_->native, color[0], color[1], color[2], color[3]);
+  }
+  [[nodiscard]]
+  std::array<std::uint8_t, 3> get_rgb        (const std::uint32_t pixel) const
+  {
+    return sdl::get_rgb (entry_->native, pixel);
+  }
+  [[nodiscard]]
+  std::array<std::uint8_t, 4> get_rgba       (const std::uint32_t pixel) const
+  {
+    return sdl::get_rgba(entry_->native, pixel);
+  }
+
+  [[nodiscard]]
+  const native_pixel_format*  native         () const noexcept
+  {
+    return entry_ ? entry_->native : nullptr;
+  }
+
+private:
+  pixel_format_cache::entry*  entry_         {};
+};
+
+[[nodiscard]]
+inline std::expected<pixel_format, std::string> make_pixel_format(const std::uint32_t format)
+{
+  pixel_format result(format);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
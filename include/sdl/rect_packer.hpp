@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <sdl/rect.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a MaxRects packer which places rectangles into a fixed area and
+// supports removing them again, e.g. for texture atlases of glyph and icon caches.
+
+// Each free rectangle is a maximal empty area of the bin, hence the free rectangles may overlap. A rectangle is placed at
+// the free rectangle which leaves the shortest remaining side ("best short side fit"), and the free rectangles it
+// intersects are split around it. Removed rectangles are returned to the free rectangles, and merged with the ones they
+// share a full edge with. The bin is reset once it is empty, so that fragmentation does not accumulate.
+class rect_packer
+{
+public:
+  explicit rect_packer  (const std::array<std::int32_t, 2>& size)
+  : size_(size)
+  {
+    clear();
+  }
+  rect_packer           (const rect_packer&  that) = default;
+  rect_packer           (      rect_packer&& temp) = default;
+ ~rect_packer           ()                         = default;
+  rect_packer& operator=(const rect_packer&  that) = default;
+  rect_packer& operator=(      rect_packer&& temp) = default;
+
+  // Returns the placement of the rectangle, or nothing if it does not fit.
+  [[nodiscard]]
+  std::optional<rectangle<std::int32_t>>      insert          (const std::array<std::int32_t, 2>& size)
+  {
+    if (size[0] <= 0 || size[1] <= 0)
+      return std::nullopt;
+
+    const rectangle<std::int32_t>* best            = nullptr;
+    auto                           best_short_side = std::numeric_limits<std::int32_t>::max();
+    auto                           best_long_side  = std::numeric_limits<std::int32_t>::max();
+    for (const auto& current : free_)
+    {
+      if (current.w < size[0] || current.h < size[1])
+        continue;
+
+      const auto short_side = std::min(current.w - size[0], current.h - size[1]);
+      const auto long_side  = std::max(current.w - size[0], current.h - size[1]);
+      if (short_side < best_short_side || (short_side == best_short_side && long_side < best_long_side))
+      {
+        best            = &current;
+        best_short_side = short_side;
+        best_long_side  = long_side;
+      }
+    }
+    if (!best)
+      return std::nullopt;
+
+    const rectangle<std::int32_t> result(best->x, best->y, size[0], size[1]);
+    prune(split(result));
+    used_area_ += static_cast<std::size_t>(size[0]) * static_cast<std::size_t>(size[1]);
+    ++count_;
+    return result;
+  }
+  // The rectangle must have been returned by `insert` and not been removed since.
+  void                                        erase           (const rectangle<std::int32_t>& rectangle)
+  {
+    used_area_ -= static_cast<std::size_t>(rectangle.w) * static_cast<std::size_t>(rectangle.h);
+    if (--count_ == 0)
+    {
+      clear();
+      return;
+    }
+
+    merge(rectangle);
+    prune(free_.size() - 1);
+  }
+  void                                        clear           ()
+  {
+    free_.assign(1, rectangle<std::int32_t>(0, 0, size_[0], size_[1]));
+    used_area_ = 0;
+    count_     = 0;
+  }
+
+  [[nodiscard]]
+  const std::array<std::int32_t, 2>&          size            () const noexcept
+  {
+    return size_;
+  }
+  // The number of placed rectangles.
+  [[nodiscard]]
+  std::size_t                                 count           () const noexcept
+  {
+    return count_;
+  }
+  [[nodiscard]]
+  std::size_t                                 used_area       () const noexcept
+  {
+    return used_area_;
+  }
+  // The ratio of the used area to the area of the bin.
+  [[nodiscard]]
+  double                                      occupancy       () const noexcept
+  {
+    return static_cast<double>(used_area_) / (static_cast<double>(size_[0]) * static_cast<double>(size_[1]));
+  }
+  [[nodiscard]]
+  std::span<const rectangle<std::int32_t>>    free_rectangles () const noexcept
+  {
+    return free_;
+  }
+
+private:
+  // Replaces each free rectangle intersecting the used rectangle with the (up to four) maximal areas around it, which are
+  // appended. Returns the index of the first appended one.
+  std::size_t split(const rectangle<std::int32_t>& used)
+  {
+    const auto count = free_.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const auto current = free_[i];
+      if (!current.intersects(used))
+        continue;
+
+      if (used.x > current.x)
+        free_.emplace_back(current.x, current.y, used.x - current.x, current.h);
+      if (used.x + used.w < current.x + current.w)
+        free_.emplace_back(used.x + used.w, current.y, current.x + current.w - used.x - used.w, current.h);
+      if (used.y > current.y)
+        free_.emplace_back(current.x, current.y, current.w, used.y - current.y);
+      if (used.y + used.h < current.y + current.h)
+        free_.emplace_back(current.x, used.y + used.h, current.w, current.y + current.h - used.y - used.h);
+
+      free_[i].w = 0; // Marked for removal.
+    }
+    const auto removed = std::erase_if(free_, [ ] (const rectangle<std::int32_t>& rectangle) { return rectangle.w == 0; });
+    return count - removed;
+  }
+  // Merges the removed rectangle with the free rectangles it shares a full edge with, until none remain.
+  void merge(rectangle<std::int32_t> removed)
+  {
+    const auto try_merge = [ ] (rectangle<std::int32_t>& target, const rectangle<std::int32_t>& other)
+    {
+      if      (target.x == other.x && target.w == other.w && other.y <= target.y + target.h && target.y <= other.y + other.h)
+      {
+        const auto bottom = std::max(target.y + target.h, other.y + other.h);
+        target.y = std::min(target.y, other.y);
+        target.h = bottom - target.y;
+        return true;
+      }
+      else if (target.y == other.y && target.h == other.h && other.x <= target.x + target.w && target.x <= other.x + other.w)
+      {
+        const auto right  = std::max(target.x + target.w, other.x + other.w);
+        target.x = std::min(target.x, other.x);
+        target.w = right - target.x;
+        return true;
+      }
+      return false;
+    };
+
+    for (auto merged = true; merged; )
+    {
+      merged = false;
+      for (auto iterator = free_.begin(); iterator != free_.end(); ++iterator)
+        if (try_merge(removed, *iterator))
+        {
+          free_.erase(iterator);
+          merged = true;
+          break;
+        }
+    }
+    free_.push_back(removed);
+  }
+  // Removes the free rectangles contained in others. Only the ones from the first index on are new; the others do not
+  // contain each other, hence comparing the new ones to all suffices (rather than comparing all pairs).
+  void prune(const std::size_t first)
+  {
+    const auto contains = [ ] (const rectangle<std::int32_t>& outer, const rectangle<std::int32_t>& inner)
+    {
+      return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.w <= outer.x + outer.w && inner.y + inner.h <= outer.y + outer.h;
+    };
+
+    for (std::size_t i = first; i < free_.size(); ++i)
+    {
+      if (free_[i].w == 0)
+        continue;
+      for (std::size_t j = 0; j < free_.size(); ++j)
+      {
+        if (j == i || free_[j].w == 0)
+          continue;
+        if (contains(free_[j], free_[i]))
+        {
+          free_[i].w = 0; // Marked for removal.
+          break;
+        }
+        if (contains(free_[i], free_[j]))
+          free_[j].w = 0;
+      }
+    }
+    std::erase_if(free_, [ ] (const rectangle<std::int32_t>& rectangle) { return rectangle.w == 0; });
+  }
+
+  std::array<std::int32_t, 2>          size_      ;
+  std::vector<rectangle<std::int32_t>> free_      {};
+  std::size_t                          used_area_ {};
+  std::size_t                          count_     {};
+};
+}
\ No newline at end of file
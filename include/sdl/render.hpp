@@ -0,0 +1,816 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <SDL_render.h>
+
+#include <sdl/bitset_enum.hpp>
+#include <sdl/blend_mode.hpp>
+#include <sdl/error.hpp>
+#include <sdl/rect.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/video.hpp>
+
+namespace sdl
+{
+using native_renderer = SDL_Renderer    ;
+using native_texture  = SDL_Texture     ;
+using native_vertex   = SDL_Vertex      ;
+using renderer_info   = SDL_RendererInfo;
+
+enum class renderer_flags : std::uint32_t
+{
+  none           = 0                         ,
+  software       = SDL_RENDERER_SOFTWARE     ,
+  accelerated    = SDL_RENDERER_ACCELERATED  ,
+  present_vsync  = SDL_RENDERER_PRESENTVSYNC ,
+  target_texture = SDL_RENDERER_TARGETTEXTURE
+};
+enum class renderer_flip  : std::uint32_t
+{
+  none           = SDL_FLIP_NONE             ,
+  horizontal     = SDL_FLIP_HORIZONTAL       ,
+  vertical       = SDL_FLIP_VERTICAL
+};
+enum class texture_access
+{
+  static_        = SDL_TEXTUREACCESS_STATIC   ,
+  streaming      = SDL_TEXTUREACCESS_STREAMING,
+  target         = SDL_TEXTUREACCESS_TARGET
+};
+enum class scale_mode
+{
+  nearest        = SDL_ScaleModeNearest      ,
+  linear         = SDL_ScaleModeLinear       ,
+  best           = SDL_ScaleModeBest
+};
+
+template <>
+struct is_bitset_enum<renderer_flags> : std::true_type {};
+template <>
+struct is_bitset_enum<renderer_flip>  : std::true_type {};
+
+struct texture_info
+{
+  std::uint32_t               format;
+  texture_access              access;
+  std::array<std::int32_t, 2> size  ;
+};
+struct texture_lock
+{
+  void*                       pixels;
+  std::int32_t                pitch ;
+};
+
+[[nodiscard]]
+inline std::int32_t                                            get_num_render_drivers      ()
+{
+  return SDL_GetNumRenderDrivers();
+}
+[[nodiscard]]
+inline std::expected<renderer_info              , std::string> get_render_driver_info      (const std::int32_t index)
+{
+  renderer_info result;
+  if (SDL_GetRenderDriverInfo(index, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+
+// Bad practice: You should use `sdl::renderer` instead. The index -1 selects the first driver supporting the flags.
+[[nodiscard]]
+inline std::expected<native_renderer*           , std::string> create_renderer             (native_window* window, const std::int32_t index = -1, const renderer_flags flags = renderer_flags::none)
+{
+  auto result = SDL_CreateRenderer(window, index, static_cast<std::uint32_t>(flags));
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+// Bad practice: You should use `sdl::renderer` instead. The software renderer draws to the surface without a window.
+[[nodiscard]]
+inline std::expected<native_renderer*           , std::string> create_software_renderer    (native_surface* surface)
+{
+  auto result = SDL_CreateSoftwareRenderer(surface);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+// Bad practice: You should use `sdl::renderer` instead. Destroys the textures of the renderer as well.
+inline void                                                    destroy_renderer            (native_renderer* renderer)
+{
+  SDL_DestroyRenderer(renderer);
+}
+[[nodiscard]]
+inline std::expected<native_renderer*           , std::string> get_renderer                (native_window* window)
+{
+  auto result = SDL_GetRenderer(window);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<renderer_info              , std::string> get_renderer_info           (native_renderer* renderer)
+{
+  renderer_info result;
+  if (SDL_GetRendererInfo(renderer, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<std::array<std::int32_t, 2>, std::string> get_renderer_output_size    (native_renderer* renderer)
+{
+  std::array<std::int32_t, 2> result;
+  if (SDL_GetRendererOutputSize(renderer, &result[0], &result[1]) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+
+// Bad practice: You should use `sdl::texture` instead.
+[[nodiscard]]
+inline std::expected<native_texture*            , std::string> create_texture              (native_renderer* renderer, const std::uint32_t format, const texture_access access, const std::array<std::int32_t, 2>& size)
+{
+  auto result = SDL_CreateTexture(renderer, format, static_cast<std::int32_t>(access), size[0], size[1]);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+// Bad practice: You should use `sdl::texture` instead.
+[[nodiscard]]
+inline std::expected<native_texture*            , std::string> create_texture_from_surface (native_renderer* renderer, native_surface* surface)
+{
+  auto result = SDL_CreateTextureFromSurface(renderer, surface);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+// Bad practice: You should use `sdl::texture` instead.
+inline void                                                    destroy_texture             (native_texture* texture)
+{
+  SDL_DestroyTexture(texture);
+}
+[[nodiscard]]
+inline std::expected<texture_info               , std::string> query_texture               (native_texture* texture)
+{
+  texture_info result;
+  std::int32_t access;
+  if (SDL_QueryTexture(texture, &result.format, &access, &result.size[0], &result.size[1]) < 0)
+    return std::unexpected(get_error());
+  result.access = static_cast<texture_access>(access);
+  return result;
+}
+
+inline std::expected<void                       , std::string> set_texture_color_mod       (native_texture* texture, const std::array<std::uint8_t, 3>& color)
+{
+  if (SDL_SetTextureColorMod(texture, color[0], color[1], color[2]) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<std::array<std::uint8_t, 3>, std::string> get_texture_color_mod       (native_texture* texture)
+{
+  std::array<std::uint8_t, 3> result;
+  if (SDL_GetTextureColorMod(texture, &result[0], &result[1], &result[2]) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void                       , std::string> set_texture_alpha_mod       (native_texture* texture, const std::uint8_t alpha)
+{
+  if (SDL_SetTextureAlphaMod(texture, alpha) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<std::uint8_t               , std::string> get_texture_alpha_mod       (native_texture* texture)
+{
+  std::uint8_t result;
+  if (SDL_GetTextureAlphaMod(texture, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void                       , std::string> set_texture_blend_mode      (native_texture* texture, const blend_mode mode)
+{
+  if (SDL_SetTextureBlendMode(texture, static_cast<SDL_BlendMode>(mode)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<blend_mode                 , std::string> get_texture_blend_mode      (native_texture* texture)
+{
+  SDL_BlendMode result;
+  if (SDL_GetTextureBlendMode(texture, &result) < 0)
+    return std::unexpected(get_error());
+  return static_cast<blend_mode>(result);
+}
+inline std::expected<void                       , std::string> set_texture_scale_mode      (native_texture* texture, const scale_mode mode)
+{
+  if (SDL_SetTextureScaleMode(texture, static_cast<SDL_ScaleMode>(mode)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<scale_mode                 , std::string> get_texture_scale_mode      (native_texture* texture)
+{
+  SDL_ScaleMode result;
+  if (SDL_GetTextureScaleMode(texture, &result) < 0)
+    return std::unexpected(get_error());
+  return static_cast<scale_mode>(result);
+}
+
+// Updates the rectangle (or the whole texture) from pixels in the format of the texture. This is a fairly slow function,
+// intended for static textures. You should lock streaming textures instead.
+inline std::expected<void                       , std::string> update_texture              (native_texture* texture, const std::optional<native_rect>& rectangle, const void* pixels, const std::int32_t pitch)
+{
+  if (SDL_UpdateTexture(texture, rectangle ? &rectangle.value() : nullptr, pixels, pitch) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// The texture must be streaming. The pixels are write-only and their previous contents are undefined.
+[[nodiscard]]
+inline std::expected<texture_lock               , std::string> lock_texture                (native_texture* texture, const std::optional<native_rect>& rectangle = std::nullopt)
+{
+  texture_lock result;
+  if (SDL_LockTexture(texture, rectangle ? &rectangle.value() : nullptr, &result.pixels, &result.pitch) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+// The surface is owned by the texture and is freed by `sdl::unlock_texture`.
+[[nodiscard]]
+inline std::expected<native_surface*            , std::string> lock_texture_to_surface     (native_texture* texture, const std::optional<native_rect>& rectangle = std::nullopt)
+{
+  native_surface* result;
+  if (SDL_LockTextureToSurface(texture, rectangle ? &rectangle.value() : nullptr, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+inline void                                                    unlock_texture              (native_texture* texture)
+{
+  SDL_UnlockTexture(texture);
+}
+
+[[nodiscard]]
+inline bool                                                    render_target_supported     (native_renderer* renderer)
+{
+  return SDL_RenderTargetSupported(renderer) == SDL_TRUE;
+}
+// The texture must have been created with `sdl::texture_access::target`. Resets to the default target if none is given.
+inline std::expected<void                       , std::string> set_render_target           (native_renderer* renderer, native_texture* texture = nullptr)
+{
+  if (SDL_SetRenderTarget(renderer, texture) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline native_texture*                                         get_render_target           (native_renderer* renderer)
+{
+  return SDL_GetRenderTarget(renderer);
+}
+// Resets to the whole target if no rectangle is given.
+inline std::expected<void                       , std::string> render_set_viewport         (native_renderer* renderer, const std::optional<native_rect>& rectangle = std::nullopt)
+{
+  if (SDL_RenderSetViewport(renderer, rectangle ? &rectangle.value() : nullptr) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline native_rect                                             render_get_viewport         (native_renderer* renderer)
+{
+  native_rect result;
+  SDL_RenderGetViewport(renderer, &result);
+  return result;
+}
+// The rectangle is relative to the viewport. Disables clipping if no rectangle is given.
+inline std::expected<void                       , std::string> render_set_clip_rect        (native_renderer* renderer, const std::optional<native_rect>& rectangle = std::nullopt)
+{
+  if (SDL_RenderSetClipRect(renderer, rectangle ? &rectangle.value() : nullptr) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::optional<native_rect>                              render_get_clip_rect        (native_renderer* renderer)
+{
+  if (SDL_RenderIsClipEnabled(renderer) == SDL_FALSE)
+    return std::nullopt;
+  native_rect result;
+  SDL_RenderGetClipRect(renderer, &result);
+  return result;
+}
+inline std::expected<void                       , std::string> render_set_scale            (native_renderer* renderer, const std::array<float, 2>& scale)
+{
+  if (SDL_RenderSetScale(renderer, scale[0], scale[1]) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::array<float, 2>                                    render_get_scale            (native_renderer* renderer)
+{
+  std::array<float, 2> result;
+  SDL_RenderGetScale(renderer, &result[0], &result[1]);
+  return result;
+}
+inline std::expected<void                       , std::string> set_render_draw_color       (native_renderer* renderer, const std::array<std::uint8_t, 4>& color)
+{
+  if (SDL_SetRenderDrawColor(renderer, color[0], color[1], color[2], color[3]) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<std::array<std::uint8_t, 4>, std::string> get_render_draw_color       (native_renderer* renderer)
+{
+  std::array<std::uint8_t, 4> result;
+  if (SDL_GetRenderDrawColor(renderer, &result[0], &result[1], &result[2], &result[3]) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void                       , std::string> set_render_draw_blend_mode  (native_renderer* renderer, const blend_mode mode)
+{
+  if (SDL_SetRenderDrawBlendMode(renderer, static_cast<SDL_BlendMode>(mode)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<blend_mode                 , std::string> get_render_draw_blend_mode  (native_renderer* renderer)
+{
+  SDL_BlendMode result;
+  if (SDL_GetRenderDrawBlendMode(renderer, &result) < 0)
+    return std::unexpected(get_error());
+  return static_cast<blend_mode>(result);
+}
+
+// Clears the whole target with the draw color, ignoring the viewport and the clip rectangle.
+inline std::expected<void                       , std::string> render_clear                (native_renderer* renderer)
+{
+  if (SDL_RenderClear(renderer) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                       , std::string> render_draw_points          (native_renderer* renderer, const std::span<const native_point>& points)
+{
+  if (SDL_RenderDrawPoints(renderer, points.data(), static_cast<std::int32_t>(points.size())) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// Draws a connected series of lines between the points.
+inline std::expected<void                       , std::string> render_draw_lines           (native_renderer* renderer, const std::span<const native_point>& points)
+{
+  if (SDL_RenderDrawLines(renderer, points.data(), static_cast<std::int32_t>(points.size())) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                       , std::string> render_draw_rects           (native_renderer* renderer, const std::span<const native_rect>& rectangles)
+{
+  if (SDL_RenderDrawRects(renderer, rectangles.data(), static_cast<std::int32_t>(rectangles.size())) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// Fills the whole viewport if no rectangle is given.
+inline std::expected<void                       , std::string> render_fill_rect            (native_renderer* renderer, const std::optional<native_rect>& rectangle = std::nullopt)
+{
+  if (SDL_RenderFillRect(renderer, rectangle ? &rectangle.value() : nullptr) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                       , std::string> render_fill_rects           (native_renderer* renderer, const std::span<const native_rect>& rectangles)
+{
+  if (SDL_RenderFillRects(renderer, rectangles.data(), static_cast<std::int32_t>(rectangles.size())) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
+// Copies the source rectangle (or the whole texture) to the destination rectangle (or the whole viewport).
+inline std::expected<void                       , std::string> render_copy                 (native_renderer* renderer, native_texture* texture, const std::optional<native_rect>&  source_rectangle = std::nullopt, const std::optional<native_rect>&  destination_rectangle = std::nullopt)
+{
+  if (SDL_RenderCopy   (renderer, texture, source_rectangle ? &source_rectangle.value() : nullptr, destination_rectangle ? &destination_rectangle.value() : nullptr) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// The angle is in degrees, clockwise around the center (or the center of the destination rectangle).
+inline std::expected<void                       , std::string> render_copy_ex              (native_renderer* renderer, native_texture* texture, const std::optional<native_rect>&  source_rectangle, const std::optional<native_rect>&  destination_rectangle, const double angle, const std::optional<native_point>&  center = std::nullopt, const renderer_flip flip = renderer_flip::none)
+{
+  if (SDL_RenderCopyEx (renderer, texture, source_rectangle ? &source_rectangle.value() : nullptr, destination_rectangle ? &destination_rectangle.value() : nullptr, angle, center ? &center.value() : nullptr, static_cast<SDL_RendererFlip>(flip)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                       , std::string> render_copy_f               (native_renderer* renderer, native_texture* texture, const std::optional<native_rect>&  source_rectangle = std::nullopt, const std::optional<native_frect>& destination_rectangle = std::nullopt)
+{
+  if (SDL_RenderCopyF  (renderer, texture, source_rectangle ? &source_rectangle.value() : nullptr, destination_rectangle ? &destination_rectangle.value() : nullptr) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                       , std::string> render_copy_ex_f            (native_renderer* renderer, native_texture* texture, const std::optional<native_rect>&  source_rectangle, const std::optional<native_frect>& destination_rectangle, const double angle, const std::optional<native_fpoint>& center = std::nullopt, const renderer_flip flip = renderer_flip::none)
+{
+  if (SDL_RenderCopyExF(renderer, texture, source_rectangle ? &source_rectangle.value() : nullptr, destination_rectangle ? &destination_rectangle.value() : nullptr, angle, center ? &center.value() : nullptr, static_cast<SDL_RendererFlip>(flip)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// Renders the triangles of the vertices, as indexed by the indices or in order if there are none. The texture coordinates
+// are normalized. Untextured triangles are blended with the draw blend mode, textured ones with the blend mode of the
+// texture. See `sdl::sprite_batch` for submitting many sprites at once.
+inline std::expected<void                       , std::string> render_geometry             (native_renderer* renderer, native_texture* texture, const std::span<const native_vertex>& vertices, const std::span<const std::int32_t>& indices = {})
+{
+  if (SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<std::int32_t>(vertices.size()), indices.empty() ? nullptr : indices.data(), static_cast<std::int32_t>(indices.size())) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
+// Reads the rectangle (or the whole viewport) into the pixels in the format (or the format of the target if 0). This is
+// a very slow function, not intended for use in every frame.
+inline std::expected<void                       , std::string> render_read_pixels          (native_renderer* renderer, const std::optional<native_rect>& rectangle, const std::uint32_t format, void* pixels, const std::int32_t pitch)
+{
+  if (SDL_RenderReadPixels(renderer, rectangle ? &rectangle.value() : nullptr, format, pixels, pitch) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline void                                                    render_present              (native_renderer* renderer)
+{
+  SDL_RenderPresent(renderer);
+}
+// Submits the queued commands. Only necessary when mixing the renderer with direct calls to the underlying graphics API.
+inline std::expected<void                       , std::string> render_flush                (native_renderer* renderer)
+{
+  if (SDL_RenderFlush(renderer) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                       , std::string> render_set_vsync            (native_renderer* renderer, const bool enabled)
+{
+  if (SDL_RenderSetVSync(renderer, static_cast<std::int32_t>(enabled)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
+// Conveniences.
+
+class renderer;
+
+class texture
+{
+public:
+  // The constructor cannot transmit error state. You should use `sdl::make_texture(...)` to handle errors.
+  texture           (const renderer& renderer, const std::array<std::int32_t, 2>& size, const std::uint32_t format = SDL_PIXELFORMAT_ARGB8888, const texture_access access = texture_access::static_);
+  // The constructor cannot transmit error state. You should use `sdl::make_texture(...)` to handle errors.
+  texture           (const renderer& renderer, const surface& surface);
+  // Takes ownership of the native texture if managed, otherwise only references it.
+  explicit texture  (native_texture* native, const bool managed = true)
+  : native_(native), managed_(managed)
+  {
+
+  }
+  texture           (const texture&  that) = delete;
+  texture           (      texture&& temp) noexcept
+  : native_ (std::exchange(temp.native_ , nullptr))
+  , managed_(std::exchange(temp.managed_, false  ))
+  {
+
+  }
+  // The texture must be destroyed before its renderer, which destroys its textures as well.
+ ~texture           ()
+  {
+    destroy();
+  }
+  texture& operator=(const texture&  that) = delete;
+  texture& operator=(      texture&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      destroy();
+
+      native_  = std::exchange(temp.native_ , nullptr);
+      managed_ = std::exchange(temp.managed_, false  );
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  std::expected<texture_info               , std::string> info          () const
+  {
+    return query_texture(native_);
+  }
+  [[nodiscard]]
+  std::array<std::int32_t, 2>                             size          () const
+  {
+    const auto result = query_texture(native_);
+    return result ? result->size : std::array<std::int32_t, 2> {};
+  }
+
+  // Updates the rectangle (or the whole texture) from the pixels of the surface, which must have the format of the
+  // texture.
+  std::expected<void                       , std::string> update        (const surface& surface, const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    if (auto result = surface.lock(); !result)
+      return result;
+    auto result = update_texture(native_, rectangle, surface.native()->pixels, surface.pitch());
+    surface.unlock();
+    return result;
+  }
+  std::expected<void                       , std::string> update        (const void* pixels, const std::int32_t pitch, const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    return update_texture(native_, rectangle, pixels, pitch);
+  }
+  [[nodiscard]]
+  std::expected<texture_lock               , std::string> lock          (const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    return lock_texture(native_, rectangle);
+  }
+  // The surface references the pixels of the texture until `unlock()`.
+  [[nodiscard]]
+  std::expected<surface                    , std::string> lock_surface  (const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    const auto result = lock_texture_to_surface(native_, rectangle);
+    if (!result)
+      return std::unexpected(result.error());
+    return surface(result.value(), false);
+  }
+  void                                                    unlock        () const
+  {
+    unlock_texture(native_);
+  }
+
+  std::expected<void                       , std::string> set_color_mod (const std::array<std::uint8_t, 3>& color) const
+  {
+    return set_texture_color_mod(native_, color);
+  }
+  [[nodiscard]]
+  std::expected<std::array<std::uint8_t, 3>, std::string> color_mod     () const
+  {
+    return get_texture_color_mod(native_);
+  }
+  std::expected<void                       , std::string> set_alpha_mod (const std::uint8_t alpha) const
+  {
+    return set_texture_alpha_mod(native_, alpha);
+  }
+  [[nodiscard]]
+  std::expected<std::uint8_t               , std::string> alpha_mod     () const
+  {
+    return get_texture_alpha_mod(native_);
+  }
+  std::expected<void                       , std::string> set_blend_mode(const sdl::blend_mode mode) const
+  {
+    return set_texture_blend_mode(native_, mode);
+  }
+  [[nodiscard]]
+  std::expected<sdl::blend_mode            , std::string> blend_mode    () const
+  {
+    return get_texture_blend_mode(native_);
+  }
+  std::expected<void                       , std::string> set_scale_mode(const sdl::scale_mode mode) const
+  {
+    return set_texture_scale_mode(native_, mode);
+  }
+  [[nodiscard]]
+  std::expected<sdl::scale_mode            , std::string> scale_mode    () const
+  {
+    return get_texture_scale_mode(native_);
+  }
+
+  [[nodiscard]]
+  native_texture*                                         native        () const
+  {
+    return native_;
+  }
+
+private:
+  void destroy()
+  {
+    if (native_ && managed_)
+      destroy_texture(native_);
+    native_ = nullptr;
+  }
+
+  native_texture* native_  {};
+  bool            managed_ {true};
+};
+
+class renderer
+{
+public:
+  // The constructor cannot transmit error state. You should use `sdl::make_renderer(...)` to handle errors.
+  explicit renderer  (const window& window, const renderer_flags flags = renderer_flags::none, const std::int32_t index = -1)
+  : native_(create_renderer(window.native(), index, flags).value_or(nullptr))
+  {
+
+  }
+  // Creates a software renderer drawing to the surface, which must outlive the renderer. Works without a video driver.
+  // The constructor cannot transmit error state. You should use `sdl::make_renderer(...)` to handle errors.
+  explicit renderer  (const surface& target)
+  : native_(create_software_renderer(target.native()).value_or(nullptr))
+  {
+
+  }
+  // Takes ownership of the native renderer if managed, otherwise only references it.
+  explicit renderer  (native_renderer* native, const bool managed = true)
+  : native_(native), managed_(managed)
+  {
+
+  }
+  renderer           (const renderer&  that) = delete;
+  renderer           (      renderer&& temp) noexcept
+  : native_ (std::exchange(temp.native_ , nullptr))
+  , managed_(std::exchange(temp.managed_, false  ))
+  {
+
+  }
+ ~renderer           ()
+  {
+    destroy();
+  }
+  renderer& operator=(const renderer&  that) = delete;
+  renderer& operator=(      renderer&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      destroy();
+
+      native_  = std::exchange(temp.native_ , nullptr);
+      managed_ = std::exchange(temp.managed_, false  );
+    }
+    return *this;
+  }
+
+  [[nodiscard]]
+  std::expected<renderer_info              , std::string> info          () const
+  {
+    return get_renderer_info(native_);
+  }
+  [[nodiscard]]
+  std::expected<std::array<std::int32_t, 2>, std::string> output_size   () const
+  {
+    return get_renderer_output_size(native_);
+  }
+
+  // Renders to the texture, or to the default target if none is given.
+  std::expected<void                       , std::string> set_target    (const texture* target = nullptr) const
+  {
+    return set_render_target(native_, target ? target->native() : nullptr);
+  }
+  std::expected<void                       , std::string> set_viewport  (const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    return render_set_viewport(native_, rectangle);
+  }
+  [[nodiscard]]
+  native_rect                                             viewport      () const
+  {
+    return render_get_viewport(native_);
+  }
+  std::expected<void                       , std::string> set_clip_rect (const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    return render_set_clip_rect(native_, rectangle);
+  }
+  [[nodiscard]]
+  std::optional<native_rect>                              clip_rect     () const
+  {
+    return render_get_clip_rect(native_);
+  }
+  std::expected<void                       , std::string> set_scale     (const std::array<float, 2>& scale) const
+  {
+    return render_set_scale(native_, scale);
+  }
+  [[nodiscard]]
+  std::array<float, 2>                                    scale         () const
+  {
+    return render_get_scale(native_);
+  }
+  std::expected<void                       , std::string> set_draw_color(const std::array<std::uint8_t, 4>& color) const
+  {
+    return set_render_draw_color(native_, color);
+  }
+  [[nodiscard]]
+  std::expected<std::array<std::uint8_t, 4>, std::string> draw_color    () const
+  {
+    return get_render_draw_color(native_);
+  }
+  std::expected<void                       , std::string> set_blend_mode(const sdl::blend_mode mode) const
+  {
+    return set_render_draw_blend_mode(native_, mode);
+  }
+  [[nodiscard]]
+  std::expected<sdl::blend_mode            , std::string> blend_mode    () const
+  {
+    return get_render_draw_blend_mode(native_);
+  }
+
+  std::expected<void                       , std::string> clear         () const
+  {
+    return render_clear(native_);
+  }
+  std::expected<void                       , std::string> draw_points   (const std::span<const native_point>& points    ) const
+  {
+    return render_draw_points(native_, points);
+  }
+  std::expected<void                       , std::string> draw_lines    (const std::span<const native_point>& points    ) const
+  {
+    return render_draw_lines (native_, points);
+  }
+  std::expected<void                       , std::string> draw_rects    (const std::span<const native_rect>&  rectangles) const
+  {
+    return render_draw_rects (native_, rectangles);
+  }
+  std::expected<void                       , std::string> fill_rect     (const std::optional<native_rect>&    rectangle = std::nullopt) const
+  {
+    return render_fill_rect  (native_, rectangle );
+  }
+  std::expected<void                       , std::string> fill_rects    (const std::span<const native_rect>&  rectangles) const
+  {
+    return render_fill_rects (native_, rectangles);
+  }
+
+  // Copies the source rectangle (or the whole texture) to the destination rectangle (or the whole viewport).
+  std::expected<void                       , std::string> copy          (const texture& texture, const std::optional<native_frect>& destination_rectangle = std::nullopt, const std::optional<native_rect>& source_rectangle = std::nullopt) const
+  {
+    return render_copy_f   (native_, texture.native(), source_rectangle, destination_rectangle);
+  }
+  // The angle is in degrees, clockwise around the center of the destination rectangle.
+  std::expected<void                       , std::string> copy          (const texture& texture, const std::optional<native_frect>& destination_rectangle, const std::optional<native_rect>& source_rectangle, const double angle, const renderer_flip flip = renderer_flip::none) const
+  {
+    return render_copy_ex_f(native_, texture.native(), source_rectangle, destination_rectangle, angle, std::nullopt, flip);
+  }
+  std::expected<void                       , std::string> geometry      (const texture* texture, const std::span<const native_vertex>& vertices, const std::span<const std::int32_t>& indices = {}) const
+  {
+    return render_geometry (native_, texture ? texture->native() : nullptr, vertices, indices);
+  }
+
+  std::expected<void                       , std::string> read_pixels   (const surface& target, const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    return render_read_pixels(native_, rectangle, target.format(), target.native()->pixels, target.pitch());
+  }
+  void                                                    present       () const
+  {
+    render_present(native_);
+  }
+  std::expected<void                       , std::string> flush         () const
+  {
+    return render_flush(native_);
+  }
+  std::expected<void                       , std::string> set_vsync     (const bool enabled) const
+  {
+    return render_set_vsync(native_, enabled);
+  }
+
+  [[nodiscard]]
+  native_renderer*                                        native        () const
+  {
+    return native_;
+  }
+
+private:
+  void destroy()
+  {
+    if (native_ && managed_)
+      destroy_renderer(native_);
+    native_ = nullptr;
+  }
+
+  native_renderer* native_  {};
+  bool             managed_ {true};
+};
+
+inline texture::texture(const renderer& renderer, const std::array<std::int32_t, 2>& size, const std::uint32_t format, const texture_access access)
+: native_(create_texture(renderer.native(), format, access, size).value_or(nullptr))
+{
+
+}
+inline texture::texture(const renderer& renderer, const surface& surface)
+: native_(create_texture_from_surface(renderer.native(), surface.native()).value_or(nullptr))
+{
+
+}
+
+[[nodiscard]]
+inline std::expected<renderer, std::string> make_renderer(const window&  window, const renderer_flags flags = renderer_flags::none, const std::int32_t index = -1)
+{
+  renderer result(window, flags, index);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<renderer, std::string> make_renderer(const surface& target)
+{
+  renderer result(target);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+
+[[nodiscard]]
+inline std::expected<texture , std::string> make_texture (const renderer& renderer, const std::array<std::int32_t, 2>& size, const std::uint32_t format = SDL_PIXELFORMAT_ARGB8888, const texture_access access = texture_access::static_)
+{
+  texture result(renderer, size, format, access);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<texture , std::string> make_texture (const renderer& renderer, const surface& surface)
+{
+  texture result(renderer, surface);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
@@ -1,17 +1,30 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <expected>
+#include <memory>
 #include <span>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <cerrno>
+#include <climits>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 #include <SDL_rwops.h>
 
+#include <sdl/endian.hpp>
 #include <sdl/error.hpp>
 
 namespace sdl
@@ -299,30 +312,358 @@ std::expected<native_rw_ops*                  , std::string> rw_from_const_mem(c
 {
   return sdl::rw_from_const_mem(std::as_bytes         (memory));
 }
+// Typed reads transfer the whole span at once and return the number of complete elements read. The stream is moved
+// back to the end of the last complete element on a short read where possible, hence the next read stays aligned.
 // Bad practice: You should use `std::fstream` instead.
-template <typename type>      [[nodiscard]]
+template <typename type> requires std::is_trivially_copyable_v<type> [[nodiscard]]
 std::expected<std::size_t                     , std::string> rw_read_as       (native_rw_ops* ops, const std::span<      type>& buffer)
 {
-  return rw_read (ops, buffer.data(), sizeof(type), buffer.size());
+  if (buffer.empty())
+    return 0;
+
+  const auto bytes = SDL_RWread(ops, buffer.data(), 1, buffer.size_bytes());
+  if (const auto partial = bytes % sizeof(type))
+    SDL_RWseek(ops, -static_cast<std::int64_t>(partial), RW_SEEK_CUR); // Non-seekable streams lose the partial element.
+  if (bytes < sizeof(type))
+    return std::unexpected(get_error());
+  return bytes / sizeof(type);
 }
 // Bad practice: You should use `std::fstream` instead.
-template <typename type>      [[nodiscard]]
+template <typename type> requires std::is_trivially_copyable_v<type>
 std::expected<std::size_t                     , std::string> rw_write_as      (native_rw_ops* ops, const std::span<const type>& buffer)
 {
+  if (buffer.empty())
+    return 0;
   return rw_write(ops, buffer.data(), sizeof(type), buffer.size());
 }
+// Vectored (scatter/gather) I/O. Returns the number of bytes transferred, which is less than the total size of the
+// buffers for reads reaching the end of the stream. File sources use a single `preadv`/`pwritev` where available,
+// memory sources copy directly, and all other sources fall back to sequential reads and writes.
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<std::size_t              , std::string> rw_read_v        (native_rw_ops* ops, const std::span<const std::span<      std::byte>>& buffers)
+{
+  std::size_t total = 0;
+
+  if (ops->type == SDL_RWOPS_MEMORY || ops->type == SDL_RWOPS_MEMORY_RO)
+  {
+    for (const auto& buffer : buffers)
+    {
+      const auto size = std::min(buffer.size(), static_cast<std::size_t>(ops->hidden.mem.stop - ops->hidden.mem.here));
+      if (size > 0)
+        std::memcpy(buffer.data(), ops->hidden.mem.here, size);
+      ops->hidden.mem.here += size;
+      total                += size;
+      if (size < buffer.size())
+        break;
+    }
+    return total;
+  }
+
+#if !defined(_WIN32)
+  if (ops->type == SDL_RWOPS_STDFILE)
+  {
+    const auto position = SDL_RWtell(ops); // Accounts for the stdio buffer.
+    if (position < 0)
+      return std::unexpected(get_error());
+
+    std::vector<iovec> vectors;
+    vectors.reserve(buffers.size());
+    for (const auto& buffer : buffers)
+      if (!buffer.empty())
+        vectors.push_back(iovec {buffer.data(), buffer.size()});
+
+    const auto descriptor = fileno(ops->hidden.stdio.fp);
+    for (std::size_t index = 0; index < vectors.size();)
+    {
+      const auto result = ::preadv(descriptor, &vectors[index], static_cast<std::int32_t>(std::min<std::size_t>(vectors.size() - index, IOV_MAX)), static_cast<off_t>(position + static_cast<std::int64_t>(total)));
+      if (result < 0 && errno == EINTR)
+        continue;
+      if (result < 0)
+        return std::unexpected(std::string("preadv failed: ") + std::strerror(errno));
+      if (result == 0)
+        break;
+
+      total += static_cast<std::size_t>(result);
+      for (auto remaining = static_cast<std::size_t>(result); remaining > 0;)
+      {
+        auto& vector = vectors[index];
+        if (remaining >= vector.iov_len)
+        {
+          remaining -= vector.iov_len;
+          ++index;
+        }
+        else
+        {
+          vector.iov_base  = static_cast<std::byte*>(vector.iov_base) + remaining;
+          vector.iov_len  -= remaining;
+          remaining        = 0;
+        }
+      }
+    }
+
+    if (SDL_RWseek(ops, position + static_cast<std::int64_t>(total), RW_SEEK_SET) < 0) // Synchronizes the stdio position.
+      return std::unexpected(get_error());
+    return total;
+  }
+#endif
+
+  for (const auto& buffer : buffers)
+  {
+    const auto size = SDL_RWread(ops, buffer.data(), 1, buffer.size());
+    total += size;
+    if (size < buffer.size())
+      break;
+  }
+  return total;
+}
+// Bad practice: You should use `std::fstream` instead.
+inline std::expected<std::size_t              , std::string> rw_write_v       (native_rw_ops* ops, const std::span<const std::span<const std::byte>>& buffers)
+{
+  std::size_t total = 0;
+
+  if (ops->type == SDL_RWOPS_MEMORY_RO)
+    return std::unexpected(std::string("Can't write to read-only memory."));
+
+  if (ops->type == SDL_RWOPS_MEMORY)
+  {
+    for (const auto& buffer : buffers)
+    {
+      const auto size = std::min(buffer.size(), static_cast<std::size_t>(ops->hidden.mem.stop - ops->hidden.mem.here));
+      if (size > 0)
+        std::memcpy(ops->hidden.mem.here, buffer.data(), size);
+      ops->hidden.mem.here += size;
+      total                += size;
+      if (size < buffer.size())
+        return std::unexpected(std::string("Memory buffer is full."));
+    }
+    return total;
+  }
+
+#if !defined(_WIN32)
+  if (ops->type == SDL_RWOPS_STDFILE)
+  {
+    const auto position = SDL_RWtell(ops);
+    if (position < 0)
+      return std::unexpected(get_error());
+    if (std::fflush(ops->hidden.stdio.fp) != 0) // Pending stdio writes must precede the vectored write.
+      return std::unexpected(std::string("fflush failed: ") + std::strerror(errno));
+
+    std::vector<iovec> vectors;
+    vectors.reserve(buffers.size());
+    for (const auto& buffer : buffers)
+      if (!buffer.empty())
+        vectors.push_back(iovec {const_cast<std::byte*>(buffer.data()), buffer.size()});
+
+    const auto descriptor = fileno(ops->hidden.stdio.fp);
+    for (std::size_t index = 0; index < vectors.size();)
+    {
+      const auto result = ::pwritev(descriptor, &vectors[index], static_cast<std::int32_t>(std::min<std::size_t>(vectors.size() - index, IOV_MAX)), static_cast<off_t>(position + static_cast<std::int64_t>(total)));
+      if (result < 0 && errno == EINTR)
+        continue;
+      if (result <= 0)
+        return std::unexpected(std::string("pwritev failed: ") + std::strerror(errno));
+
+      total += static_cast<std::size_t>(result);
+      for (auto remaining = static_cast<std::size_t>(result); remaining > 0;)
+      {
+        auto& vector = vectors[index];
+        if (remaining >= vector.iov_len)
+        {
+          remaining -= vector.iov_len;
+          ++index;
+        }
+        else
+        {
+          vector.iov_base  = static_cast<std::byte*>(vector.iov_base) + remaining;
+          vector.iov_len  -= remaining;
+          remaining        = 0;
+        }
+      }
+    }
+
+    if (SDL_RWseek(ops, position + static_cast<std::int64_t>(total), RW_SEEK_SET) < 0)
+      return std::unexpected(get_error());
+    return total;
+  }
+#endif
+
+  for (const auto& buffer : buffers)
+  {
+    const auto size = SDL_RWwrite(ops, buffer.data(), 1, buffer.size());
+    total += size;
+    if (size < buffer.size())
+      return std::unexpected(get_error());
+  }
+  return total;
+}
+// The functions of the sources of native rw_ops created by `sdl::rw_from_source`, stored in their
+// `hidden.unknown.data2`. The positional functions are null if the source does not provide them.
+struct rw_source_functions
+{
+  std::int32_t                            (*close   )(native_rw_ops* context);
+  std::expected<std::size_t, std::string> (*read_at )(void* source, std::int64_t offset,       void* buffer, std::size_t size);
+  std::expected<std::size_t, std::string> (*write_at)(void* source, std::int64_t offset, const void* buffer, std::size_t size);
+};
+// The close function of all native rw_ops created by `sdl::rw_from_source`, which identifies them.
+inline std::int32_t               close_rw_source        (native_rw_ops* ops)
+{
+  return static_cast<const rw_source_functions*>(ops->hidden.unknown.data2)->close(ops);
+}
+// Returns null for native rw_ops not created by `sdl::rw_from_source`.
+[[nodiscard]]
+inline const rw_source_functions* get_rw_source_functions(native_rw_ops* ops)
+{
+  if (ops->type != SDL_RWOPS_UNKNOWN || ops->close != &close_rw_source)
+    return nullptr;
+  return static_cast<const rw_source_functions*>(ops->hidden.unknown.data2);
+}
+
+// Positional I/O. Transfers up to `size` bytes at the offset and returns the number of bytes transferred. File sources
+// use `pread`/`pwrite` where available, memory sources copy directly, and custom sources use their `read_at`/`write_at`
+// (e.g. mapped files and slices), none of which moves the position of the native rw_ops, hence disjoint ranges may be
+// accessed concurrently. All other sources seek first and are not thread-safe.
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<std::size_t              , std::string> rw_read_at       (native_rw_ops* ops, const std::int64_t offset,       void* buffer, const std::size_t size)
+{
+  if (offset < 0)
+    return std::unexpected(std::string("Negative offset."));
+  if (size == 0)
+    return 0;
+
+  if (const auto functions = get_rw_source_functions(ops); functions && functions->read_at)
+    return functions->read_at(ops->hidden.unknown.data1, offset, buffer, size);
+
+  if (ops->type == SDL_RWOPS_MEMORY || ops->type == SDL_RWOPS_MEMORY_RO)
+  {
+    const auto available = static_cast<std::size_t>(ops->hidden.mem.stop - ops->hidden.mem.base);
+    if (static_cast<std::size_t>(offset) >= available)
+      return 0;
+    const auto count = std::min(size, available - static_cast<std::size_t>(offset));
+    std::memcpy(buffer, ops->hidden.mem.base + offset, count);
+    return count;
+  }
+
+#if !defined(_WIN32)
+  if (ops->type == SDL_RWOPS_STDFILE)
+  {
+    // Note: Writes pending in the stdio buffer are not visible until the stream is flushed.
+    const auto  descriptor = fileno(ops->hidden.stdio.fp);
+    std::size_t total      = 0;
+    while (total < size)
+    {
+      const auto result = ::pread(descriptor, static_cast<std::byte*>(buffer) + total, size - total, static_cast<off_t>(offset + static_cast<std::int64_t>(total)));
+      if (result < 0 && errno == EINTR)
+        continue;
+      if (result < 0)
+        return std::unexpected(std::string("pread failed: ") + std::strerror(errno));
+      if (result == 0)
+        break;
+      total += static_cast<std::size_t>(result);
+    }
+    return total;
+  }
+#endif
+
+  if (SDL_RWseek(ops, offset, RW_SEEK_SET) < 0)
+    return std::unexpected(get_error());
+  return SDL_RWread(ops, buffer, 1, size);
+}
+// Bad practice: You should use `std::fstream` instead.
+inline std::expected<std::size_t              , std::string> rw_write_at      (native_rw_ops* ops, const std::int64_t offset, const void* buffer, const std::size_t size)
+{
+  if (offset < 0)
+    return std::unexpected(std::string("Negative offset."));
+  if (size == 0)
+    return 0;
+
+  if (ops->type == SDL_RWOPS_MEMORY_RO)
+    return std::unexpected(std::string("Can't write to read-only memory."));
+  if (ops->type == SDL_RWOPS_MEMORY)
+  {
+    const auto available = static_cast<std::size_t>(ops->hidden.mem.stop - ops->hidden.mem.base);
+    if (static_cast<std::size_t>(offset) >= available)
+      return 0;
+    const auto count = std::min(size, available - static_cast<std::size_t>(offset));
+    std::memcpy(ops->hidden.mem.base + offset, buffer, count);
+    return count;
+  }
+
+  if (const auto functions = get_rw_source_functions(ops); functions && functions->write_at)
+    return functions->write_at(ops->hidden.unknown.data1, offset, buffer, size);
+
+#if !defined(_WIN32)
+  if (ops->type == SDL_RWOPS_STDFILE)
+  {
+    // Note: Pending stdio writes are flushed first, since they would overwrite this one. Data which is already in the
+    // stdio read buffer is not updated.
+    if (std::fflush(ops->hidden.stdio.fp) != 0)
+      return std::unexpected(std::string("fflush failed: ") + std::strerror(errno));
+
+    const auto  descriptor = fileno(ops->hidden.stdio.fp);
+    std::size_t total      = 0;
+    while (total < size)
+    {
+      const auto result = ::pwrite(descriptor, static_cast<const std::byte*>(buffer) + total, size - total, static_cast<off_t>(offset + static_cast<std::int64_t>(total)));
+      if (result < 0 && errno == EINTR)
+        continue;
+      if (result <= 0)
+        return std::unexpected(std::string("pwrite failed: ") + std::strerror(errno));
+      total += static_cast<std::size_t>(result);
+    }
+    return total;
+  }
+#endif
+
+  if (SDL_RWseek(ops, offset, RW_SEEK_SET) < 0)
+    return std::unexpected(get_error());
+  const auto count = SDL_RWwrite(ops, buffer, 1, size);
+  if (count < size)
+    return std::unexpected(get_error());
+  return count;
+}
+// The size of the native rw_ops, without moving the position of file sources (which `SDL_RWsize` seeks), hence it may
+// be called concurrently with `sdl::rw_read_at`. The size of file sources excludes pending stdio writes.
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<std::int64_t             , std::string> rw_size_at       (native_rw_ops* ops)
+{
+  if (ops->type == SDL_RWOPS_MEMORY || ops->type == SDL_RWOPS_MEMORY_RO)
+    return static_cast<std::int64_t>(ops->hidden.mem.stop - ops->hidden.mem.base);
+
+#if !defined(_WIN32)
+  if (ops->type == SDL_RWOPS_STDFILE)
+  {
+    struct stat status;
+    if (::fstat(fileno(ops->hidden.stdio.fp), &status) != 0)
+      return std::unexpected(std::string("fstat failed: ") + std::strerror(errno));
+    return static_cast<std::int64_t>(status.st_size);
+  }
+#endif
+
+  return rw_size(ops);
+}
+// Converts the value of a successful result, e.g. to read signed integers through the unsigned SDL functions.
+template <std::integral type, std::integral source_type> [[nodiscard]]
+std::expected<type                            , std::string> cast_result      (const std::expected<source_type, std::string>& result)
+{
+  if (!result)
+    return std::unexpected(result.error());
+  return static_cast<type>(result.value());
+}
 // Bad practice: You should use `std::fstream` instead.
 template <std::integral type> [[nodiscard]]
 std::expected<type                            , std::string> read_le_integer  (native_rw_ops* ops)
 {
   if      constexpr (sizeof(type) == 1)
-    return static_cast<type>(read_u8  (ops));
+    return cast_result<type>(read_u8  (ops));
   else if constexpr (sizeof(type) == 2)
-    return static_cast<type>(read_le16(ops));
+    return cast_result<type>(read_le16(ops));
   else if constexpr (sizeof(type) == 4)
-    return static_cast<type>(read_le32(ops));
+    return cast_result<type>(read_le32(ops));
   else if constexpr (sizeof(type) == 8)
-    return static_cast<type>(read_le64(ops));
+    return cast_result<type>(read_le64(ops));
   else
   {
     static_assert(sizeof(type) == 0, "Invalid integer type.");
@@ -334,13 +675,13 @@ template <std::integral type> [[nodiscard]]
 std::expected<type                            , std::string> read_be_integer  (native_rw_ops* ops)
 {
   if      constexpr (sizeof(type) == 1)
-    return static_cast<type>(read_u8  (ops));
+    return cast_result<type>(read_u8  (ops));
   else if constexpr (sizeof(type) == 2)
-    return static_cast<type>(read_be16(ops));
+    return cast_result<type>(read_be16(ops));
   else if constexpr (sizeof(type) == 4)
-    return static_cast<type>(read_be32(ops));
+    return cast_result<type>(read_be32(ops));
   else if constexpr (sizeof(type) == 8)
-    return static_cast<type>(read_be64(ops));
+    return cast_result<type>(read_be64(ops));
   else
   {
     static_assert(sizeof(type) == 0, "Invalid integer type.");
@@ -383,6 +724,281 @@ std::expected<void                            , std::string> write_be_integer (n
     return {};
   }
 }
+// Bulk conversions. Reads transfer the whole span at once and convert it in place, writes convert through a bounded
+// intermediate buffer unless the byte order already matches. Reads return the number of elements read.
+// Bad practice: You should use `std::fstream` instead.
+template <byteswappable type> [[nodiscard]]
+std::expected<std::size_t                     , std::string> read_le_array    (native_rw_ops* ops, const std::span<      type>& values)
+{
+  if (values.empty())
+    return 0;
+  const auto result = rw_read(ops, values.data(), sizeof(type), values.size());
+  if (!result)
+    return std::unexpected(result.error());
+  byteswap_le_array(values.first(result.value()));
+  return result;
+}
+// Bad practice: You should use `std::fstream` instead.
+template <byteswappable type> [[nodiscard]]
+std::expected<std::size_t                     , std::string> read_be_array    (native_rw_ops* ops, const std::span<      type>& values)
+{
+  if (values.empty())
+    return 0;
+  const auto result = rw_read(ops, values.data(), sizeof(type), values.size());
+  if (!result)
+    return std::unexpected(result.error());
+  byteswap_be_array(values.first(result.value()));
+  return result;
+}
+// Bad practice: You should use `std::fstream` instead.
+template <byteswappable type, endian target>
+std::expected<void                            , std::string> write_array      (native_rw_ops* ops, const std::span<const type>& values)
+{
+  if (values.empty())
+    return {};
+
+  if constexpr (target == byte_order || sizeof(type) == 1)
+  {
+    if (const auto result = rw_write(ops, values.data(), sizeof(type), values.size()); !result)
+      return std::unexpected(result.error());
+    return {};
+  }
+  else
+  {
+    constexpr std::size_t chunk_size = 16 * 1024 / sizeof(type);
+
+    std::vector<type> buffer(std::min(values.size(), chunk_size));
+    for (std::size_t offset = 0; offset < values.size(); offset += buffer.size())
+    {
+      const auto chunk = std::span(buffer).first(std::min(buffer.size(), values.size() - offset));
+      std::copy_n(values.data() + offset, chunk.size(), chunk.data());
+      byteswap_array(chunk);
+      if (const auto result = rw_write(ops, chunk.data(), sizeof(type), chunk.size()); !result)
+        return std::unexpected(result.error());
+    }
+    return {};
+  }
+}
+// Bad practice: You should use `std::fstream` instead.
+template <byteswappable type>
+std::expected<void                            , std::string> write_le_array   (native_rw_ops* ops, const std::span<const type>& values)
+{
+  return write_array<type, endian::little>(ops, values);
+}
+// Bad practice: You should use `std::fstream` instead.
+template <byteswappable type>
+std::expected<void                            , std::string> write_be_array   (native_rw_ops* ops, const std::span<const type>& values)
+{
+  return write_array<type, endian::big   >(ops, values);
+}
+
+// A custom source for a native rw_ops. The `size`, `seek`, `read` and `write` functions follow the semantics of their SDL
+// counterparts, except that errors are returned as unexpected values instead of being set through `sdl::set_error`.
+// An optional `std::expected<void, std::string> close()` function is called before the source is destroyed.
+// Optional `read_at(std::int64_t offset, void* buffer, std::size_t size)` and `write_at(...)` functions returning
+// `std::expected<std::size_t, std::string>` provide positional access to `sdl::rw_read_at` and `sdl::rw_write_at`, and
+// must allow concurrent access to disjoint ranges.
+template <typename type>
+concept rw_source = requires (type& source, void* buffer, const void* const_buffer, const std::size_t size, const std::int64_t offset, const seek_mode origin)
+{
+  { source.size ()                         } -> std::same_as<std::expected<std::int64_t, std::string>>;
+  { source.seek (offset      , origin)     } -> std::same_as<std::expected<std::int64_t, std::string>>;
+  { source.read (buffer      , size, size) } -> std::same_as<std::expected<std::size_t , std::string>>;
+  { source.write(const_buffer, size, size) } -> std::same_as<std::expected<std::size_t , std::string>>;
+};
+
+// The native rw_ops takes the ownership of the source, which is destroyed when the native rw_ops is closed.
+template <rw_source source_type> [[nodiscard]]
+std::expected<native_rw_ops*                  , std::string> rw_from_source   (std::unique_ptr<source_type> source)
+{
+  auto result = alloc_rw();
+  if (!result)
+    return std::unexpected(result.error());
+
+  const auto ops = result.value();
+  ops->type                 = SDL_RWOPS_UNKNOWN;
+  static constexpr rw_source_functions functions
+  {
+    [ ] (native_rw_ops* context) -> std::int32_t
+    {
+      const auto   source = static_cast<source_type*>(context->hidden.unknown.data1);
+      std::int32_t status = 0;
+      if constexpr (requires { { source->close() } -> std::same_as<std::expected<void, std::string>>; })
+      {
+        if (const auto value = source->close(); !value)
+        {
+          set_error(value.error());
+          status = -1;
+        }
+      }
+      delete source;
+      free_rw(context);
+      return status;
+    },
+    [ ] () -> decltype(rw_source_functions::read_at)
+    {
+      if constexpr (requires (source_type& source, void* buffer) { { source.read_at(std::int64_t {}, buffer, std::size_t {}) } -> std::same_as<std::expected<std::size_t, std::string>>; })
+        return [ ] (void* source, const std::int64_t offset,       void* buffer, const std::size_t size) { return static_cast<source_type*>(source)->read_at (offset, buffer, size); };
+      else
+        return nullptr;
+    }(),
+    [ ] () -> decltype(rw_source_functions::write_at)
+    {
+      if constexpr (requires (source_type& source, const void* buffer) { { source.write_at(std::int64_t {}, buffer, std::size_t {}) } -> std::same_as<std::expected<std::size_t, std::string>>; })
+        return [ ] (void* source, const std::int64_t offset, const void* buffer, const std::size_t size) { return static_cast<source_type*>(source)->write_at(offset, buffer, size); };
+      else
+        return nullptr;
+    }()
+  };
+
+  ops->hidden.unknown.data1 = source.release();
+  ops->hidden.unknown.data2 = const_cast<rw_source_functions*>(&functions);
+  ops->size                 = [ ] (native_rw_ops* context) -> std::int64_t
+  {
+    const auto value = static_cast<source_type*>(context->hidden.unknown.data1)->size();
+    if (!value)
+    {
+      set_error(value.error());
+      return -1;
+    }
+    return value.value();
+  };
+  ops->seek                 = [ ] (native_rw_ops* context, const std::int64_t offset, const std::int32_t whence) -> std::int64_t
+  {
+    const auto value = static_cast<source_type*>(context->hidden.unknown.data1)->seek(offset, static_cast<seek_mode>(whence));
+    if (!value)
+    {
+      set_error(value.error());
+      return -1;
+    }
+    return value.value();
+  };
+  ops->read                 = [ ] (native_rw_ops* context,       void* buffer, const std::size_t size, const std::size_t count) -> std::size_t
+  {
+    const auto value = static_cast<source_type*>(context->hidden.unknown.data1)->read (buffer, size, count);
+    if (!value)
+    {
+      set_error(value.error());
+      return 0;
+    }
+    return value.value();
+  };
+  ops->write                = [ ] (native_rw_ops* context, const void* buffer, const std::size_t size, const std::size_t count) -> std::size_t
+  {
+    const auto value = static_cast<source_type*>(context->hidden.unknown.data1)->write(buffer, size, count);
+    if (!value)
+    {
+      set_error(value.error());
+      return 0;
+    }
+    return value.value();
+  };
+  ops->close                = &close_rw_source;
+  return ops;
+}
+
+// A window over a range of a native rw_ops, which is not owned and must outlive the window. Reads and writes use
+// `sdl::rw_read_at` and `sdl::rw_write_at`, hence do not depend on the position of the parent, and are bounded by the
+// range. Writes can not grow the window. The length is clamped to the size of the parent (from `sdl::rw_size_at`) if
+// known, hence windows over file and mapped sources may be created concurrently.
+class rw_window_source
+{
+public:
+  explicit rw_window_source  (native_rw_ops* parent, const std::int64_t offset, const std::int64_t length)
+  : parent_(parent)
+  , offset_(std::max<std::int64_t>(offset, 0))
+  , length_(std::max<std::int64_t>(length, 0))
+  {
+    if (const auto size = rw_size_at(parent_))
+      length_ = std::clamp<std::int64_t>(size.value() - offset_, 0, length_);
+  }
+  rw_window_source           (const rw_window_source&  that) = delete;
+  rw_window_source           (      rw_window_source&& temp) = default;
+ ~rw_window_source           ()                              = default;
+  rw_window_source& operator=(const rw_window_source&  that) = delete;
+  rw_window_source& operator=(      rw_window_source&& temp) = default;
+
+  [[nodiscard]]
+  std::expected<std::int64_t, std::string> size (                                                                ) const
+  {
+    return length_;
+  }
+  std::expected<std::int64_t, std::string> seek (const std::int64_t offset, const seek_mode origin               )
+  {
+    const auto base = origin == seek_mode::set ? 0 : origin == seek_mode::cur ? position_ : length_;
+    position_ = std::clamp<std::int64_t>(base + offset, 0, length_);
+    return position_;
+  }
+  std::expected<std::size_t , std::string> read (      void* buffer, const std::size_t size, const std::size_t count)
+  {
+    if (size == 0 || count == 0)
+      return 0;
+
+    const auto objects = std::min(count, static_cast<std::size_t>(length_ - position_) / size);
+    const auto result  = rw_read_at(parent_, offset_ + position_, buffer, objects * size);
+    if (!result)
+      return std::unexpected(result.error());
+    position_ += static_cast<std::int64_t>(result.value());
+    return result.value() / size;
+  }
+  std::expected<std::size_t , std::string> write(const void* buffer, const std::size_t size, const std::size_t count)
+  {
+    if (size == 0 || count == 0)
+      return 0;
+
+    const auto objects = std::min(count, static_cast<std::size_t>(length_ - position_) / size);
+    const auto result  = rw_write_at(parent_, offset_ + position_, buffer, objects * size);
+    if (!result)
+      return std::unexpected(result.error());
+    position_ += static_cast<std::int64_t>(result.value());
+    if (objects < count)
+      return std::unexpected(std::string("Write beyond the end of the window."));
+    return result.value() / size;
+  }
+  std::expected<std::size_t , std::string> read_at (const std::int64_t offset,       void* buffer, const std::size_t size) const
+  {
+    if (offset >= length_)
+      return 0;
+    return rw_read_at (parent_, offset_ + offset, buffer, std::min(size, static_cast<std::size_t>(length_ - offset)));
+  }
+  std::expected<std::size_t , std::string> write_at(const std::int64_t offset, const void* buffer, const std::size_t size) const
+  {
+    if (offset + static_cast<std::int64_t>(size) > length_)
+      return std::unexpected(std::string("Write beyond the end of the window."));
+    return rw_write_at(parent_, offset_ + offset, buffer, size);
+  }
+
+  [[nodiscard]]
+  native_rw_ops* parent  () const noexcept
+  {
+    return parent_;
+  }
+  [[nodiscard]]
+  std::int64_t   offset  () const noexcept
+  {
+    return offset_;
+  }
+  [[nodiscard]]
+  std::int64_t   position() const noexcept
+  {
+    return position_;
+  }
+
+private:
+  native_rw_ops* parent_   {};
+  std::int64_t   offset_   {};
+  std::int64_t   length_   {};
+  std::int64_t   position_ {};
+};
+
+// Bad practice: You should use `std::fstream` instead.
+[[nodiscard]]
+inline std::expected<native_rw_ops*           , std::string> rw_from_slice    (native_rw_ops* parent, const std::int64_t offset, const std::int64_t length)
+{
+  if (offset < 0 || length < 0)
+    return std::unexpected(std::string("Negative slice offset or length."));
+  return rw_from_source(std::make_unique<rw_window_source>(parent, offset, length));
+}
 
 // Bad practice: You should use `std::fstream` instead.
 class rw_ops
@@ -432,6 +1048,13 @@ public:
   : native_(rw_from_const_mem(memory).value_or(nullptr))
   {
     
+  }
+  // The constructor cannot transmit error state. You should use `sdl::make_rw_ops(...)` to handle errors.
+  template <rw_source source_type>
+  explicit rw_ops  (std::unique_ptr<source_type>      source)
+  : native_(rw_from_source(std::move(source)).value_or(nullptr))
+  {
+    
   }
   rw_ops           (const rw_ops&  that) = delete;
   rw_ops           (      rw_ops&& temp) noexcept
@@ -490,15 +1113,38 @@ public:
     return load_file_rw(native_, false); // The source will be freed in the destructor.
   }
 
-  template <typename type>      [[nodiscard]]
+  template <typename type> requires std::is_trivially_copyable_v<type> [[nodiscard]]
   std::expected<std::size_t              , std::string> read_as         (const std::span<      type>& buffer) const
   {
-    return rw_read_as<type>(buffer.data(), buffer.size());
+    return rw_read_as <type>(native_, buffer);
   }
-  template <typename type>
+  template <typename type> requires std::is_trivially_copyable_v<type>
   std::expected<std::size_t              , std::string> write_as        (const std::span<const type>& buffer)
   {
-    return rw_write_as<type>(native_, buffer.data(), buffer.size());
+    return rw_write_as<type>(native_, buffer);
+  }
+
+  // The slice refers to this object, which must outlive it.
+  [[nodiscard]]
+  std::expected<rw_ops                   , std::string> slice           (const std::int64_t offset, const std::int64_t length) const
+  {
+    if (offset < 0 || length < 0)
+      return std::unexpected(std::string("Negative slice offset or length."));
+
+    auto result = rw_ops(std::make_unique<rw_window_source>(native_, offset, length));
+    if (!result.native())
+      return std::unexpected(get_error());
+    return result;
+  }
+
+  [[nodiscard]]
+  std::expected<std::size_t              , std::string> read_v          (const std::span<const std::span<      std::byte>>& buffers) const
+  {
+    return rw_read_v (native_, buffers);
+  }
+  std::expected<std::size_t              , std::string> write_v         (const std::span<const std::span<const std::byte>>& buffers)
+  {
+    return rw_write_v(native_, buffers);
   }
 
   template <std::integral type> [[nodiscard]]
@@ -522,6 +1168,27 @@ public:
     return sdl::write_be_integer<type>(native_, value);
   }
 
+  template <byteswappable type> [[nodiscard]]
+  std::expected<std::size_t              , std::string> read_le_array   (const std::span<      type>& values) const
+  {
+    return sdl::read_le_array<type>(native_, values);
+  }
+  template <byteswappable type> [[nodiscard]]
+  std::expected<std::size_t              , std::string> read_be_array   (const std::span<      type>& values) const
+  {
+    return sdl::read_be_array<type>(native_, values);
+  }
+  template <byteswappable type>
+  std::expected<void                     , std::string> write_le_array  (const std::span<const type>& values)
+  {
+    return sdl::write_le_array<type>(native_, values);
+  }
+  template <byteswappable type>
+  std::expected<void                     , std::string> write_be_array  (const std::span<const type>& values)
+  {
+    return sdl::write_be_array<type>(native_, values);
+  }
+
   [[nodiscard]]
   SDL_RWops*                                            native          () const
   {
@@ -596,4 +1263,13 @@ std::expected       <rw_ops                   , std::string> make_rw_ops      (c
     return std::unexpected(get_error());
   return result;
 }
+// Bad practice: You should use `std::fstream` instead.
+template <rw_source source_type> [[nodiscard]]
+std::expected       <rw_ops                   , std::string> make_rw_ops      (std::unique_ptr<source_type>      source)
+{
+  auto result = rw_ops(std::move(source));
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <SDL_render.h>
+
+#include <sdl/blend_mode.hpp>
+#include <sdl/rect.hpp>
+#include <sdl/render.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a sprite batch which collects textured quads and renders each group
+// of quads sharing a texture and a blend mode with a single `SDL_RenderGeometry` call, instead of one `SDL_RenderCopy`
+// call per sprite.
+
+enum class sprite_sort_mode
+{
+  deferred, // The sprites are rendered in submission order. Consecutive sprites sharing a texture and a blend mode are
+            // grouped.
+  texture   // The sprites are sorted by layer, then by texture and blend mode. The submission order is retained within each
+            // group, hence overlapping sprites of different textures in the same layer may be reordered.
+};
+
+struct sprite
+{
+  native_texture*             texture     {};                   // Untextured sprites are filled with the color.
+  native_frect                destination {};
+  std::optional<native_rect>  source      {};                   // The whole texture if none.
+  std::array<std::uint8_t, 4> color       {255, 255, 255, 255}; // Modulates the texture, as the color and alpha mod would.
+  sdl::blend_mode             blend_mode  {sdl::blend_mode::blend};
+  renderer_flip               flip        {renderer_flip::none};
+  float                       angle       {};                   // Degrees, clockwise around the center of the destination.
+  std::int32_t                layer       {};                   // Lower layers are rendered first with `sprite_sort_mode::texture`.
+};
+
+struct sprite_batch_statistics
+{
+  std::size_t sprites   ;
+  std::size_t draw_calls;
+};
+
+// The vertex colors replace the color and alpha mod of the textures, as in `SDL_RenderGeometry`. The blend mode of each
+// texture (or the draw blend mode of the renderer for untextured sprites) is set to that of the group while it is
+// rendered, and restored afterwards.
+//
+// Each sprite is a quad of two triangles. The software renderer of SDL renders axis-aligned quads as rectangle copies,
+// hence unrotated sprites render as they would with `SDL_RenderCopy`.
+class sprite_batch
+{
+public:
+  explicit sprite_batch  (const sprite_sort_mode mode = sprite_sort_mode::texture, const std::size_t capacity = 1024)
+  : sort_mode_(mode)
+  {
+    reserve(capacity);
+  }
+  sprite_batch           (const sprite_batch&  that) = default;
+  sprite_batch           (      sprite_batch&& temp) = default;
+ ~sprite_batch           ()                          = default;
+  sprite_batch& operator=(const sprite_batch&  that) = default;
+  sprite_batch& operator=(      sprite_batch&& temp) = default;
+
+  void                             draw          (const sprite&                   sprite )
+  {
+    sprites_.push_back(sprite);
+  }
+  void                             draw          (const texture&                  texture, const native_frect& destination, const std::optional<native_rect>& source = std::nullopt, const std::array<std::uint8_t, 4>& color = {255, 255, 255, 255}, const std::int32_t layer = 0)
+  {
+    sprites_.push_back(sprite {texture.native(), destination, source, color, sdl::blend_mode::blend, renderer_flip::none, 0.0f, layer});
+  }
+  void                             draw          (const std::span<const sprite>& sprites)
+  {
+    sprites_.insert(sprites_.end(), sprites.begin(), sprites.end());
+  }
+
+  // Renders and clears the collected sprites.
+  std::expected<void, std::string> flush         (const renderer& renderer)
+  {
+    return flush(renderer.native());
+  }
+  std::expected<void, std::string> flush         (native_renderer* renderer)
+  {
+    statistics_ = {sprites_.size(), 0};
+    if (sprites_.empty())
+      return {};
+
+    if (sort_mode_ == sprite_sort_mode::texture)
+      std::ranges::stable_sort(sprites_, [ ] (const sprite& lhs, const sprite& rhs)
+      {
+        return std::tuple(lhs.layer, lhs.texture, lhs.blend_mode) < std::tuple(rhs.layer, rhs.texture, rhs.blend_mode);
+      });
+
+    const auto count = sprites_.size();
+    reserve(count);
+    vertices_.resize(count * 4);
+
+    std::expected<void, std::string> result {};
+    for (std::size_t first = 0, last; first < count && result; first = last)
+    {
+      const auto texture = sprites_[first].texture;
+      const auto mode    = sprites_[first].blend_mode;
+
+      last = first + 1;
+      while (last < count && sprites_[last].texture == texture && sprites_[last].blend_mode == mode)
+        ++last;
+
+      std::array<float, 2> scale {};
+      if (texture)
+      {
+        const auto info = query_texture(texture);
+        if (!info)
+        {
+          result = std::unexpected(info.error());
+          break;
+        }
+        scale = {1.0f / static_cast<float>(info->size[0]), 1.0f / static_cast<float>(info->size[1])};
+      }
+      for (auto i = first; i < last; ++i)
+        make_quad(sprites_[i], scale, &vertices_[i * 4]);
+
+      result = render_group(renderer, texture, mode, std::span(vertices_).subspan(first * 4, (last - first) * 4), std::span(indices_).first((last - first) * 6));
+      ++statistics_.draw_calls;
+    }
+
+    sprites_.clear();
+    return result;
+  }
+  void                             clear         ()
+  {
+    sprites_.clear();
+  }
+
+  // Reserves space for the sprites, the vertices and the indices.
+  void                             reserve       (const std::size_t capacity)
+  {
+    sprites_ .reserve(capacity);
+    vertices_.reserve(capacity * 4);
+    // The indices are the same for each batch of quads, hence computed once.
+    for (auto quad = indices_.size() / 6; quad < capacity; ++quad)
+    {
+      const auto base = static_cast<std::int32_t>(quad * 4);
+      indices_.insert(indices_.end(), {base, base + 1, base + 2, base + 2, base + 3, base});
+    }
+  }
+
+  [[nodiscard]]
+  std::size_t                      size          () const noexcept
+  {
+    return sprites_.size();
+  }
+  [[nodiscard]]
+  bool                             empty         () const noexcept
+  {
+    return sprites_.empty();
+  }
+  [[nodiscard]]
+  sprite_sort_mode                 sort_mode     () const noexcept
+  {
+    return sort_mode_;
+  }
+  void                             set_sort_mode (const sprite_sort_mode mode) noexcept
+  {
+    sort_mode_ = mode;
+  }
+  // The statistics of the last flush.
+  [[nodiscard]]
+  const sprite_batch_statistics&   statistics    () const noexcept
+  {
+    return statistics_;
+  }
+
+private:
+  // The corners are in the order top left, top right, bottom right, bottom left, before the rotation.
+  static void                             make_quad   (const sprite& sprite, const std::array<float, 2>& scale, native_vertex* vertices)
+  {
+    const auto& target = sprite.destination;
+    const auto  color  = native_color {sprite.color[0], sprite.color[1], sprite.color[2], sprite.color[3]};
+
+    std::array<float, 4> uv {0.0f, 0.0f, 1.0f, 1.0f};
+    if (sprite.texture && sprite.source)
+    {
+      const auto& source = sprite.source.value();
+      uv = {source.x * scale[0], source.y * scale[1], (source.x + source.w) * scale[0], (source.y + source.h) * scale[1]};
+    }
+    if ((sprite.flip & renderer_flip::horizontal) != renderer_flip::none)
+      std::swap(uv[0], uv[2]);
+    if ((sprite.flip & renderer_flip::vertical  ) != renderer_flip::none)
+      std::swap(uv[1], uv[3]);
+
+    vertices[0] = {{target.x           , target.y           }, color, {uv[0], uv[1]}};
+    vertices[1] = {{target.x + target.w, target.y           }, color, {uv[2], uv[1]}};
+    vertices[2] = {{target.x + target.w, target.y + target.h}, color, {uv[2], uv[3]}};
+    vertices[3] = {{target.x           , target.y + target.h}, color, {uv[0], uv[3]}};
+
+    if (sprite.angle != 0.0f)
+    {
+      const auto radians = sprite.angle * std::numbers::pi_v<float> / 180.0f;
+      const auto cosine  = std::cos(radians);
+      const auto sine    = std::sin(radians);
+      const auto center  = native_fpoint {target.x + target.w * 0.5f, target.y + target.h * 0.5f};
+      for (std::size_t i = 0; i < 4; ++i)
+      {
+        auto& position = vertices[i].position;
+        const auto x   = position.x - center.x;
+        const auto y   = position.y - center.y;
+        position       = {center.x + x * cosine - y * sine, center.y + x * sine + y * cosine};
+      }
+    }
+  }
+  static std::expected<void, std::string> render_group(native_renderer* renderer, native_texture* texture, const sdl::blend_mode mode, const std::span<const native_vertex>& vertices, const std::span<const std::int32_t>& indices)
+  {
+    const auto previous = texture ? get_texture_blend_mode(texture) : get_render_draw_blend_mode(renderer);
+    if (!previous)
+      return std::unexpected(previous.error());
+
+    if (previous.value() != mode)
+      if (auto result = texture ? set_texture_blend_mode(texture, mode) : set_render_draw_blend_mode(renderer, mode); !result)
+        return result;
+
+    auto result = render_geometry(renderer, texture, vertices, indices);
+
+    if (previous.value() != mode)
+      if (auto status = texture ? set_texture_blend_mode(texture, previous.value()) : set_render_draw_blend_mode(renderer, previous.value()); !status && result)
+        result = status;
+    return result;
+  }
+
+  sprite_sort_mode                 sort_mode_  ;
+  std::vector<sprite>              sprites_    {};
+  std::vector<native_vertex>       vertices_   {};
+  std::vector<std::int32_t>        indices_    {};
+  sprite_batch_statistics          statistics_ {};
+};
+}
\ No newline at end of file
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <sdl/mutex.hpp>
+#include <sdl/pixels.hpp>
+#include <sdl/render.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a ring of streaming textures, which a producer thread (e.g. a video
+// decoder) writes into while the render thread draws the previously written one.
+
+inline constexpr std::size_t default_streaming_texture_count = 3;
+
+enum class streaming_mode
+{
+  fifo   , // Each written frame is displayed, in order. The producer waits for a texture when all are written.
+  mailbox  // The newest written frame is displayed, the older ones are dropped. The producer never waits.
+};
+
+// The state of a texture of the ring, which acts as a fence between the render thread and the producer thread. The render
+// thread maps idle textures (locks them), the producer writes mapped ones, and the render thread uploads written ones
+// (unlocks them) and displays them until a newer one is uploaded.
+enum class streaming_texture_state
+{
+  idle     ,
+  mapped   ,
+  writing  ,
+  written  ,
+  displayed
+};
+
+struct streaming_frame
+{
+  std::size_t                 index ; // Of the texture in the ring.
+  void*                       pixels;
+  std::int32_t                pitch ;
+  std::array<std::int32_t, 2> size  ;
+  std::uint32_t               format;
+};
+
+struct streaming_statistics
+{
+  std::size_t               submitted      {}; // Frames written by the producer.
+  std::size_t               displayed      {}; // Frames uploaded by the render thread.
+  std::size_t               dropped        {}; // Written frames replaced by newer ones before being uploaded.
+  std::size_t               starved        {}; // Calls to `begin_write` which found no mapped texture.
+  std::chrono::microseconds last_latency   {}; // From the end of writing to the upload.
+  std::chrono::microseconds average_latency{};
+  std::chrono::microseconds maximum_latency{};
+};
+
+// SDL renderers are not thread safe, hence all renderer calls (locking, unlocking and drawing) are made on the render
+// thread by `update`, and the producer thread only writes the pixels of mapped textures. The pixels of a mapped texture
+// are undefined (SDL may provide a staging buffer), hence the producer must write all of them.
+//
+// At least two textures are required: one displayed and one written. A third one lets the producer write while the
+// render thread uploads.
+class streaming_texture_ring
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  // The textures must be destroyed before the renderer, hence the ring must be as well. The constructor cannot transmit
+  // error state. You should use `sdl::make_streaming_texture_ring(...)` to handle errors.
+  explicit streaming_texture_ring  (
+    const renderer&                    renderer,
+    const std::array<std::int32_t, 2>& size,
+    const std::uint32_t                format = SDL_PIXELFORMAT_ARGB8888,
+    const std::size_t                  count  = default_streaming_texture_count,
+    const streaming_mode               mode   = streaming_mode::mailbox)
+  : size_(size), format_(format), mode_(mode)
+  {
+    for (std::size_t i = 0; i < std::max<std::size_t>(count, 2); ++i)
+    {
+      auto texture = make_texture(renderer, size, format, texture_access::streaming);
+      if (!texture)
+        break;
+      slots_.push_back(slot {std::move(texture.value())});
+    }
+  }
+  streaming_texture_ring           (const streaming_texture_ring&  that) = delete;
+  streaming_texture_ring           (      streaming_texture_ring&& temp) = delete;
+ ~streaming_texture_ring           ()
+  {
+    close();
+    for (auto& current : slots_)
+      if (current.state != streaming_texture_state::idle && current.state != streaming_texture_state::displayed)
+        current.texture.unlock();
+  }
+  streaming_texture_ring& operator=(const streaming_texture_ring&  that) = delete;
+  streaming_texture_ring& operator=(      streaming_texture_ring&& temp) = delete;
+
+  // Render thread: uploads the next written frame (the oldest in fifo mode, the newest in mailbox mode), and maps the idle
+  // textures for the producer. Returns the displayed texture, or nullptr before the first frame. Call once per frame,
+  // before drawing the texture.
+  std::expected<native_texture*, std::string> update         ()
+  {
+    std::optional<std::size_t> next;
+    std::vector<std::size_t>   idle;
+    {
+      std::lock_guard lock(mutex_);
+      for (std::size_t i = 0; i < slots_.size(); ++i)
+      {
+        if      (slots_[i].state == streaming_texture_state::written && (!next || (mode_ == streaming_mode::fifo) == (slots_[i].sequence < slots_[next.value()].sequence)))
+          next = i;
+        else if (slots_[i].state == streaming_texture_state::idle)
+          idle.push_back(i);
+      }
+      if (next)
+      {
+        // Marked as displayed before the upload, so that the producer does not reclaim it in mailbox mode.
+        slots_[next.value()].state = streaming_texture_state::displayed;
+
+        // The written frames older than the uploaded one are dropped in mailbox mode. Their textures remain mapped.
+        if (mode_ == streaming_mode::mailbox)
+          for (auto& current : slots_)
+            if (current.state == streaming_texture_state::written && current.sequence < slots_[next.value()].sequence)
+            {
+              current.state = streaming_texture_state::mapped;
+              ++statistics_.dropped;
+            }
+      }
+    }
+
+    // The textures in these states are not accessed by the producer, hence are locked and unlocked without the mutex.
+    if (next)
+    {
+      slots_[next.value()].texture.unlock();
+
+      const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - slots_[next.value()].written_time);
+      std::lock_guard lock(mutex_);
+      if (displayed_)
+      {
+        slots_[displayed_.value()].state = streaming_texture_state::idle;
+        idle.push_back(displayed_.value());
+      }
+      displayed_                   = next;
+      total_latency_              += latency;
+      ++statistics_.displayed;
+      statistics_.last_latency     = latency;
+      statistics_.average_latency  = total_latency_ / static_cast<std::int64_t>(statistics_.displayed);
+      statistics_.maximum_latency  = std::max(statistics_.maximum_latency, latency);
+    }
+
+    std::string error;
+    for (const auto index : idle)
+    {
+      auto& current = slots_[index];
+      const auto lock = current.texture.lock();
+      if (!lock)
+      {
+        error = lock.error();
+        continue;
+      }
+
+      std::lock_guard guard(mutex_);
+      current.lock  = lock.value();
+      current.state = streaming_texture_state::mapped;
+    }
+    if (!idle.empty())
+      static_cast<void>(mapped_.notify_all());
+
+    if (!error.empty())
+      return std::unexpected(error);
+    return current();
+  }
+  // Render thread: the texture displayed since the last `update`, or nullptr before the first frame.
+  [[nodiscard]]
+  native_texture*                             current        () const
+  {
+    std::lock_guard lock(mutex_);
+    return displayed_ ? slots_[displayed_.value()].texture.native() : nullptr;
+  }
+
+  // Producer thread: returns a mapped texture to write, waiting up to the timeout for one in fifo mode. In mailbox mode, the
+  // oldest written frame is reclaimed (and dropped) if no texture is mapped. Returns nothing if no texture is available,
+  // or the ring is closed.
+  [[nodiscard]]
+  std::optional<streaming_frame>              begin_write    (const std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+  {
+    const auto      deadline = clock::now() + timeout;
+    std::lock_guard lock(mutex_);
+    while (!closed_)
+    {
+      std::optional<std::size_t> found;
+      for (std::size_t i = 0; i < slots_.size() && !found; ++i)
+        if (slots_[i].state == streaming_texture_state::mapped)
+          found = i;
+
+      if (!found && mode_ == streaming_mode::mailbox)
+        for (std::size_t i = 0; i < slots_.size(); ++i)
+          if (slots_[i].state == streaming_texture_state::written && (!found || slots_[i].sequence < slots_[found.value()].sequence))
+            found = i;
+      if (found && slots_[found.value()].state == streaming_texture_state::written)
+        ++statistics_.dropped;
+
+      if (found)
+      {
+        auto& current = slots_[found.value()];
+        current.state = streaming_texture_state::writing;
+        return streaming_frame {found.value(), current.lock.pixels, current.lock.pitch, size_, format_};
+      }
+
+      const auto now = clock::now();
+      if (now >= deadline)
+        break;
+      static_cast<void>(mapped_.wait_for(mutex_, std::max(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now), std::chrono::milliseconds(1))));
+    }
+    ++statistics_.starved;
+    return std::nullopt;
+  }
+  // Producer thread: marks the frame as written, to be uploaded by the next `update`.
+  void                                        end_write      (const streaming_frame& frame)
+  {
+    std::lock_guard lock(mutex_);
+    auto& current        = slots_[frame.index];
+    current.state        = streaming_texture_state::written;
+    current.sequence     = ++sequence_;
+    current.written_time = clock::now();
+    ++statistics_.submitted;
+  }
+  // Producer thread: returns the frame without writing it.
+  void                                        cancel_write   (const streaming_frame& frame)
+  {
+    std::lock_guard lock(mutex_);
+    slots_[frame.index].state = streaming_texture_state::mapped;
+    static_cast<void>(mapped_.notify_all());
+  }
+  // Wakes the producer waiting in `begin_write`, and fails further calls. Call before joining the producer thread.
+  void                                        close          ()
+  {
+    {
+      std::lock_guard lock(mutex_);
+      closed_ = true;
+    }
+    static_cast<void>(mapped_.notify_all());
+  }
+
+  [[nodiscard]]
+  streaming_statistics                        statistics     () const
+  {
+    std::lock_guard lock(mutex_);
+    return statistics_;
+  }
+  void                                        reset_statistics()
+  {
+    std::lock_guard lock(mutex_);
+    statistics_    = {};
+    total_latency_ = {};
+  }
+  [[nodiscard]]
+  streaming_texture_state                     state          (const std::size_t index) const
+  {
+    std::lock_guard lock(mutex_);
+    return slots_[index].state;
+  }
+  [[nodiscard]]
+  std::size_t                                 count          () const noexcept
+  {
+    return slots_.size();
+  }
+  [[nodiscard]]
+  const std::array<std::int32_t, 2>&          size           () const noexcept
+  {
+    return size_;
+  }
+  [[nodiscard]]
+  std::uint32_t                               format         () const noexcept
+  {
+    return format_;
+  }
+  [[nodiscard]]
+  streaming_mode                              mode           () const noexcept
+  {
+    return mode_;
+  }
+
+private:
+  struct slot
+  {
+    sdl::texture              texture     ;
+    streaming_texture_state   state       {streaming_texture_state::idle};
+    texture_lock              lock        {};
+    std::uint64_t             sequence    {}; // Of the written frame, to order the written textures.
+    clock::time_point         written_time{};
+  };
+
+  std::array<std::int32_t, 2> size_         ;
+  std::uint32_t               format_       ;
+  streaming_mode              mode_         ;
+  std::vector<slot>           slots_        {};
+  std::optional<std::size_t>  displayed_    {};
+  std::uint64_t               sequence_     {};
+  bool                        closed_       {false};
+
+  streaming_statistics        statistics_   {};
+  std::chrono::microseconds   total_latency_{};
+
+  mutable mutex               mutex_        {};
+  condition_variable          mapped_       {};
+};
+
+[[nodiscard]]
+inline std::expected<std::unique_ptr<streaming_texture_ring>, std::string> make_streaming_texture_ring(
+  const renderer&                    renderer,
+  const std::array<std::int32_t, 2>& size,
+  const std::uint32_t                format = SDL_PIXELFORMAT_ARGB8888,
+  const std::size_t                  count  = default_streaming_texture_count,
+  const streaming_mode               mode   = streaming_mode::mailbox)
+{
+  auto result = std::make_unique<streaming_texture_ring>(renderer, size, format, count, mode);
+  if (result->count() != std::max<std::size_t>(count, 2))
+    return std::unexpected(get_error());
+  return result;
+}
+}
\ No newline at end of file
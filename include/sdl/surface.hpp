@@ -1,21 +1,618 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
 #include <SDL_surface.h>
 
+#include <sdl/blend_mode.hpp>
+#include <sdl/cpu_info.hpp>
+#include <sdl/error.hpp>
+#include <sdl/pixel_conversion.hpp>
+#include <sdl/pixels.hpp>
+#include <sdl/rect.hpp>
+#include <sdl/rwops.hpp>
+
 namespace sdl
 {
 using native_surface = SDL_Surface;
 
+enum class yuv_conversion_mode
+{
+  jpeg      = SDL_YUV_CONVERSION_JPEG,
+  bt601     = SDL_YUV_CONVERSION_BT601,
+  bt709     = SDL_YUV_CONVERSION_BT709,
+  automatic = SDL_YUV_CONVERSION_AUTOMATIC
+};
+
+// Bad practice: You should use `sdl::surface` instead.
+[[nodiscard]]
+inline std::expected<native_surface*            , std::string> create_rgb_surface_with_format        (const std::array<std::int32_t, 2>& size, const std::uint32_t format)
+{
+  auto result = SDL_CreateRGBSurfaceWithFormat(0, size[0], size[1], static_cast<std::int32_t>(SDL_BITSPERPIXEL(format)), format);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+// Bad practice: You should use `sdl::surface` instead.
+[[nodiscard]]
+inline std::expected<native_surface*            , std::string> create_rgb_surface_with_format_from   (void* pixels, const std::array<std::int32_t, 2>& size, const std::int32_t pitch, const std::uint32_t format)
+{
+  auto result = SDL_CreateRGBSurfaceWithFormatFrom(pixels, size[0], size[1], static_cast<std::int32_t>(SDL_BITSPERPIXEL(format)), pitch, format);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+// Bad practice: You should use `sdl::surface` instead.
+inline void                                                    free_surface                          (native_surface* surface)
+{
+  SDL_FreeSurface(surface);
+}
+
+inline std::expected<void                       , std::string> lock_surface                          (native_surface* surface)
+{
+  if (SDL_LockSurface(surface) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline void                                                    unlock_surface                        (native_surface* surface)
+{
+  SDL_UnlockSurface(surface);
+}
+[[nodiscard]]
+inline bool                                                    must_lock                             (const native_surface* surface)
+{
+  return SDL_MUSTLOCK(surface);
+}
+
+[[nodiscard]]
+inline std::expected<native_surface*            , std::string> load_bmp_rw                           (native_rw_ops* ops, const bool free_source = false)
+{
+  auto result = SDL_LoadBMP_RW(ops, static_cast<std::int32_t>(free_source));
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void                       , std::string> save_bmp_rw                           (native_surface* surface, native_rw_ops* ops, const bool free_destination = false)
+{
+  if (SDL_SaveBMP_RW(surface, ops, static_cast<std::int32_t>(free_destination)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
+inline std::expected<void                       , std::string> set_surface_rle                       (native_surface* surface, const bool enabled)
+{
+  if (SDL_SetSurfaceRLE(surface, static_cast<std::int32_t>(enabled)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline bool                                                    has_surface_rle                       (native_surface* surface)
+{
+  return SDL_HasSurfaceRLE(surface) == SDL_TRUE;
+}
+
+inline std::expected<void                       , std::string> set_color_key                         (native_surface* surface, const bool enabled, const std::uint32_t key)
+{
+  if (SDL_SetColorKey(surface, static_cast<std::int32_t>(enabled), key) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline bool                                                    has_color_key                         (native_surface* surface)
+{
+  return SDL_HasColorKey(surface) == SDL_TRUE;
+}
+[[nodiscard]]
+inline std::expected<std::uint32_t              , std::string> get_color_key                         (native_surface* surface)
+{
+  std::uint32_t result;
+  if (SDL_GetColorKey(surface, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+
+inline std::expected<void                       , std::string> set_surface_color_mod                 (native_surface* surface, const std::array<std::uint8_t, 3>& color)
+{
+  if (SDL_SetSurfaceColorMod(surface, color[0], color[1], color[2]) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<std::array<std::uint8_t, 3>, std::string> get_surface_color_mod                 (native_surface* surface)
+{
+  std::array<std::uint8_t, 3> result;
+  if (SDL_GetSurfaceColorMod(surface, &result[0], &result[1], &result[2]) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void                       , std::string> set_surface_alpha_mod                 (native_surface* surface, const std::uint8_t alpha)
+{
+  if (SDL_SetSurfaceAlphaMod(surface, alpha) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<std::uint8_t               , std::string> get_surface_alpha_mod                 (native_surface* surface)
+{
+  std::uint8_t result;
+  if (SDL_GetSurfaceAlphaMod(surface, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void                       , std::string> set_surface_blend_mode                (native_surface* surface, const blend_mode mode)
+{
+  if (SDL_SetSurfaceBlendMode(surface, static_cast<SDL_BlendMode>(mode)) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+[[nodiscard]]
+inline std::expected<blend_mode                 , std::string> get_surface_blend_mode                (native_surface* surface)
+{
+  SDL_BlendMode result;
+  if (SDL_GetSurfaceBlendMode(surface, &result) < 0)
+    return std::unexpected(get_error());
+  return static_cast<blend_mode>(result);
+}
+
+// Returns false if the rectangle does not intersect the surface, in which case blits to the surface are skipped.
+inline bool                                                    set_clip_rect                         (native_surface* surface, const std::optional<native_rect>& rectangle = std::nullopt)
+{
+  return SDL_SetClipRect(surface, rectangle ? &rectangle.value() : nullptr) == SDL_TRUE;
+}
+[[nodiscard]]
+inline native_rect                                             get_clip_rect                         (native_surface* surface)
+{
+  native_rect result;
+  SDL_GetClipRect(surface, &result);
+  return result;
+}
+
+[[nodiscard]]
+inline std::expected<native_surface*            , std::string> duplicate_surface                     (native_surface* surface)
+{
+  auto result = SDL_DuplicateSurface(surface);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<native_surface*            , std::string> convert_surface                       (native_surface* surface, const native_pixel_format* format)
+{
+  auto result = SDL_ConvertSurface(surface, format, 0);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<native_surface*            , std::string> convert_surface_format                (native_surface* surface, const std::uint32_t format)
+{
+  auto result = SDL_ConvertSurfaceFormat(surface, format, 0);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+// The common format pairs (see `sdl::has_vectorized_pixel_conversion`) are converted with the vectorized kernels selected
+// for the CPU. The rest are converted by SDL.
+inline std::expected<void                       , std::string> convert_pixels                        (const std::array<std::int32_t, 2>& size, const std::uint32_t source_format, const void* source, const std::int32_t source_pitch, const std::uint32_t destination_format, void* destination, const std::int32_t destination_pitch)
+{
+  if (const auto kernels = get_pixel_conversion_kernels(); kernels && convert_pixels_vectorized(*kernels, size, source_format, source, source_pitch, destination_format, destination, destination_pitch))
+    return {};
+  if (SDL_ConvertPixels(size[0], size[1], source_format, source, source_pitch, destination_format, destination, destination_pitch) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
+// The rectangle is clipped to the clip rectangle of the surface. Fills the whole clip rectangle if no rectangle is given.
+inline std::expected<void                       , std::string> fill_rect                             (native_surface* surface, const std::optional<native_rect>& rectangle, const std::uint32_t color)
+{
+  if (SDL_FillRect(surface, rectangle ? &rectangle.value() : nullptr, color) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+inline std::expected<void                       , std::string> fill_rects                            (native_surface* surface, const std::span<const native_rect>& rectangles, const std::uint32_t color)
+{
+  if (SDL_FillRects(surface, rectangles.data(), static_cast<std::int32_t>(rectangles.size()), color) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
+// Only the position of the destination rectangle is used. Returns the destination rectangle after clipping.
+inline std::expected<native_rect                , std::string> blit_surface                          (native_surface* source, const std::optional<native_rect>& source_rectangle, native_surface* destination, const native_rect& destination_rectangle = {})
+{
+  auto result = destination_rectangle;
+  if (SDL_BlitSurface(source, source_rectangle ? &source_rectangle.value() : nullptr, destination, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+// Performs no clipping. You should use `sdl::blit_surface` unless the rectangles are known to be valid.
+inline std::expected<void                       , std::string> lower_blit                            (native_surface* source, native_rect& source_rectangle, native_surface* destination, native_rect& destination_rectangle)
+{
+  if (SDL_LowerBlit(source, &source_rectangle, destination, &destination_rectangle) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// Scales the source rectangle to the destination rectangle, or the whole destination if no rectangle is given.
+inline std::expected<native_rect                , std::string> blit_scaled                           (native_surface* source, const std::optional<native_rect>& source_rectangle, native_surface* destination, const std::optional<native_rect>& destination_rectangle = std::nullopt)
+{
+  auto result = destination_rectangle.value_or(native_rect {0, 0, destination->w, destination->h});
+  if (SDL_BlitScaled(source, source_rectangle ? &source_rectangle.value() : nullptr, destination, &result) < 0)
+    return std::unexpected(get_error());
+  return result;
+}
+// Performs no clipping. You should use `sdl::blit_scaled` unless the rectangles are known to be valid.
+inline std::expected<void                       , std::string> lower_blit_scaled                     (native_surface* source, native_rect& source_rectangle, native_surface* destination, native_rect& destination_rectangle)
+{
+  if (SDL_LowerBlitScaled(source, &source_rectangle, destination, &destination_rectangle) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// The surfaces must have the same format. Ignores the blend mode, color key and color modulation.
+inline std::expected<void                       , std::string> soft_stretch                          (native_surface* source, const std::optional<native_rect>& source_rectangle, native_surface* destination, const std::optional<native_rect>& destination_rectangle = std::nullopt)
+{
+  if (SDL_SoftStretch(source, source_rectangle ? &source_rectangle.value() : nullptr, destination, destination_rectangle ? &destination_rectangle.value() : nullptr) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// The surfaces must have the same format. Ignores the blend mode, color key and color modulation.
+inline std::expected<void                       , std::string> soft_stretch_linear                   (native_surface* source, const std::optional<native_rect>& source_rectangle, native_surface* destination, const std::optional<native_rect>& destination_rectangle = std::nullopt)
+{
+  if (SDL_SoftStretchLinear(source, source_rectangle ? &source_rectangle.value() : nullptr, destination, destination_rectangle ? &destination_rectangle.value() : nullptr) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
+inline void                                                    set_yuv_conversion_mode               (const yuv_conversion_mode mode)
+{
+  SDL_SetYUVConversionMode(static_cast<SDL_YUV_CONVERSION_MODE>(mode));
+}
+[[nodiscard]]
+inline yuv_conversion_mode                                     get_yuv_conversion_mode               ()
+{
+  return static_cast<yuv_conversion_mode>(SDL_GetYUVConversionMode());
+}
+[[nodiscard]]
+inline yuv_conversion_mode                                     get_yuv_conversion_mode_for_resolution(const std::array<std::int32_t, 2>& size)
+{
+  return static_cast<yuv_conversion_mode>(SDL_GetYUVConversionModeForResolution(size[0], size[1]));
+}
+
+// Conveniences.
+
+enum class surface_allocation
+{
+  sdl , // The pixels are allocated by SDL, with rows aligned to 4 bytes.
+  simd  // The pixels are allocated with `sdl::simd_alloc`, with rows aligned to `sdl::simd_get_alignment()`, so that each
+        // row may be processed with aligned vector loads and stores.
+};
+
 class surface
 {
 public:
+  // The constructor cannot transmit error state. You should use `sdl::make_surface(...)` to handle errors.
+  explicit surface  (const std::array<std::int32_t, 2>& size, const std::uint32_t format = SDL_PIXELFORMAT_ARGB8888, const surface_allocation allocation = surface_allocation::sdl)
+  {
+    if (allocation == surface_allocation::sdl)
+    {
+      native_ = create_rgb_surface_with_format(size, format).value_or(nullptr);
+      return;
+    }
+
+    if (size[0] < 0 || size[1] < 0 || is_pixel_format_fourcc(format))
+    {
+      set_error("Invalid size or pixel format for a SIMD-aligned surface.");
+      return;
+    }
+
+    // The bytes per pixel are 0 for formats with less than a byte per pixel (e.g. INDEX1, INDEX4), whose rows are the
+    // bits rounded up to bytes. The bits per pixel are not used otherwise, since they exclude the padding (e.g. RGB888).
+    const auto row_bytes = bytes_per_pixel(format) != 0
+      ? static_cast<std::size_t>(size[0]) * bytes_per_pixel(format)
+      : (static_cast<std::size_t>(size[0]) * bits_per_pixel(format) + 7) / 8;
+    const auto alignment = std::max<std::size_t>(simd_get_alignment(), 1);
+    const auto pitch     = (row_bytes + alignment - 1) / alignment * alignment;
+    const auto bytes     = std::max<std::size_t>(pitch * static_cast<std::size_t>(size[1]), 1);
+    if (pixels_ = simd_alloc(bytes); !pixels_)
+    {
+      set_error("Out of memory.");
+      return;
+    }
+    std::memset(pixels_, 0, bytes);
+
+    native_ = create_rgb_surface_with_format_from(pixels_, size, static_cast<std::int32_t>(pitch), format).value_or(nullptr);
+    if (!native_)
+    {
+      simd_free(pixels_);
+      pixels_ = nullptr;
+    }
+  }
+  // Wraps the pixels without copying. The pixels must outlive the surface. The constructor cannot transmit error state.
+  // You should use `sdl::make_surface(...)` to handle errors.
+  surface           (const std::span<std::byte>& pixels, const std::array<std::int32_t, 2>& size, const std::int32_t pitch, const std::uint32_t format = SDL_PIXELFORMAT_ARGB8888)
+  {
+    if (size[1] > 0 && pixels.size() < static_cast<std::size_t>(pitch) * static_cast<std::size_t>(size[1]))
+    {
+      set_error("The pixel buffer is smaller than pitch * height.");
+      return;
+    }
+    native_ = create_rgb_surface_with_format_from(pixels.data(), size, pitch, format).value_or(nullptr);
+  }
+  // Takes ownership of the native surface if managed, otherwise only references it.
+  explicit surface  (native_surface* native, const bool managed = true)
+  : native_(native), managed_(managed)
+  {
+
+  }
+  surface           (const surface&  that) = delete;
+  surface           (      surface&& temp) noexcept
+  : native_ (std::exchange(temp.native_ , nullptr))
+  , managed_(std::exchange(temp.managed_, false  ))
+  , pixels_ (std::exchange(temp.pixels_ , nullptr))
+  {
+
+  }
+ ~surface           ()
+  {
+    destroy();
+  }
+  surface& operator=(const surface&  that) = delete;
+  surface& operator=(      surface&& temp) noexcept
+  {
+    if (this != &temp)
+    {
+      destroy();
+
+      native_  = std::exchange(temp.native_ , nullptr);
+      managed_ = std::exchange(temp.managed_, false  );
+      pixels_  = std::exchange(temp.pixels_ , nullptr);
+    }
+    return *this;
+  }
+
+  std::expected<void                       , std::string> lock          () const
+  {
+    return lock_surface(native_);
+  }
+  void                                                    unlock        () const
+  {
+    unlock_surface(native_);
+  }
+  [[nodiscard]]
+  bool                                                    must_lock     () const
+  {
+    return sdl::must_lock(native_);
+  }
+
+  // The pixels of the surface, including the padding at the end of each row. Lock the surface beforehand if
+  // `must_lock()` is true.
   [[nodiscard]]
-  SDL_Surface* native() const noexcept
+  std::span<std::byte>                                    pixels        () const
+  {
+    return {static_cast<std::byte*>(native_->pixels), static_cast<std::size_t>(native_->pitch) * static_cast<std::size_t>(native_->h)};
+  }
+  // The pixels of the row, excluding the padding. The bits of formats with less than a byte per pixel (e.g. INDEX4) are
+  // rounded up to bytes, since their bytes per pixel are rounded up per pixel.
+  [[nodiscard]]
+  std::span<std::byte>                                    row           (const std::int32_t y) const
+  {
+    return {static_cast<std::byte*>(native_->pixels) + static_cast<std::size_t>(y) * static_cast<std::size_t>(native_->pitch), (static_cast<std::size_t>(native_->w) * native_->format->BitsPerPixel + 7) / 8};
+  }
+  [[nodiscard]]
+  std::array<std::int32_t, 2>                             size          () const
+  {
+    return {native_->w, native_->h};
+  }
+  [[nodiscard]]
+  std::int32_t                                            pitch         () const
+  {
+    return native_->pitch;
+  }
+  [[nodiscard]]
+  std::uint32_t                                           format        () const
+  {
+    return native_->format->format;
+  }
+  [[nodiscard]]
+  const native_pixel_format*                              pixel_format  () const
+  {
+    return native_->format;
+  }
+  [[nodiscard]]
+  surface_allocation                                      allocation    () const noexcept
+  {
+    return pixels_ ? surface_allocation::simd : surface_allocation::sdl;
+  }
+
+  // Maps the color to a pixel value of the format of the surface, e.g. for `fill` and `set_color_key`.
+  [[nodiscard]]
+  std::uint32_t                                           map_rgba      (const std::array<std::uint8_t, 4>& color) const
+  {
+    return sdl::map_rgba(native_->format, color);
+  }
+
+  // Blits the source rectangle (or the whole surface) to the position on the target. Returns the destination rectangle
+  // after clipping.
+  std::expected<native_rect                , std::string> blit          (const surface& target, const native_point& position = {}, const std::optional<native_rect>& source_rectangle = std::nullopt) const
+  {
+    return blit_surface(native_, source_rectangle, target.native_, native_rect {position.x, position.y, 0, 0});
+  }
+  std::expected<native_rect                , std::string> blit_scaled   (const surface& target, const std::optional<native_rect>& target_rectangle = std::nullopt, const std::optional<native_rect>& source_rectangle = std::nullopt) const
+  {
+    return sdl::blit_scaled(native_, source_rectangle, target.native_, target_rectangle);
+  }
+  std::expected<void                       , std::string> fill          (const std::uint32_t color, const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    return fill_rect (native_, rectangle , color);
+  }
+  std::expected<void                       , std::string> fill          (const std::uint32_t color, const std::span<const native_rect>& rectangles) const
+  {
+    return fill_rects(native_, rectangles, color);
+  }
+
+  // Pixels equal to the key are skipped while blitting. Disables the color key if none is given.
+  std::expected<void                       , std::string> set_color_key (const std::optional<std::uint32_t>& key) const
+  {
+    return sdl::set_color_key(native_, key.has_value(), key.value_or(0));
+  }
+  [[nodiscard]]
+  std::optional<std::uint32_t>                            color_key     () const
+  {
+    if (!has_color_key(native_))
+      return std::nullopt;
+    const auto result = get_color_key(native_);
+    return result ? std::optional(result.value()) : std::nullopt;
+  }
+  std::expected<void                       , std::string> set_color_mod (const std::array<std::uint8_t, 3>& color) const
+  {
+    return set_surface_color_mod(native_, color);
+  }
+  [[nodiscard]]
+  std::expected<std::array<std::uint8_t, 3>, std::string> color_mod     () const
+  {
+    return get_surface_color_mod(native_);
+  }
+  std::expected<void                       , std::string> set_alpha_mod (const std::uint8_t alpha) const
+  {
+    return set_surface_alpha_mod(native_, alpha);
+  }
+  [[nodiscard]]
+  std::expected<std::uint8_t               , std::string> alpha_mod     () const
+  {
+    return get_surface_alpha_mod(native_);
+  }
+  std::expected<void                       , std::string> set_blend_mode(const sdl::blend_mode mode) const
+  {
+    return set_surface_blend_mode(native_, mode);
+  }
+  [[nodiscard]]
+  std::expected<sdl::blend_mode            , std::string> blend_mode    () const
+  {
+    return get_surface_blend_mode(native_);
+  }
+  bool                                                    set_clip_rect (const std::optional<native_rect>& rectangle = std::nullopt) const
+  {
+    return sdl::set_clip_rect(native_, rectangle);
+  }
+  [[nodiscard]]
+  native_rect                                             clip_rect     () const
+  {
+    return get_clip_rect(native_);
+  }
+  std::expected<void                       , std::string> set_rle       (const bool enabled) const
+  {
+    return set_surface_rle(native_, enabled);
+  }
+  [[nodiscard]]
+  bool                                                    has_rle       () const
+  {
+    return has_surface_rle(native_);
+  }
+
+  // The converted surface is allocated by SDL. Surfaces without a color key or RLE encoding are converted with the
+  // vectorized kernels if available (see `sdl::convert_pixels`), and retain their attributes as in `SDL_ConvertSurface`.
+  [[nodiscard]]
+  std::expected<surface                    , std::string> convert       (const std::uint32_t format) const
+  {
+    // The cached format spares SDL from allocating and freeing the target format on each call.
+    const auto target = make_pixel_format(format);
+    if (!target)
+      return std::unexpected(target.error());
+
+    if (const auto kernels = get_pixel_conversion_kernels(); kernels && !has_color_key(native_) && !has_rle() && has_vectorized_pixel_conversion(this->format(), format))
+    {
+      surface result(size(), format);
+      if (!result.native_)
+        return std::unexpected(get_error());
+
+      const auto color = color_mod();
+      const auto alpha = alpha_mod();
+      const auto mode  = blend_mode();
+      if (!color || !alpha || !mode)
+        return std::unexpected(get_error());
+
+      convert_pixels_vectorized(*kernels, size(), this->format(), native_->pixels, pitch(), format, result.native_->pixels, result.pitch());
+      if (auto status = result.set_color_mod(color.value()); !status)
+        return std::unexpected(status.error());
+      if (auto status = result.set_alpha_mod(alpha.value()); !status)
+        return std::unexpected(status.error());
+      // SDL removes blending from the converted surface, and enables it again only if both formats have alpha or the alpha
+      // is modulated. The other blend modes are retained.
+      const auto blended = (is_pixel_format_alpha(this->format()) && is_pixel_format_alpha(format)) || alpha.value() != 255;
+      if (auto status = result.set_blend_mode(blended ? sdl::blend_mode::blend : mode.value() == sdl::blend_mode::blend ? sdl::blend_mode::none : mode.value()); !status)
+        return std::unexpected(status.error());
+      return result;
+    }
+
+    const auto result = convert_surface(native_, target->native());
+    if (!result)
+      return std::unexpected(result.error());
+    return surface(result.value());
+  }
+  [[nodiscard]]
+  std::expected<surface                    , std::string> duplicate     () const
+  {
+    const auto result = duplicate_surface(native_);
+    if (!result)
+      return std::unexpected(result.error());
+    return surface(result.value());
+  }
+  std::expected<void                       , std::string> save_bmp      (native_rw_ops* ops) const
+  {
+    return save_bmp_rw(native_, ops);
+  }
+
+  [[nodiscard]]
+  native_surface*                                         native        () const noexcept
   {
     return native_;
   }
 
 private:
-  SDL_Surface* native_ {};
+  void destroy()
+  {
+    if (native_ && managed_)
+      free_surface(native_);
+    if (pixels_)
+      simd_free(pixels_);
+    native_ = nullptr;
+    pixels_ = nullptr;
+  }
+
+  native_surface* native_  {};
+  bool            managed_ {true};
+  void*           pixels_  {}; // Owned pixels if allocated with `sdl::surface_allocation::simd`.
 };
+
+[[nodiscard]]
+inline std::expected<surface, std::string> make_surface(const std::array<std::int32_t, 2>& size, const std::uint32_t format = SDL_PIXELFORMAT_ARGB8888, const surface_allocation allocation = surface_allocation::sdl)
+{
+  surface result(size, format, allocation);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<surface, std::string> make_surface(const std::span<std::byte>& pixels, const std::array<std::int32_t, 2>& size, const std::int32_t pitch, const std::uint32_t format = SDL_PIXELFORMAT_ARGB8888)
+{
+  surface result(pixels, size, pitch, format);
+  if (!result.native())
+    return std::unexpected(get_error());
+  return result;
+}
+[[nodiscard]]
+inline std::expected<surface, std::string> make_surface(native_rw_ops* ops)
+{
+  const auto result = load_bmp_rw(ops);
+  if (!result)
+    return std::unexpected(result.error());
+  return surface(result.value());
+}
 }
\ No newline at end of file
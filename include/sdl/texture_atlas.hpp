@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sdl/blend_mode.hpp>
+#include <sdl/pixels.hpp>
+#include <sdl/rect.hpp>
+#include <sdl/rect_packer.hpp>
+#include <sdl/render.hpp>
+#include <sdl/surface.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a texture atlas which packs many small images into a few large
+// pages, so that sprites drawn from it share textures (and hence draw calls of `sdl::sprite_batch`).
+
+inline constexpr std::array<std::int32_t, 2> default_texture_atlas_page_size = {1024, 1024};
+
+struct atlas_region
+{
+  std::size_t             page;
+  rectangle<std::int32_t> area; // In pixels of the page, e.g. the source rectangle of a sprite.
+  rectangle<float>        uv  ; // Normalized to the size of the page.
+};
+
+// The images are packed with `sdl::rect_packer` into the pages, which are allocated as needed. Each image is surrounded
+// by transparent padding, so that linear filtering does not sample its neighbours. Removing an image frees its area for
+// later insertions, e.g. for glyph and icon caches which evict entries.
+//
+// The pages are kept as surfaces, and are uploaded to textures by `upload`, which only updates the areas modified since
+// the previous upload.
+class texture_atlas
+{
+public:
+  using handle = std::size_t;
+
+  explicit texture_atlas  (const std::array<std::int32_t, 2>& page_size = default_texture_atlas_page_size, const std::uint32_t format = SDL_PIXELFORMAT_ARGB8888, const std::int32_t padding = 1)
+  : page_size_(page_size), format_(format), padding_(std::max(padding, 0))
+  {
+
+  }
+  texture_atlas           (const texture_atlas&  that) = delete;
+  texture_atlas           (      texture_atlas&& temp) = default;
+  // The textures of the pages must be destroyed before their renderer.
+ ~texture_atlas           ()                           = default;
+  texture_atlas& operator=(const texture_atlas&  that) = delete;
+  texture_atlas& operator=(      texture_atlas&& temp) = default;
+
+  // Copies the source rectangle (or the whole image) into a page, converting it to the format of the atlas.
+  [[nodiscard]]
+  std::expected<handle, std::string>              insert      (const surface& image, const std::optional<native_rect>& source = std::nullopt)
+  {
+    const auto area = source.value_or(native_rect {0, 0, image.size()[0], image.size()[1]});
+    if (area.x < 0 || area.y < 0 || area.w <= 0 || area.h <= 0 || area.x + area.w > image.size()[0] || area.y + area.h > image.size()[1])
+      return std::unexpected("Invalid source rectangle.");
+
+    const auto region = allocate({area.w, area.h});
+    if (!region)
+      return std::unexpected(region.error());
+
+    auto& page = pages_[region->page];
+    const auto& target = region->area;
+    if (auto result = page.pixels.fill(0, padded(target)); !result)
+    {
+      release(region.value());
+      return std::unexpected(result.error());
+    }
+    if (auto result = image.lock(); !result)
+    {
+      release(region.value());
+      return std::unexpected(result.error());
+    }
+    const auto source_pixels = static_cast<const std::byte*>(image.native()->pixels) + static_cast<std::size_t>(area.y) * image.pitch() + static_cast<std::size_t>(area.x) * bytes_per_pixel(image.format());
+    const auto target_pixels = page.pixels.row(target.y).data() + static_cast<std::size_t>(target.x) * bytes_per_pixel(format_);
+    const auto result        = convert_pixels({area.w, area.h}, image.format(), source_pixels, image.pitch(), format_, target_pixels, page.pixels.pitch());
+    image.unlock();
+    if (!result)
+    {
+      release(region.value());
+      return std::unexpected(result.error());
+    }
+
+    page.dirty = page.dirty ? union_rect(page.dirty.value(), padded(target)) : padded(target);
+    return store(region.value());
+  }
+  // Inserts the images in order of decreasing height, which packs considerably tighter than arbitrary orders. Returns the
+  // handles in the order of the images. Images inserted before a failure remain in the atlas.
+  [[nodiscard]]
+  std::expected<std::vector<handle>, std::string> insert      (const std::span<const surface* const>& images)
+  {
+    std::vector<std::size_t> order(images.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    std::ranges::stable_sort(order, [&] (const std::size_t lhs, const std::size_t rhs)
+    {
+      return images[lhs]->size()[1] > images[rhs]->size()[1];
+    });
+
+    std::vector<handle> result(images.size());
+    for (const auto index : order)
+    {
+      const auto current = insert(*images[index]);
+      if (!current)
+        return std::unexpected(current.error());
+      result[index] = current.value();
+    }
+    return result;
+  }
+  // Frees the area of the image. The handle may be reused by later insertions.
+  void                                            erase       (const handle id)
+  {
+    release(regions_[id].value());
+    regions_[id].reset();
+    free_handles_.push_back(id);
+  }
+  // Removes all images. The pages and their textures are retained.
+  void                                            clear       ()
+  {
+    for (auto& page : pages_)
+      page.packer.clear();
+    regions_     .clear();
+    free_handles_.clear();
+  }
+
+  // Removes all images and the pages, destroying their textures, which must not be drawn afterwards. Unlike `clear`, this
+  // releases the memory of the atlas, at the cost of recreating the pages and textures on later insertions.
+  void                                            reset       ()
+  {
+    pages_       .clear();
+    regions_     .clear();
+    free_handles_.clear();
+  }
+
+  [[nodiscard]]
+  bool                                            contains    (const handle id) const
+  {
+    return id < regions_.size() && regions_[id].has_value();
+  }
+  [[nodiscard]]
+  const atlas_region&                             region      (const handle id) const
+  {
+    return regions_[id].value();
+  }
+
+  // Creates the textures of new pages and updates the modified areas of the others. Call before drawing the regions.
+  std::expected<void, std::string>                upload      (const renderer& renderer)
+  {
+    for (auto& page : pages_)
+    {
+      if (!page.texture)
+      {
+        auto texture = make_texture(renderer, page_size_, format_);
+        if (!texture)
+          return std::unexpected(texture.error());
+        if (auto result = texture->set_blend_mode(blend_mode::blend); !result)
+          return result;
+        page.texture = std::move(texture.value());
+        page.dirty   = native_rect {0, 0, page_size_[0], page_size_[1]};
+      }
+      if (page.dirty)
+      {
+        const auto& area = page.dirty.value();
+        if (auto result = page.texture->update(page.pixels.row(area.y).data() + static_cast<std::size_t>(area.x) * bytes_per_pixel(format_), page.pixels.pitch(), area); !result)
+          return result;
+        page.dirty.reset();
+      }
+    }
+    return {};
+  }
+
+  [[nodiscard]]
+  std::size_t                                     page_count  () const noexcept
+  {
+    return pages_.size();
+  }
+  [[nodiscard]]
+  const surface&                                  page_surface(const std::size_t page) const
+  {
+    return pages_[page].pixels;
+  }
+  // The texture of the page, or nullptr before the first `upload`.
+  [[nodiscard]]
+  native_texture*                                 page_texture(const std::size_t page) const
+  {
+    return pages_[page].texture ? pages_[page].texture->native() : nullptr;
+  }
+  [[nodiscard]]
+  const std::array<std::int32_t, 2>&              page_size   () const noexcept
+  {
+    return page_size_;
+  }
+  [[nodiscard]]
+  std::uint32_t                                   format      () const noexcept
+  {
+    return format_;
+  }
+  [[nodiscard]]
+  std::int32_t                                    padding     () const noexcept
+  {
+    return padding_;
+  }
+  // The number of images in the atlas.
+  [[nodiscard]]
+  std::size_t                                     size        () const noexcept
+  {
+    return regions_.size() - free_handles_.size();
+  }
+  // The ratio of the area of the images (including their padding) to the area of the pages.
+  [[nodiscard]]
+  double                                          occupancy   () const noexcept
+  {
+    if (pages_.empty())
+      return 0.0;
+    std::size_t used = 0;
+    for (const auto& page : pages_)
+      used += page.packer.used_area();
+    return static_cast<double>(used) / (static_cast<double>(page_size_[0]) * static_cast<double>(page_size_[1]) * static_cast<double>(pages_.size()));
+  }
+
+private:
+  struct page
+  {
+    surface                     pixels ;
+    rect_packer                 packer ;
+    std::optional<sdl::texture> texture{};
+    std::optional<native_rect>  dirty  {}; // The area modified since the last upload.
+  };
+
+  // The packer places the image with the padding to its right and bottom, in an area shrunk by the padding at the left and
+  // top. Hence each image is surrounded by the padding.
+  [[nodiscard]]
+  rectangle<std::int32_t>                         padded      (const rectangle<std::int32_t>& rectangle) const
+  {
+    return {rectangle.x - padding_, rectangle.y - padding_, rectangle.w + 2 * padding_, rectangle.h + 2 * padding_};
+  }
+  std::expected<atlas_region, std::string>        allocate    (const std::array<std::int32_t, 2>& size)
+  {
+    const std::array<std::int32_t, 2> padded_size {size[0] + padding_, size[1] + padding_};
+    for (std::size_t i = 0; i <= pages_.size(); ++i)
+    {
+      if (i == pages_.size())
+      {
+        if (padded_size[0] > page_size_[0] - padding_ || padded_size[1] > page_size_[1] - padding_)
+          return std::unexpected("The image is larger than a page.");
+        auto pixels = make_surface(page_size_, format_);
+        if (!pixels)
+          return std::unexpected(pixels.error());
+        pages_.push_back(page {std::move(pixels.value()), rect_packer({page_size_[0] - padding_, page_size_[1] - padding_})});
+      }
+      if (const auto placement = pages_[i].packer.insert(padded_size))
+      {
+        const rectangle<std::int32_t> area(placement->x + padding_, placement->y + padding_, size[0], size[1]);
+        return atlas_region
+        {
+          i,
+          area,
+          rectangle<float>(
+            static_cast<float>(area.x) / static_cast<float>(page_size_[0]),
+            static_cast<float>(area.y) / static_cast<float>(page_size_[1]),
+            static_cast<float>(area.w) / static_cast<float>(page_size_[0]),
+            static_cast<float>(area.h) / static_cast<float>(page_size_[1]))
+        };
+      }
+    }
+    return std::unexpected("The image is larger than a page.");
+  }
+  void                                            release     (const atlas_region& region)
+  {
+    const auto& area = region.area;
+    pages_[region.page].packer.erase(rectangle<std::int32_t>(area.x - padding_, area.y - padding_, area.w + padding_, area.h + padding_));
+  }
+  handle                                          store       (const atlas_region& region)
+  {
+    if (free_handles_.empty())
+    {
+      regions_.push_back(region);
+      return regions_.size() - 1;
+    }
+    const auto result = free_handles_.back();
+    free_handles_.pop_back();
+    regions_[result] = region;
+    return result;
+  }
+
+  std::array<std::int32_t, 2>              page_size_    ;
+  std::uint32_t                            format_       ;
+  std::int32_t                             padding_      ;
+  std::vector<page>                        pages_        {};
+  std::vector<std::optional<atlas_region>> regions_      {};
+  std::vector<handle>                      free_handles_ {};
+};
+}
\ No newline at end of file
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <sdl/endian.hpp>
+#include <sdl/error.hpp>
+#include <sdl/mapped_file.hpp>
+#include <sdl/rwops.hpp>
+
+namespace sdl
+{
+// Note: This header is not a part of SDL. It provides a read-only virtual file system over pack archives and loose files.
+//
+// Pack layout: A 24 byte header (magic, version, entry count, index offset), followed by the entry data, followed by the
+// index (per entry: 32-bit name length, name, 64-bit offset, 64-bit size). All values are little endian. Names are
+// relative paths with forward slashes.
+
+inline constexpr std::string_view default_pack_extension = ".pack";
+
+struct pack_entry
+{
+  std::string                name;
+  std::span<const std::byte> data;
+};
+
+// Writes a pack archive containing the entries to the native rw_ops.
+inline std::expected<void, std::string> write_pack(native_rw_ops* ops, const std::span<const pack_entry>& entries)
+{
+  const auto put = [ ] (std::vector<std::byte>& buffer, const std::integral auto value)
+  {
+    const auto swapped = byteswap_le(value);
+    const auto bytes   = reinterpret_cast<const std::byte*>(&swapped);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(swapped));
+  };
+
+  std::uint64_t          offset = 24;
+  std::vector<std::byte> index;
+  for (const auto& entry : entries)
+  {
+    put(index, static_cast<std::uint32_t>(entry.name.size()));
+    index.insert(index.end(), reinterpret_cast<const std::byte*>(entry.name.data()), reinterpret_cast<const std::byte*>(entry.name.data()) + entry.name.size());
+    put(index, offset);
+    put(index, static_cast<std::uint64_t>(entry.data.size()));
+    offset += entry.data.size();
+  }
+
+  std::vector<std::byte> header {std::byte{'S'}, std::byte{'D'}, std::byte{'L'}, std::byte{'P'}};
+  put(header, std::uint32_t {1});
+  put(header, static_cast<std::uint64_t>(entries.size()));
+  put(header, offset);
+
+  std::vector<std::span<const std::byte>> buffers {header};
+  for (const auto& entry : entries)
+    buffers.push_back(entry.data);
+  buffers.push_back(index);
+
+  const auto result = rw_write_v(ops, buffers);
+  if (!result)
+    return std::unexpected(result.error());
+  return {};
+}
+
+// Entries are kept in a sorted index. Mounting replaces existing entries with the same name, hence later mounts override
+// earlier ones. Packed entries are opened as windows over the mapped archive, which share the mapping instead of opening
+// the file again, and may be read concurrently.
+class vfs
+{
+public:
+  enum class entry_type
+  {
+    packed,
+    loose
+  };
+
+  struct entry
+  {
+    std::string   name  ;
+    entry_type    type  ;
+    std::size_t   source; // The index of the archive or the directory.
+    std::uint64_t offset;
+    std::uint64_t size  ;
+  };
+
+  vfs           ()                 = default;
+  vfs           (const vfs&  that) = delete;
+  vfs           (      vfs&& temp) = default;
+ ~vfs           ()                 = default;
+  vfs& operator=(const vfs&  that) = delete;
+  vfs& operator=(      vfs&& temp) = default;
+
+  // Mounts the pack archives in the directory in lexicographical order, followed by the loose files under it, which
+  // override the packed ones. Pack archives in its subdirectories are ignored. Pack archives are never exposed as loose
+  // files.
+  std::expected<void, std::string>                   mount_directory(const std::filesystem::path& directory, const std::string_view extension = default_pack_extension)
+  {
+    std::error_code                    error;
+    std::vector<std::filesystem::path> packs;
+    std::vector<entry>                 loose;
+
+    const auto directory_index = directories_.size();
+    for (auto iterator = std::filesystem::recursive_directory_iterator(directory, error); !error && iterator != std::filesystem::recursive_directory_iterator(); iterator.increment(error))
+    {
+      if (!iterator->is_regular_file(error))
+        continue;
+
+      const auto& path = iterator->path();
+      if (path.extension() == extension)
+      {
+        if (iterator.depth() == 0)
+          packs.push_back(path);
+      }
+      else
+        loose.push_back(entry {path.lexically_relative(directory).generic_string(), entry_type::loose, directory_index, 0, static_cast<std::uint64_t>(iterator->file_size(error))});
+    }
+    if (error)
+      return std::unexpected("Couldn't list " + directory.string() + ": " + error.message());
+
+    std::ranges::sort(packs);
+    for (const auto& pack : packs)
+      if (auto result = mount_pack(pack); !result)
+        return result;
+
+    directories_.push_back(directory);
+    merge(std::move(loose));
+    return {};
+  }
+  std::expected<void, std::string>                   mount_pack     (const std::filesystem::path& filepath)
+  {
+    auto file = make_mapped_file(filepath.string(), mapped_file_access::random);
+    if (!file)
+      return std::unexpected(file.error());
+
+    const auto data    = file->data();
+    const auto corrupt = [&] { return std::unexpected("Corrupt pack archive " + filepath.string() + "."); };
+    const auto get     = [&] <std::integral type> (std::size_t& offset, type& value)
+    {
+      if (data.size() < sizeof(type) || offset > data.size() - sizeof(type))
+        return false;
+      std::memcpy(&value, data.data() + offset, sizeof(type));
+      value   = byteswap_le(value);
+      offset += sizeof(type);
+      return true;
+    };
+
+    std::size_t   position = 4;
+    std::uint32_t version {};
+    std::uint64_t count   {}, index_offset {};
+    if (data.size() < 24 || std::memcmp(data.data(), "SDLP", 4) != 0 || !get(position, version) || version != 1 || !get(position, count) || !get(position, index_offset))
+      return corrupt();
+
+    std::vector<entry> entries;
+    position = static_cast<std::size_t>(index_offset);
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+      std::uint32_t name_size {};
+      if (!get(position, name_size) || name_size > data.size() - position)
+        return corrupt();
+
+      auto& current = entries.emplace_back(entry {std::string(reinterpret_cast<const char*>(data.data()) + position, name_size), entry_type::packed, archives_.size(), 0, 0});
+      position += name_size;
+      if (!get(position, current.offset) || !get(position, current.size) || current.offset > data.size() || current.size > data.size() - current.offset)
+        return corrupt();
+    }
+
+    archives_.push_back(std::make_shared<const mapped_file>(std::move(file.value())));
+    merge(std::move(entries));
+    return {};
+  }
+  void                                               unmount_all    ()
+  {
+    entries_    .clear();
+    archives_   .clear();
+    directories_.clear();
+  }
+
+  [[nodiscard]]
+  const entry*                                       find           (const std::string_view name) const
+  {
+    const auto iterator = std::ranges::lower_bound(entries_, name, { }, &entry::name);
+    if (iterator == entries_.end() || iterator->name != name)
+      return nullptr;
+    return &*iterator;
+  }
+  [[nodiscard]]
+  bool                                               exists         (const std::string_view name) const
+  {
+    return find(name) != nullptr;
+  }
+  // The entries whose names start with the prefix, e.g. "textures/".
+  [[nodiscard]]
+  std::span<const entry>                             list           (const std::string_view prefix = { }) const
+  {
+    const auto first = std::ranges::lower_bound(entries_, prefix, { }, &entry::name);
+    const auto last  = std::find_if(first, entries_.end(), [&] (const entry& value) { return !value.name.starts_with(prefix); });
+    return {first, last};
+  }
+  [[nodiscard]]
+  const std::vector<entry>&                          entries        () const noexcept
+  {
+    return entries_;
+  }
+
+  [[nodiscard]]
+  std::expected<rw_ops, std::string>                 open           (const std::string_view name) const
+  {
+    const auto current = find(name);
+    if (!current)
+      return std::unexpected("No such entry: " + std::string(name) + ".");
+
+    if (current->type == entry_type::loose)
+      return make_rw_ops((directories_[current->source] / current->name).string(), "rb");
+    return make_rw_ops(std::make_unique<mapped_file_source>(archives_[current->source], current->offset, current->size));
+  }
+  // Packed entries are returned without copying as long as the vfs is alive.
+  [[nodiscard]]
+  std::expected<std::span<const std::byte>, std::string> data       (const std::string_view name) const
+  {
+    const auto current = find(name);
+    if (!current)
+      return std::unexpected("No such entry: " + std::string(name) + ".");
+    if (current->type == entry_type::loose)
+      return std::unexpected(std::string(name) + " is not packed.");
+    return archives_[current->source]->data().subspan(current->offset, current->size);
+  }
+
+private:
+  void merge(std::vector<entry>&& entries)
+  {
+    // The stable sort keeps the new entries after the existing ones with the same name, and the last one is retained.
+    entries_.insert(entries_.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+    std::ranges::stable_sort(entries_, { }, &entry::name);
+
+    auto target = entries_.begin();
+    for (auto iterator = entries_.begin(); iterator != entries_.end(); ++iterator)
+    {
+      if (std::next(iterator) != entries_.end() && std::next(iterator)->name == iterator->name)
+        continue;
+      if (target != iterator)
+        *target = std::move(*iterator);
+      ++target;
+    }
+    entries_.erase(target, entries_.end());
+  }
+
+  std::vector<entry>                              entries_     ;
+  std::vector<std::shared_ptr<const mapped_file>> archives_    ;
+  std::vector<std::filesystem::path>              directories_ ;
+};
+}
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <expected>
+#include <span>
 #include <string>
 
 #include <SDL_syswm.h>
 #include <SDL_video.h>
 #include <SDL_shape.h>
 
+#include <sdl/error.hpp>
+#include <sdl/rect.hpp>
 #include <sdl/surface.hpp>
 
 namespace sdl
@@ -16,6 +20,29 @@ using window_shape_mode = SDL_WindowShapeMode;
 
 using native_window     = SDL_Window;
 
+// The surface is owned by the window, and is invalidated when the window is resized.
+[[nodiscard]]
+inline std::expected<native_surface*, std::string> get_window_surface         (native_window* window)
+{
+  auto result = SDL_GetWindowSurface(window);
+  if (!result)
+    return std::unexpected(get_error());
+  return result;
+}
+inline std::expected<void           , std::string> update_window_surface      (native_window* window)
+{
+  if (SDL_UpdateWindowSurface(window) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+// Copies only the rectangles of the window surface to the screen, e.g. the ones accumulated by `sdl::dirty_region`.
+inline std::expected<void           , std::string> update_window_surface_rects(native_window* window, const std::span<const native_rect>& rectangles)
+{
+  if (SDL_UpdateWindowSurfaceRects(window, rectangles.data(), static_cast<std::int32_t>(rectangles.size())) < 0)
+    return std::unexpected(get_error());
+  return {};
+}
+
 class window
 {
 public:
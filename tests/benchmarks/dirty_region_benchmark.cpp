@@ -0,0 +1,60 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sdl/dirty_region.hpp>
+#include <sdl/surface.hpp>
+
+#include "internal/measure.hpp"
+
+namespace
+{
+constexpr std::int32_t width      = 1920;
+constexpr std::int32_t height     = 1080;
+constexpr std::size_t  iterations = 20;
+}
+
+TEST_CASE("Dirty Region Benchmark")
+{
+  // A kiosk UI: a grid of widgets of which a few change per frame.
+  std::vector<sdl::native_rect> widgets;
+  for (std::int32_t y = 0; y < 8; ++y)
+    for (std::int32_t x = 0; x < 8; ++x)
+      widgets.push_back({x * 240 + 8, y * 135 + 8, 224, 119});
+
+  auto         frame     = sdl::make_surface({width, height}).value();
+  const auto   draw      = [&]
+  {
+    REQUIRE(frame.fill(frame.map_rgba({32, 32, 32, 255})).has_value());
+    for (std::size_t i = 0; i < widgets.size(); ++i)
+      REQUIRE(frame.fill(frame.map_rgba({static_cast<std::uint8_t>(i * 4), 128, 192, 255}), widgets[i]).has_value());
+  };
+  std::mt19937 generator(11);
+
+  measure("Full redraw", "frame", iterations, draw);
+
+  for (const auto changed : {1, 4, 16})
+    for (const auto threshold : {0.0, 0.5, 1.0})
+    {
+      sdl::dirty_region region(sdl::native_rect {0, 0, width, height}, threshold);
+      std::size_t       area = 0;
+      measure("Dirty redraw, " + std::to_string(changed) + " changed widgets, threshold " + std::to_string(threshold), "frame", iterations, [&]
+      {
+        region.clear();
+        for (std::int32_t i = 0; i < changed; ++i)
+          region.add(widgets[generator() % widgets.size()]);
+        REQUIRE(region.draw(frame, [&] (const sdl::rectangle<std::int32_t>&) -> std::expected<void, std::string>
+        {
+          draw();
+          return {};
+        }).has_value());
+        area += region.area();
+      });
+      MESSAGE("  " << region.rectangles().size() << " rectangles, " << static_cast<double>(area) / (iterations + 1) / (width * height) * 100.0 << "% of the frame redrawn");
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <vector>
+
+#include <sdl/bitmap_font.hpp>
+#include <sdl/glyph_cache.hpp>
+#include <sdl/render.hpp>
+#include <sdl/rwops.hpp>
+#include <sdl/sprite_batch.hpp>
+#include <sdl/surface.hpp>
+
+#include "internal/measure.hpp"
+
+namespace
+{
+constexpr std::size_t iterations = 100;
+
+// A monospaced font of the printable ASCII characters, on a grid of 16 x 6 cells of 12 x 16 pixels.
+sdl::bitmap_font make_font()
+{
+  std::string descriptor = "info face=\"Grid\" size=16\ncommon lineHeight=18 base=13 pages=1\npage id=0 file=\"grid.bmp\"\n";
+  for (std::int32_t codepoint = 32; codepoint < 128; ++codepoint)
+    descriptor += "char id=" + std::to_string(codepoint) + " x=" + std::to_string((codepoint - 32) % 16 * 12) + " y=" + std::to_string((codepoint - 32) / 16 * 16) + " width=12 height=16 xoffset=0 yoffset=0 xadvance=12 page=0\n";
+
+  auto ops = sdl::make_rw_ops(std::as_bytes(std::span(descriptor.data(), descriptor.size()))).value();
+  return sdl::load_bitmap_font(ops, [ ] (const std::string&) -> std::expected<sdl::surface, std::string>
+  {
+    auto page = sdl::make_surface({192, 96});
+    if (page)
+      static_cast<void>(page->fill(page->map_rgba({255, 255, 255, 255})));
+    return page;
+  }).value();
+}
+}
+
+TEST_CASE("Glyph Cache Benchmark")
+{
+  const auto  font = make_font();
+  std::string text;
+  for (std::size_t i = 0; i < 40; ++i)
+    text += "The quick brown fox jumps over the lazy dog, 0123456789 times. ";
+
+  auto target   = sdl::make_surface({1920, 1080}).value();
+  auto renderer = sdl::make_renderer(target).value();
+
+  // First time: every glyph of a new size is rasterized (scaled) and inserted into the atlas.
+  {
+    sdl::glyph_cache         cache;
+    sdl::text_style          style;
+    std::vector<sdl::sprite> sprites;
+    style.font      = cache.add_font(font);
+    style.max_width = 1920.0f;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (std::int32_t size = 8; size < 8 + static_cast<std::int32_t>(iterations) / 10; ++size)
+    {
+      style.size = size;
+      sprites.clear();
+      REQUIRE(sdl::layout_text(cache, renderer, text, {0.0f, 0.0f}, style, sprites).has_value());
+    }
+    MESSAGE("Layout with new sizes: " << seconds_since(start) * 1000.0 / (iterations / 10) << " ms per " << text.size() << " characters (" << cache.size() << " glyphs cached)");
+  }
+
+  // Cached: the glyphs are looked up, and only the sprites are generated.
+  {
+    sdl::glyph_cache         cache;
+    sdl::text_style          style;
+    std::vector<sdl::sprite> sprites;
+    style.font      = cache.add_font(font);
+    style.size      = 20;
+    style.max_width = 1920.0f;
+    REQUIRE(sdl::layout_text(cache, renderer, text, {0.0f, 0.0f}, style, sprites).has_value());
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      sprites.clear();
+      REQUIRE(sdl::layout_text(cache, renderer, text, {0.0f, 0.0f}, style, sprites).has_value());
+    }
+    MESSAGE("Layout with cached glyphs: " << seconds_since(start) * 1000.0 / iterations << " ms per " << text.size() << " characters (hit rate " << static_cast<double>(cache.statistics().hits) / static_cast<double>(cache.statistics().hits + cache.statistics().misses) << ")");
+
+    // Drawing the laid out text through a batch, i.e. in a single draw call per page.
+    sdl::sprite_batch batch;
+    const auto        draw_start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      batch.draw(sprites);
+      REQUIRE(batch.flush(renderer).has_value());
+    }
+    MESSAGE("Draw with sprite batch: " << seconds_since(draw_start) * 1000.0 / iterations << " ms per " << sprites.size() << " glyphs in " << batch.statistics().draw_calls << " draw calls");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <doctest/doctest.h>
+
+// The seconds elapsed since the given time point.
+inline double seconds_since(const std::chrono::high_resolution_clock::time_point& start)
+{
+  return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Runs the function once to warm up, then reports the mean of the given number of runs in milliseconds per unit.
+inline void   measure      (const std::string& name, const std::string& unit, const std::size_t iterations, const std::function<void()>& function)
+{
+  function(); // Warm up.
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+    function();
+  MESSAGE(name << ": " << seconds_since(start) * 1000.0 / static_cast<double>(iterations) << " ms per " << unit);
+}
\ No newline at end of file
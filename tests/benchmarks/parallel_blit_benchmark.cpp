@@ -0,0 +1,45 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <sdl/parallel_blit.hpp>
+#include <sdl/surface.hpp>
+
+#include "internal/measure.hpp"
+
+namespace
+{
+constexpr std::int32_t width      = 3840;
+constexpr std::int32_t height     = 2160;
+constexpr std::size_t  iterations = 20;
+}
+
+TEST_CASE("Parallel Blit Benchmark")
+{
+  auto source = sdl::make_surface({width, height}).value();
+  auto target = sdl::make_surface({width, height}).value();
+  for (std::int32_t y = 0; y < height; ++y)
+    for (std::size_t x = 0; x < source.row(y).size(); ++x)
+      source.row(y)[x] = static_cast<std::byte>(x * 31 + static_cast<std::size_t>(y));
+
+  for (const auto mode : {sdl::blend_mode::none, sdl::blend_mode::blend})
+  {
+    REQUIRE(source.set_blend_mode(mode).has_value());
+    const std::string suffix = mode == sdl::blend_mode::none ? " (copy)" : " (blend)";
+
+    measure("Serial blit" + suffix, "blit", iterations, [&]
+    {
+      REQUIRE(source.blit(target).has_value());
+    });
+    for (const std::size_t thread_count : {2, 4, 8, 16})
+    {
+      auto blitter = sdl::make_parallel_blitter(thread_count).value();
+      measure("Parallel blit, " + std::to_string(thread_count) + " threads" + suffix, "blit", iterations, [&]
+      {
+        REQUIRE(blitter->blit(source, target).has_value());
+      });
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <sdl/pixel_conversion.hpp>
+#include <sdl/pixels.hpp>
+#include <sdl/surface.hpp>
+
+namespace
+{
+constexpr std::int32_t width      = 1920;
+constexpr std::int32_t height     = 1080;
+constexpr std::size_t  iterations = 20;
+
+// Returns the throughput in megapixels per second.
+double measure(const std::function<void()>& function)
+{
+  function(); // Warm up.
+
+  const auto start   = std::chrono::high_resolution_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+    function();
+  const auto seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+  return static_cast<double>(width) * height * iterations / seconds / 1e6;
+}
+}
+
+TEST_CASE("Pixel Conversion Benchmark")
+{
+  std::vector<const sdl::pixel_conversion_kernels*> kernels {&sdl::pixel_conversion_kernels_scalar};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  if (sdl::has_sse2 ())
+    kernels.push_back(&sdl::pixel_conversion_kernels_sse2 );
+  if (sdl::has_sse41())
+    kernels.push_back(&sdl::pixel_conversion_kernels_ssse3);
+  if (sdl::has_avx2 ())
+    kernels.push_back(&sdl::pixel_conversion_kernels_avx2 );
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+  if (sdl::has_neon ())
+    kernels.push_back(&sdl::pixel_conversion_kernels_neon );
+#endif
+
+  const std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs
+  {
+    {SDL_PIXELFORMAT_RGB24   , SDL_PIXELFORMAT_ARGB8888},
+    {SDL_PIXELFORMAT_BGR24   , SDL_PIXELFORMAT_ABGR8888},
+    {SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_ARGB8888},
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888},
+    {SDL_PIXELFORMAT_IYUV    , SDL_PIXELFORMAT_ARGB8888},
+    {SDL_PIXELFORMAT_YV12    , SDL_PIXELFORMAT_ABGR8888},
+    {SDL_PIXELFORMAT_NV12    , SDL_PIXELFORMAT_ARGB8888},
+    {SDL_PIXELFORMAT_NV21    , SDL_PIXELFORMAT_ARGB8888}
+  };
+
+  char cell[64];
+  std::snprintf(cell, sizeof cell, "%-24s %8s", "Format pair (MPixel/s)", "SDL");
+  std::string header = cell;
+  for (const auto current : kernels)
+  {
+    std::snprintf(cell, sizeof cell, " %10s", current->name);
+    header += cell;
+  }
+  MESSAGE(header);
+
+  for (const auto& [source_format, destination_format] : pairs)
+  {
+    const auto yuv          = sdl::is_yuv_420_format(source_format);
+    const auto source_pitch = yuv ? width : width * static_cast<std::int32_t>(sdl::bytes_per_pixel(source_format));
+    const auto source_size  = yuv ? static_cast<std::size_t>(width) * height * 3 / 2 : static_cast<std::size_t>(source_pitch) * height;
+
+    std::vector<std::uint8_t> source     (source_size);
+    std::vector<std::uint8_t> destination(static_cast<std::size_t>(width) * height * 4);
+    for (std::size_t i = 0; i < source.size(); ++i)
+      source[i] = static_cast<std::uint8_t>(i * 7919);
+
+    std::snprintf(cell, sizeof cell, "%-10s -> %-10s", sdl::get_pixel_format_name(source_format).c_str() + 16, sdl::get_pixel_format_name(destination_format).c_str() + 16);
+    std::string line = cell;
+
+    const auto baseline = measure([&]
+    {
+      SDL_ConvertPixels(width, height, source_format, source.data(), source_pitch, destination_format, destination.data(), width * 4);
+    });
+    std::snprintf(cell, sizeof cell, " %8.1f", baseline);
+    line += cell;
+
+    for (const auto current : kernels)
+    {
+      const auto throughput = measure([&]
+      {
+        REQUIRE(sdl::convert_pixels_vectorized(*current, {width, height}, source_format, source.data(), source_pitch, destination_format, destination.data(), width * 4));
+      });
+      std::snprintf(cell, sizeof cell, " %10.1f", throughput);
+      line += cell;
+    }
+    MESSAGE(line);
+  }
+}
\ No newline at end of file
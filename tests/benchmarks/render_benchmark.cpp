@@ -0,0 +1,68 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sdl/render.hpp>
+#include <sdl/sprite_batch.hpp>
+#include <sdl/surface.hpp>
+
+#include "internal/measure.hpp"
+
+namespace
+{
+constexpr std::int32_t width        = 1920;
+constexpr std::int32_t height       = 1080;
+constexpr std::size_t  sprite_count = 10000;
+constexpr std::size_t  iterations   = 20;
+}
+
+TEST_CASE("Render Benchmark")
+{
+  // The software renderer works on a headless machine.
+  auto target   = sdl::make_surface({width, height}).value();
+  auto renderer = sdl::make_renderer(target).value();
+
+  std::mt19937 generator(3);
+  std::vector<sdl::texture> textures;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    auto image = sdl::make_surface({32, 32}).value();
+    for (std::int32_t y = 0; y < 32; ++y)
+      for (auto& value : image.row(y))
+        value = static_cast<std::byte>(generator());
+    textures.push_back(sdl::make_texture(renderer, image).value());
+  }
+
+  // Sprites of interleaved textures, as e.g. the tiles and entities of a scene in drawing order.
+  std::vector<sdl::sprite> sprites;
+  for (std::size_t i = 0; i < sprite_count; ++i)
+    sprites.push_back(sdl::sprite
+    {
+      textures[i % textures.size()].native(),
+      sdl::native_frect {static_cast<float>(generator() % (width - 32)), static_cast<float>(generator() % (height - 32)), 32.0f, 32.0f},
+      sdl::native_rect  {0, 0, 16 + static_cast<std::int32_t>(generator() % 16), 16 + static_cast<std::int32_t>(generator() % 16)}
+    });
+
+  measure("SDL_RenderCopy per sprite", "frame", iterations, [&]
+  {
+    for (const auto& sprite : sprites)
+      REQUIRE(sdl::render_copy_f(renderer.native(), sprite.texture, sprite.source, sprite.destination).has_value());
+    renderer.present();
+  });
+
+  for (const auto mode : {sdl::sprite_sort_mode::deferred, sdl::sprite_sort_mode::texture})
+  {
+    sdl::sprite_batch batch(mode, sprite_count);
+    measure(mode == sdl::sprite_sort_mode::deferred ? "Sprite batch (deferred)" : "Sprite batch (sorted by texture)", "frame", iterations, [&]
+    {
+      batch.draw(sprites);
+      REQUIRE(batch.flush(renderer).has_value());
+      renderer.present();
+    });
+    MESSAGE("  " << batch.statistics().draw_calls << " draw calls for " << batch.statistics().sprites << " sprites");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <sdl/buffered_rw_ops.hpp>
+#include <sdl/rwops.hpp>
+
+namespace
+{
+constexpr std::size_t file_size  = 1024ull * 1024ull * 1024ull;
+constexpr std::size_t chunk_size = 1024ull * 1024ull;
+
+template <typename function_type>
+void measure(const std::string& name, function_type&& function)
+{
+  const auto start    = std::chrono::high_resolution_clock::now();
+  const auto checksum = function();
+  const auto seconds  = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+  MESSAGE(name << ": " << seconds << " s, " << (static_cast<double>(file_size) / (1024.0 * 1024.0)) / seconds << " MiB/s (checksum " << checksum << ")");
+}
+}
+
+TEST_CASE("RW Ops Benchmark")
+{
+  const auto filepath = (std::filesystem::temp_directory_path() / "sdl_rwops_benchmark.bin").string();
+  {
+    std::vector<std::uint32_t> chunk(chunk_size / sizeof(std::uint32_t));
+    std::iota(chunk.begin(), chunk.end(), 0u);
+
+    auto file = sdl::make_rw_ops(filepath, "wb");
+    REQUIRE(file.has_value());
+    for (std::size_t i = 0; i < file_size / chunk_size; ++i)
+      REQUIRE(file->write(chunk.data(), sizeof(std::uint32_t), chunk.size()).has_value());
+  }
+
+  constexpr auto count = file_size / sizeof(std::uint32_t);
+
+  SUBCASE("read_le32")
+  {
+    auto raw = sdl::make_rw_ops(filepath, "rb");
+    REQUIRE(raw.has_value());
+    measure("Raw rw_ops, native read_le32", [&]
+    {
+      std::uint64_t checksum {};
+      for (std::size_t i = 0; i < count; ++i)
+        checksum += sdl::read_le32(raw->native()).value_or(0);
+      return checksum;
+    });
+
+    for (const auto buffer_size : {std::size_t(4 * 1024), std::size_t(64 * 1024), std::size_t(1024 * 1024)})
+    {
+      const auto suffix = " (" + std::to_string(buffer_size / 1024) + " KiB)";
+
+      auto file = sdl::make_rw_ops(filepath, "rb");
+      REQUIRE(file.has_value());
+      auto native_buffered = sdl::make_buffered_rw_ops(file->native(), buffer_size);
+      REQUIRE(native_buffered.has_value());
+      measure("Buffered rw_ops" + suffix + ", native read_le32", [&]
+      {
+        std::uint64_t checksum {};
+        for (std::size_t i = 0; i < count; ++i)
+          checksum += sdl::read_le32(native_buffered->native()).value_or(0);
+        return checksum;
+      });
+
+      REQUIRE(file->seek(0).has_value());
+      auto buffered = sdl::make_buffered_rw_ops(file->native(), buffer_size);
+      REQUIRE(buffered.has_value());
+      measure("Buffered rw_ops" + suffix + ", direct read_le_integer", [&]
+      {
+        std::uint64_t checksum {};
+        for (std::size_t i = 0; i < count; ++i)
+          checksum += buffered->read_le_integer<std::uint32_t>().value_or(0);
+        return checksum;
+      });
+    }
+  }
+
+  SUBCASE("write_le32")
+  {
+    const auto output_filepath = filepath + ".out";
+    {
+      auto raw = sdl::make_rw_ops(output_filepath, "wb");
+      REQUIRE(raw.has_value());
+      measure("Raw rw_ops, native write_le32", [&]
+      {
+        std::uint64_t checksum {};
+        for (std::size_t i = 0; i < count; ++i)
+          checksum += sdl::write_le32(raw->native(), static_cast<std::uint32_t>(i)).has_value();
+        return checksum;
+      });
+    }
+    {
+      auto file = sdl::make_rw_ops(output_filepath, "wb");
+      REQUIRE(file.has_value());
+      auto buffered = sdl::make_buffered_rw_ops(file->native());
+      REQUIRE(buffered.has_value());
+      measure("Buffered rw_ops (64 KiB), direct write_le_integer", [&]
+      {
+        std::uint64_t checksum {};
+        for (std::size_t i = 0; i < count; ++i)
+          checksum += buffered->write_le_integer(static_cast<std::uint32_t>(i)).has_value();
+        checksum += buffered->flush().has_value();
+        return checksum;
+      });
+    }
+    std::remove(output_filepath.c_str());
+  }
+
+  std::remove(filepath.c_str());
+}
\ No newline at end of file
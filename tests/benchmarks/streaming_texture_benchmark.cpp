@@ -0,0 +1,78 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sdl/render.hpp>
+#include <sdl/streaming_texture.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/thread.hpp>
+
+#include "internal/measure.hpp"
+
+namespace
+{
+constexpr std::int32_t width      = 1920;
+constexpr std::int32_t height     = 1080;
+constexpr std::size_t  iterations = 100;
+}
+
+TEST_CASE("Streaming Texture Benchmark")
+{
+  auto target   = sdl::make_surface({width, height}).value();
+  auto renderer = sdl::make_renderer(target).value();
+
+  // The baseline: the producer decodes into memory, and the render thread uploads it with `SDL_UpdateTexture`.
+  {
+    auto                   texture = sdl::make_texture(renderer, {width, height}, SDL_PIXELFORMAT_ARGB8888, sdl::texture_access::streaming).value();
+    std::vector<std::byte> frame(static_cast<std::size_t>(width) * height * 4, std::byte {0x7F});
+    measure("Update texture", "frame on the render thread", iterations, [&]
+    {
+      REQUIRE(texture.update(frame.data(), width * 4).has_value());
+    });
+  }
+
+  // The ring: the producer decodes into the mapped textures, and the render thread only unlocks and locks them.
+  for (const auto mode : {sdl::streaming_mode::mailbox, sdl::streaming_mode::fifo})
+  {
+    auto              stream  = sdl::make_streaming_texture_ring(renderer, {width, height}, SDL_PIXELFORMAT_ARGB8888, 3, mode).value();
+    std::atomic<bool> running {true};
+    {
+      auto producer = sdl::make_thread([&]
+      {
+        while (running)
+          if (const auto frame = stream->begin_write(std::chrono::milliseconds(10)))
+          {
+            for (std::int32_t y = 0; y < frame->size[1]; ++y)
+              std::memset(static_cast<std::byte*>(frame->pixels) + y * frame->pitch, 0x7F, static_cast<std::size_t>(frame->size[0]) * 4);
+            stream->end_write(frame.value());
+          }
+        return 0;
+      }, "streaming_texture_producer");
+      REQUIRE(producer.has_value());
+
+      // The render thread draws at about 250 frames per second. Only the time spent in `update` is measured.
+      std::chrono::duration<double> elapsed {};
+      for (std::size_t i = 0; i < iterations; ++i)
+      {
+        const auto start = std::chrono::high_resolution_clock::now();
+        REQUIRE(stream->update().has_value());
+        elapsed += std::chrono::high_resolution_clock::now() - start;
+        std::this_thread::sleep_for(std::chrono::milliseconds(4));
+      }
+      MESSAGE("Streaming texture ring (" << (mode == sdl::streaming_mode::mailbox ? "mailbox" : "fifo") << "): " << elapsed.count() * 1000.0 / iterations << " ms per frame on the render thread");
+
+      running = false;
+      stream->close();
+    }
+
+    const auto statistics = stream->statistics();
+    MESSAGE("  " << statistics.submitted << " submitted, " << statistics.displayed << " displayed, " << statistics.dropped << " dropped, " << statistics.starved << " starved, " << statistics.average_latency.count() << " us average latency, " << statistics.maximum_latency.count() << " us maximum latency");
+  }
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <sdl/rect_packer.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/texture_atlas.hpp>
+
+#include "internal/measure.hpp"
+
+namespace
+{
+constexpr std::array<std::int32_t, 2> bin_size {2048, 2048};
+
+// Sizes of glyphs and icons.
+std::vector<std::array<std::int32_t, 2>> make_sizes(const std::size_t count, const std::uint32_t seed)
+{
+  std::mt19937                             generator(seed);
+  std::vector<std::array<std::int32_t, 2>> result(count);
+  for (auto& size : result)
+    size = {static_cast<std::int32_t>(6 + generator() % 42), static_cast<std::int32_t>(10 + generator() % 38)};
+  return result;
+}
+}
+
+TEST_CASE("Texture Atlas Benchmark")
+{
+  // Packing efficiency: the occupancy of the bin at the first rectangle which does not fit.
+  for (const auto sorted : {false, true})
+  {
+    auto sizes = make_sizes(10000, 1);
+    if (sorted)
+      std::ranges::stable_sort(sizes, [ ] (const auto& lhs, const auto& rhs) { return lhs[1] > rhs[1]; });
+
+    sdl::rect_packer packer(bin_size);
+    std::size_t      count = 0;
+    const auto       start = std::chrono::high_resolution_clock::now();
+    for (const auto& size : sizes)
+    {
+      if (!packer.insert(size))
+        break;
+      ++count;
+    }
+    const auto seconds = seconds_since(start);
+    MESSAGE("Rect packer (" << (sorted ? "sorted by height" : "random order") << "): " << count << " rectangles, " << packer.occupancy() * 100.0 << "% occupancy, " << count / seconds / 1000.0 << " k insertions/s");
+  }
+
+  // Cache churn: evicting a random rectangle and inserting another, at about 75% occupancy.
+  {
+    const auto                                sizes = make_sizes(200000, 2);
+    std::mt19937                              generator(3);
+    sdl::rect_packer                          packer(bin_size);
+    std::vector<sdl::rectangle<std::int32_t>> placed;
+    std::size_t                               next  = 0;
+    while (packer.occupancy() < 0.75)
+      placed.push_back(packer.insert(sizes[next++]).value());
+
+    std::size_t failures  = 0;
+    const auto  start     = std::chrono::high_resolution_clock::now();
+    const auto  first     = next;
+    for (; next < sizes.size() && next - first < 20000; ++next)
+    {
+      const auto index = generator() % placed.size();
+      packer.erase(placed[index]);
+      placed[index] = placed.back();
+      placed.pop_back();
+      if (const auto result = packer.insert(sizes[next]))
+        placed.push_back(result.value());
+      else
+        ++failures;
+    }
+    const auto seconds = seconds_since(start);
+    MESSAGE("Rect packer churn: " << (next - first) / seconds / 1000.0 << " k evictions and insertions/s, " << failures << " failures, " << packer.occupancy() * 100.0 << "% occupancy, " << packer.free_rectangles().size() << " free rectangles");
+  }
+
+  // Atlas insertion throughput, including copying the pixels into the pages.
+  {
+    const auto                sizes = make_sizes(4000, 4);
+    std::vector<sdl::surface> images;
+    for (const auto& size : sizes)
+      images.push_back(sdl::make_surface(size).value());
+    std::vector<const sdl::surface*> pointers;
+    for (const auto& image : images)
+      pointers.push_back(&image);
+
+    sdl::texture_atlas atlas(bin_size);
+    const auto         start   = std::chrono::high_resolution_clock::now();
+    REQUIRE(atlas.insert(pointers).has_value());
+    const auto         seconds = seconds_since(start);
+    MESSAGE("Texture atlas: " << images.size() / seconds / 1000.0 << " k images/s, " << atlas.page_count() << " pages, " << atlas.occupancy() * 100.0 << "% occupancy");
+  }
+}
\ No newline at end of file
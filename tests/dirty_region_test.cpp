@@ -0,0 +1,166 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sdl/dirty_region.hpp>
+#include <sdl/hints.hpp>
+#include <sdl/render.hpp>
+#include <sdl/sdl.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/video.hpp>
+
+TEST_CASE("Dirty Region Test")
+{
+  const auto covered = [ ] (const sdl::dirty_region& region, const sdl::native_point& point)
+  {
+    for (const auto& rectangle : region.rectangles())
+      if (rectangle.contains(point))
+        return true;
+    return false;
+  };
+
+  SUBCASE("Merging")
+  {
+    sdl::dirty_region region(sdl::native_rect {0, 0, 640, 480}, 0.5);
+    REQUIRE(region.empty());
+
+    // Contained rectangles are absorbed, overlapping ones which cover most of their bounding rectangle are merged.
+    region.add(sdl::native_rect {10, 10, 100, 100});
+    region.add(sdl::native_rect {20, 20, 10 , 10 });
+    REQUIRE(region.rectangles().size() == 1);
+    region.add(sdl::native_rect {60, 10, 100, 100});
+    REQUIRE(region.rectangles().size() == 1);
+    REQUIRE(region.rectangles()[0] == sdl::rectangle<std::int32_t>(10, 10, 150, 100));
+
+    // Distant rectangles are kept apart, since merging them would redraw mostly undamaged pixels.
+    region.add(sdl::native_rect {500, 400, 20, 20});
+    REQUIRE(region.rectangles().size() == 2);
+    REQUIRE(region.area() == 150 * 100 + 20 * 20);
+
+    // Rectangles are clipped to the bounds, and empty ones are ignored.
+    region.add(sdl::native_rect {630, 0, 50, 10});
+    REQUIRE(region.rectangles().back() == sdl::rectangle<std::int32_t>(630, 0, 10, 10));
+    region.add(sdl::native_rect {700, 0, 50, 10});
+    region.add(sdl::native_rect {0  , 0, 0 , 10});
+    REQUIRE(region.rectangles().size() == 3);
+
+    // A threshold of 0 merges everything.
+    sdl::dirty_region single(std::nullopt, 0.0);
+    single.add(sdl::native_rect {0  , 0  , 1, 1});
+    single.add(sdl::native_rect {100, 100, 1, 1});
+    REQUIRE(single.rectangles().size() == 1);
+    REQUIRE(single.rectangles()[0] == sdl::rectangle<std::int32_t>(0, 0, 101, 101));
+
+    region.add_all();
+    REQUIRE(region.rectangles().size() == 1);
+    REQUIRE(region.area() == 640 * 480);
+    region.clear();
+    REQUIRE(region.empty());
+  }
+
+  SUBCASE("Maximum rectangle count")
+  {
+    std::mt19937      generator(7);
+    sdl::dirty_region region(sdl::native_rect {0, 0, 1920, 1080}, 1.0, 8);
+
+    std::vector<sdl::native_rect> added;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+      const sdl::native_rect rectangle
+      {
+        static_cast<std::int32_t>(generator() % 1900),
+        static_cast<std::int32_t>(generator() % 1060),
+        static_cast<std::int32_t>(1 + generator() % 20),
+        static_cast<std::int32_t>(1 + generator() % 20)
+      };
+      region.add(rectangle);
+      added.push_back(rectangle);
+      REQUIRE(region.rectangles().size() <= 8);
+    }
+
+    // Every damaged pixel remains covered.
+    for (const auto& rectangle : added)
+    {
+      REQUIRE(covered(region, {rectangle.x                  , rectangle.y                  }));
+      REQUIRE(covered(region, {rectangle.x + rectangle.w - 1, rectangle.y + rectangle.h - 1}));
+    }
+  }
+
+  SUBCASE("Window surface updates")
+  {
+    // The dummy video driver provides window surfaces without a display.
+    REQUIRE(sdl::set_hint(SDL_HINT_VIDEODRIVER, "dummy"));
+    const sdl::video_subsystem video;
+    REQUIRE(sdl::is_initialized(sdl::subsystem_type::video));
+
+    auto window = SDL_CreateWindow("", 0, 0, 320, 240, SDL_WINDOW_HIDDEN);
+    REQUIRE(window);
+    const auto native = sdl::get_window_surface(window);
+    REQUIRE(native.has_value());
+    const sdl::surface surface(native.value(), false);
+    REQUIRE(surface.fill(surface.map_rgba({0, 0, 0, 255})).has_value());
+
+    sdl::dirty_region region(sdl::native_rect {0, 0, 320, 240});
+    region.add(sdl::native_rect {10 , 10 , 20, 20});
+    region.add(sdl::native_rect {200, 100, 30, 30});
+
+    // Only the damaged areas are redrawn and presented.
+    std::size_t passes = 0;
+    REQUIRE(region.draw(surface, [&] (const sdl::rectangle<std::int32_t>&) -> std::expected<void, std::string>
+    {
+      ++passes;
+      return surface.fill(surface.map_rgba({255, 255, 255, 255}));
+    }).has_value());
+    REQUIRE(passes == 2);
+    REQUIRE(surface.clip_rect().w == 320);
+
+    const auto pixel = [&] (const std::int32_t x, const std::int32_t y)
+    {
+      return reinterpret_cast<const std::uint32_t*>(surface.row(y).data())[x];
+    };
+    REQUIRE(pixel(15 , 15 ) == surface.map_rgba({255, 255, 255, 255}));
+    REQUIRE(pixel(210, 110) == surface.map_rgba({255, 255, 255, 255}));
+    REQUIRE(pixel(100, 50 ) == surface.map_rgba({0  , 0  , 0  , 255}));
+
+    // Presenting leaves the pixels of the window surface intact.
+    REQUIRE(region.update_window(window).has_value());
+    REQUIRE(pixel(15 , 15 ) == surface.map_rgba({255, 255, 255, 255}));
+    REQUIRE(pixel(100, 50 ) == surface.map_rgba({0  , 0  , 0  , 255}));
+
+    // Nothing is presented without damage.
+    region.clear();
+    REQUIRE(region.update_window(window).has_value());
+
+    SDL_DestroyWindow(window);
+  }
+
+  SUBCASE("Renderer clip rectangles")
+  {
+    auto target   = sdl::make_surface({64, 64}).value();
+    auto renderer = sdl::make_renderer(target).value();
+    REQUIRE(renderer.set_draw_color({0, 0, 0, 255}).has_value());
+    REQUIRE(renderer.clear().has_value());
+
+    sdl::dirty_region region(sdl::native_rect {0, 0, 64, 64});
+    region.add(sdl::native_rect {4, 4, 8, 8});
+    REQUIRE(region.draw(renderer, [&] (const sdl::rectangle<std::int32_t>&)
+    {
+      REQUIRE(renderer.set_draw_color({255, 0, 0, 255}).has_value());
+      return renderer.fill_rect();
+    }).has_value());
+    REQUIRE(!renderer.clip_rect().has_value());
+
+    const auto pixel = [&] (const std::int32_t x, const std::int32_t y)
+    {
+      return sdl::get_rgba(target.pixel_format(), reinterpret_cast<const std::uint32_t*>(target.row(y).data())[x]);
+    };
+    REQUIRE(pixel(5 , 5 ) == std::array<std::uint8_t, 4> {255, 0, 0, 255});
+    REQUIRE(pixel(20, 20) == std::array<std::uint8_t, 4> {0  , 0, 0, 255});
+  }
+}
\ No newline at end of file
@@ -0,0 +1,368 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <sdl/dynamic_memory_rw_ops.hpp>
+#include <sdl/event_recorder.hpp>
+#include <sdl/events.hpp>
+#include <sdl/sdl.hpp>
+
+TEST_CASE("Events Test")
+{
+  // The event queue is only available while the events subsystem is initialized. It is shut down at the end of the scope.
+  const sdl::events_subsystem subsystem;
+  REQUIRE(sdl::is_initialized(sdl::subsystem_type::events));
+  sdl::flush_events(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+  const auto push = [ ] (const std::uint32_t type, const std::int32_t x = 0)
+  {
+    SDL_Event event {};
+    event.type     = type;
+    event.motion.x = x;
+    REQUIRE(sdl::push_event(event).value());
+  };
+
+  SUBCASE("Event queue")
+  {
+    for (std::int32_t i = 0; i < 10; ++i)
+      push(i % 2 ? SDL_KEYDOWN : SDL_MOUSEMOTION, i);
+    push(SDL_QUIT);
+
+    sdl::event_queue queue(8);
+    REQUIRE(queue.capacity() == 8);
+    REQUIRE(queue.poll().value().size() == 8);
+    REQUIRE(queue.full());
+    REQUIRE(std::ranges::distance(queue.of_type (SDL_KEYDOWN    )) == 4);
+    REQUIRE(std::ranges::distance(queue.of_types(SDL_KEYDOWN, SDL_MOUSEMOTION)) == 8);
+    for (const auto& event : queue.of_type(SDL_MOUSEMOTION))
+      REQUIRE(event.motion.x % 2 == 0);
+    REQUIRE(!queue.contains(SDL_QUIT));
+
+    // The remaining events are retrieved by the next poll.
+    REQUIRE(queue.poll().value().size() == 3);
+    REQUIRE(queue.contains(SDL_QUIT));
+    REQUIRE(queue.begin()->motion.x == 8);
+    REQUIRE(queue.poll().value().empty());
+  }
+
+  SUBCASE("Event coalescing")
+  {
+    const auto motion = [ ] (const std::uint32_t which, const std::int32_t x)
+    {
+      SDL_Event event {};
+      event.motion.type  = SDL_MOUSEMOTION;
+      event.motion.which = which;
+      event.motion.x     = x;
+      event.motion.xrel  = 1;
+      REQUIRE(sdl::push_event(event).value());
+    };
+    const auto sensor = [ ] (const std::int32_t which, const float value)
+    {
+      SDL_Event event {};
+      event.sensor.type    = SDL_SENSORUPDATE;
+      event.sensor.which   = which;
+      event.sensor.data[0] = value;
+      REQUIRE(sdl::push_event(event).value());
+    };
+
+    motion(1, 10); motion(2, 20); sensor(5, 1.0f); motion(1, 11); sensor(5, 2.0f); sensor(5, 3.0f); motion(1, 12);
+    push  (SDL_KEYDOWN);
+    motion(1, 13); motion(1, 14);
+
+    sdl::event_queue queue(sdl::default_event_queue_capacity, sdl::event_coalescing {true, 2});
+    const auto events = queue.poll().value();
+    REQUIRE(queue.collapsed() == 4);
+    REQUIRE(events.size() == 6);
+
+    // The last event of each device within a run is retained, in the original order.
+    REQUIRE(events[0].motion.which   == 2);
+    REQUIRE(events[1].sensor.data[0] == 2.0f);
+    REQUIRE(events[2].sensor.data[0] == 3.0f);
+    REQUIRE(events[3].motion.x       == 12);
+    REQUIRE(events[3].motion.xrel    == 3);
+    REQUIRE(events[4].type           == SDL_KEYDOWN);
+    REQUIRE(events[5].motion.x       == 14);
+    REQUIRE(events[5].motion.xrel    == 2);
+
+    // Coalescing is opt-in.
+    motion(1, 0); motion(1, 1);
+    sdl::event_queue plain;
+    REQUIRE(plain.poll().value().size() == 2);
+    REQUIRE(plain.collapsed() == 0);
+    REQUIRE(plain.coalesce({}) == 1);
+    REQUIRE(plain.events()[0].motion.xrel == 2);
+  }
+
+  SUBCASE("Type ranges")
+  {
+    push(SDL_KEYDOWN);
+    push(SDL_MOUSEMOTION);
+    REQUIRE(sdl::has_event(SDL_KEYDOWN));
+
+    sdl::event_queue queue;
+    REQUIRE(queue.poll(false, SDL_MOUSEMOTION, SDL_MOUSEWHEEL).value().size() == 1);
+    REQUIRE(queue.events().front().type == SDL_MOUSEMOTION);
+    REQUIRE(sdl::has_events(SDL_KEYDOWN, SDL_KEYUP));
+    sdl::flush_event(SDL_KEYDOWN);
+    REQUIRE(!sdl::has_event(SDL_KEYDOWN));
+  }
+
+  SUBCASE("User events")
+  {
+    const auto type = sdl::register_events(2);
+    REQUIRE(type.has_value());
+    REQUIRE(type.value() >= SDL_USEREVENT);
+
+    REQUIRE(sdl::set_event_state(type.value(), false));
+    SDL_Event event {};
+    event.type = type.value();
+    REQUIRE(sdl::push_event(event).value() == false);
+    REQUIRE(!sdl::get_event_state(type.value()));
+    sdl::set_event_state(type.value(), true);
+    REQUIRE(sdl::push_event(event).value());
+    REQUIRE(sdl::poll_event()->type == type.value());
+  }
+
+  SUBCASE("Event dispatcher")
+  {
+    std::int32_t keys {}, motion {}, quits {}, others {};
+    auto dispatcher = sdl::make_event_dispatcher(
+      sdl::on<SDL_KEYDOWN, SDL_KEYUP>([&] (const SDL_KeyboardEvent&    event) { keys   += event.keysym.sym; }),
+      sdl::on<SDL_MOUSEMOTION       >([&] (const SDL_MouseMotionEvent& event) { motion += event.xrel      ; }),
+      sdl::on<SDL_QUIT              >([&] (const SDL_Event&                 ) { ++quits                   ; }),
+      sdl::on<                      >([&] (const SDL_Event&                 ) { ++others                  ; }));
+
+    std::vector<SDL_Event> events(6);
+    events[0].type = SDL_KEYDOWN    ; events[0].key   .keysym.sym = 2;
+    events[1].type = SDL_KEYUP      ; events[1].key   .keysym.sym = 3;
+    events[2].type = SDL_MOUSEMOTION; events[2].motion.xrel       = 5;
+    events[3].type = SDL_QUIT       ;
+    events[4].type = SDL_WINDOWEVENT;
+    events[5].type = SDL_USEREVENT  ;
+    dispatcher(events);
+    REQUIRE(keys   == 5);
+    REQUIRE(motion == 5);
+    REQUIRE(quits  == 1);
+    REQUIRE(others == 2);
+
+    // Handlers may receive the whole event instead of the member corresponding to the type.
+    std::uint32_t last_type {};
+    auto generic = sdl::make_event_dispatcher(sdl::on<SDL_KEYDOWN>([&] (const SDL_Event& event) { last_type = event.type; }));
+    generic(events[0]);
+    generic(events[3]);
+    REQUIRE(last_type == SDL_KEYDOWN);
+  }
+
+  SUBCASE("Event watch and filter")
+  {
+    std::size_t watched {};
+    {
+      sdl::event_watch watch([&] (const SDL_Event& event) { watched += event.type == SDL_KEYDOWN; });
+      push(SDL_KEYDOWN);
+      push(SDL_KEYUP  );
+      REQUIRE(watched == 1);
+    }
+    push(SDL_KEYDOWN);
+    REQUIRE(watched == 1);
+    sdl::flush_events(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    {
+      std::uint32_t     dropped = SDL_KEYUP;
+      sdl::event_filter outer([&] (SDL_Event& event) { return event.type != dropped; });
+      {
+        sdl::event_filter inner([ ] (SDL_Event& event) { return event.type != SDL_KEYDOWN; });
+        REQUIRE(!sdl::push_event(SDL_Event {.type = SDL_KEYDOWN}).value());
+        REQUIRE( sdl::push_event(SDL_Event {.type = SDL_KEYUP  }).value());
+      }
+      // The previous filter is restored.
+      REQUIRE(!sdl::push_event(SDL_Event {.type = SDL_KEYUP  }).value());
+      REQUIRE( sdl::push_event(SDL_Event {.type = SDL_KEYDOWN}).value());
+
+      dropped = SDL_KEYDOWN;
+      outer.apply();
+      sdl::event_queue queue;
+      REQUIRE(queue.poll().value().size() == 1);
+      REQUIRE(queue.events()[0].type == SDL_KEYUP);
+    }
+    REQUIRE(!sdl::get_event_filter().has_value());
+  }
+
+  SUBCASE("User event channel")
+  {
+    struct result
+    {
+      std::uint32_t producer;
+      std::uint32_t index   ;
+    };
+
+    auto channel = sdl::make_user_event_channel<result>(64);
+    REQUIRE(channel.has_value());
+    REQUIRE((*channel)->capacity() == 64);
+
+    constexpr std::uint32_t producers = 4;
+    constexpr std::uint32_t count     = 10000;
+
+    std::vector<std::thread> threads;
+    for (std::uint32_t producer = 0; producer < producers; ++producer)
+      threads.emplace_back([&, producer]
+      {
+        for (std::uint32_t i = 0; i < count; ++i)
+          while (!(*channel)->try_send({producer, i}).value())
+            std::this_thread::yield();
+      });
+
+    // Values of each producer arrive in order, and each wake-up event covers a batch of values.
+    std::vector<std::uint32_t> next(producers);
+    std::size_t                received {}, wake_ups {};
+    sdl::event_queue           queue;
+    while (received < producers * count)
+    {
+      const auto events = queue.poll().value();
+      for (const auto& event : events)
+      {
+        if (!(*channel)->is_event(event))
+          continue;
+        ++wake_ups;
+        received += (*channel)->receive([&] (result&& value)
+        {
+          REQUIRE(value.index == next[value.producer]++);
+        });
+      }
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    REQUIRE(received == producers * count);
+    REQUIRE(wake_ups <= received);
+    REQUIRE((*channel)->try_send({0, 0}));
+
+    std::array<result, 4> values {};
+    REQUIRE((*channel)->receive(std::span<result>(values)) == 1);
+
+    // A wake-up event which cannot be pushed remains pending, and is pushed along with the next value.
+    sdl::flush_events(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    sdl::quit_subsystem(sdl::subsystem_type::events);
+    REQUIRE(!(*channel)->try_send({0, 1}).has_value());
+    REQUIRE(sdl::initialize_subsystem(sdl::subsystem_type::events).has_value());
+    REQUIRE((*channel)->try_send({0, 2}).value());
+    REQUIRE((*channel)->try_send({0, 3}).value());
+    const auto events = queue.poll().value();
+    REQUIRE(events.size() == 1);
+    REQUIRE((*channel)->is_event(events[0]));
+    REQUIRE((*channel)->receive([ ] (result&&) { }) == 3);
+  }
+
+  SUBCASE("Event recording")
+  {
+    auto recording = sdl::make_dynamic_memory_rw_ops().value();
+
+    std::vector<SDL_Event> events(1000);
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+      auto& event = events[i];
+      event.motion           = {};
+      event.motion.type      = SDL_MOUSEMOTION;
+      event.motion.timestamp = static_cast<std::uint32_t>(100 + i * 2);
+      event.motion.x         = static_cast<std::int32_t>(i);
+      event.motion.y         = 480;
+      event.motion.xrel      = 1;
+    }
+    events[500].type = SDL_QUIT;
+
+    {
+      sdl::event_recorder recorder(recording.native(), 256);
+      REQUIRE(recorder.record(events).has_value());
+
+      SDL_Event drop {};
+      drop.drop.type = SDL_DROPFILE;
+      drop.drop.file = reinterpret_cast<char*>(&drop);
+      REQUIRE(recorder.record(drop).has_value());
+
+      REQUIRE(recorder.flush().has_value());
+      REQUIRE(recorder.count() == events.size());
+      REQUIRE(recorder.size () <  events.size() * sizeof(SDL_Event) / 8);
+    }
+
+    // Decoding restores the events, with their timestamps relative to the first one.
+    REQUIRE(recording.seek(0, sdl::seek_mode::set).has_value());
+    auto player = sdl::make_event_player(recording.native());
+    REQUIRE(player.has_value());
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+      auto event = player->next().value();
+      REQUIRE(event.has_value());
+      REQUIRE(event->common.timestamp == i * 2);
+      event->common.timestamp = events[i].common.timestamp;
+      REQUIRE(std::memcmp(&*event, &events[i], sizeof(SDL_Event)) == 0);
+    }
+    REQUIRE(!player->next().value().has_value());
+    REQUIRE(player->finished());
+
+    // Replaying at a fixed step pushes the events which are due.
+    REQUIRE(recording.seek(0, sdl::seek_mode::set).has_value());
+    player = sdl::make_event_player(recording.native());
+    REQUIRE(player->push_until(std::chrono::milliseconds(9)).value() == 5);
+    sdl::event_queue queue;
+    REQUIRE(queue.poll().value().size() == 5);
+    REQUIRE(queue.events()[4].motion.x == 4);
+
+    sdl::flush_events(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    REQUIRE(player->push_until(std::chrono::milliseconds::max()).value() == events.size() - 5);
+    REQUIRE(player->finished());
+    sdl::flush_events(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    // The watch records the events as they are added to the queue.
+    auto watched = sdl::make_dynamic_memory_rw_ops().value();
+    {
+      sdl::event_recorder recorder(watched.native());
+      recorder.start();
+      push(SDL_KEYDOWN);
+      push(SDL_MOUSEMOTION, 7);
+      recorder.stop ();
+      push(SDL_KEYUP);
+      REQUIRE(recorder.count() == 2);
+    }
+
+    // The counters and the error may be read while another thread records through the watch.
+    {
+      auto                concurrent = sdl::make_dynamic_memory_rw_ops().value();
+      sdl::event_recorder recorder(concurrent.native());
+      recorder.start();
+      std::thread producer([ ]
+      {
+        SDL_Event event {};
+        event.type = SDL_KEYDOWN;
+        for (std::size_t i = 0; i < 1000; ++i)
+          static_cast<void>(sdl::push_event(event));
+      });
+      std::size_t observed = 0;
+      while (observed < 1000 && !recorder.error().has_value())
+        observed = std::max(observed, recorder.count());
+      producer.join();
+      recorder.stop();
+      REQUIRE(!recorder.error());
+      REQUIRE(recorder.count() == 1000);
+      sdl::flush_events(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    }
+    REQUIRE(watched.seek(0, sdl::seek_mode::set).has_value());
+    player = sdl::make_event_player(watched.native(), std::numeric_limits<double>::infinity());
+    sdl::flush_events(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    REQUIRE(player->update().value() == 2);
+    REQUIRE(queue.poll().value().size() == 2);
+    REQUIRE(queue.events()[1].motion.x == 7);
+
+    std::array<std::byte, 8> garbage {};
+    auto invalid = sdl::make_rw_ops(std::span<const std::byte>(garbage)).value();
+    REQUIRE(!sdl::make_event_player(invalid.native()).has_value());
+  }
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sdl/bitmap_font.hpp>
+#include <sdl/glyph_cache.hpp>
+#include <sdl/render.hpp>
+#include <sdl/rwops.hpp>
+#include <sdl/sprite_batch.hpp>
+#include <sdl/surface.hpp>
+
+TEST_CASE("Glyph Cache Test")
+{
+  constexpr std::string_view descriptor =
+    "info face=\"Test Sans\" size=10 bold=0\n"
+    "common lineHeight=12 base=9 scaleW=32 scaleH=16 pages=1\n"
+    "page id=0 file=\"test_0.bmp\"\n"
+    "chars count=4\n"
+    "char id=65 x=0  y=0 width=8 height=10 xoffset=0 yoffset=1 xadvance=9 page=0 chnl=15\n"
+    "char id=66 x=8  y=0 width=8 height=10 xoffset=1 yoffset=1 xadvance=9 page=0 chnl=15\n"
+    "char id=63 x=16 y=0 width=6 height=10 xoffset=0 yoffset=1 xadvance=7 page=0 chnl=15\n"
+    "char id=32 x=0  y=0 width=0 height=0  xoffset=0 yoffset=0 xadvance=4 page=0 chnl=15\n"
+    "kernings count=1\n"
+    "kerning first=65 second=66 amount=-1\r\n";
+
+  // The glyphs of the page are red, green and blue.
+  const auto page_loader = [ ] (const std::string& filename) -> std::expected<sdl::surface, std::string>
+  {
+    if (filename != "test_0.bmp")
+      return std::unexpected("Unknown page " + filename + ".");
+    auto page = sdl::make_surface({32, 16}, SDL_PIXELFORMAT_ABGR8888);
+    if (!page)
+      return page;
+    static_cast<void>(page->fill(page->map_rgba({0  , 0  , 0  , 0  })));
+    static_cast<void>(page->fill(page->map_rgba({255, 0  , 0  , 255}), sdl::native_rect {0 , 0, 8, 10}));
+    static_cast<void>(page->fill(page->map_rgba({0  , 255, 0  , 255}), sdl::native_rect {8 , 0, 8, 10}));
+    static_cast<void>(page->fill(page->map_rgba({0  , 0  , 255, 255}), sdl::native_rect {16, 0, 6, 10}));
+    return page;
+  };
+  const auto load        = [&] (const std::string_view& text)
+  {
+    auto ops = sdl::make_rw_ops(std::as_bytes(std::span(text.data(), text.size())));
+    REQUIRE(ops.has_value());
+    return sdl::load_bitmap_font(ops.value(), page_loader);
+  };
+  const auto pixel       = [ ] (const sdl::surface& surface, const std::int32_t x, const std::int32_t y)
+  {
+    return sdl::get_rgba(surface.pixel_format(), reinterpret_cast<const std::uint32_t*>(surface.row(y).data())[x]);
+  };
+
+  const auto font = load(descriptor);
+  REQUIRE(font.has_value());
+
+  SUBCASE("Bitmap font")
+  {
+    REQUIRE(font->face        == "Test Sans");
+    REQUIRE(font->size        == 10);
+    REQUIRE(font->line_height == 12);
+    REQUIRE(font->base        == 9);
+    REQUIRE(font->pages .size() == 1);
+    REQUIRE(font->glyphs.size() == 4);
+
+    const auto glyph = font->glyph(U'B');
+    REQUIRE(glyph);
+    REQUIRE(glyph->area    == sdl::rectangle<std::int32_t>(8, 0, 8, 10));
+    REQUIRE(glyph->offset  == std::array<std::int32_t, 2> {1, 1});
+    REQUIRE(glyph->advance == 9);
+    REQUIRE(!font->glyph(U'C'));
+    REQUIRE(font->kerning(U'A', U'B') == -1);
+    REQUIRE(font->kerning(U'B', U'A') == 0);
+
+    REQUIRE(!load("info size=10\n").has_value());                                                              // No line height.
+    REQUIRE(!load("common lineHeight=12 pages=1\npage id=0 file=\"missing.bmp\"\n").has_value());              // Page loader failure.
+    REQUIRE(!load("common lineHeight=12 pages=1\npage id=0 file=\"test_0.bmp\n").has_value());                 // Unterminated string.
+    REQUIRE(!load("common lineHeight=x\n").has_value());                                                       // Invalid number.
+    REQUIRE(!load("common lineHeight=12 pages=1\npage id=0 file=\"test_0.bmp\"\nchar id=65 x=30 y=0 width=8 height=10\n").has_value()); // Outside the page.
+    REQUIRE(!load("common lineHeight=12 pages=1\npage id=0 file=\"test_0.bmp\"\nchar id=65 x=2147483647 y=0 width=8 height=10\n").has_value()); // Overflowing bounds.
+    REQUIRE(!load("common lineHeight=12 pages=1\npage id=2000000000 file=\"test_0.bmp\"\n").has_value());      // Page id beyond the page count.
+    REQUIRE(!load("common lineHeight=12 pages=2\npage id=0 file=\"test_0.bmp\"\npage id=0 file=\"test_0.bmp\"\n").has_value()); // Duplicate page id.
+    REQUIRE(!load("common lineHeight=12 pages=2000000000\npage id=0 file=\"test_0.bmp\"\n").has_value());      // Missing pages.
+  }
+
+  SUBCASE("UTF-8")
+  {
+    REQUIRE(sdl::decode_utf8("A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80") == std::u32string {U'A', U'\u00E9', U'\u20AC', U'\U0001F600'});
+    REQUIRE(sdl::decode_utf8("\xC0\xAF")                              == std::u32string {U'\uFFFD', U'\uFFFD'}); // Overlong.
+    REQUIRE(sdl::decode_utf8("\xED\xA0\x80")                          == std::u32string {U'\uFFFD', U'\uFFFD', U'\uFFFD'}); // Surrogate.
+    REQUIRE(sdl::decode_utf8("\xE2\x82")                              == std::u32string {U'\uFFFD', U'\uFFFD'}); // Truncated.
+  }
+
+  SUBCASE("Glyph cache")
+  {
+    sdl::glyph_cache cache({64, 64});
+    const auto       handle = cache.add_font(font.value());
+
+    const auto glyph = cache.glyph(handle, 10, U'A');
+    REQUIRE(glyph.has_value());
+    REQUIRE(glyph.value()->handle.has_value());
+    REQUIRE(glyph.value()->size    == std::array<float, 2> {8.0f, 10.0f});
+    REQUIRE(glyph.value()->advance == 9.0f);
+    REQUIRE(cache.glyph(handle, 10, U'A').value() == glyph.value());
+    REQUIRE(cache.statistics().hits   == 1);
+    REQUIRE(cache.statistics().misses == 1);
+
+    // The pixels are copied into the atlas, converted to its format.
+    const auto& region = cache.atlas().region(glyph.value()->handle.value());
+    REQUIRE(pixel(cache.atlas().page_surface(region.page), region.area.x, region.area.y) == std::array<std::uint8_t, 4> {255, 0, 0, 255});
+
+    // Other sizes are scaled, and cached separately.
+    const auto scaled = cache.glyph(handle, 20, U'A');
+    REQUIRE(scaled.has_value());
+    REQUIRE(scaled.value() != glyph.value());
+    REQUIRE(scaled.value()->size    == std::array<float, 2> {16.0f, 20.0f});
+    REQUIRE(scaled.value()->offset  == std::array<float, 2> {0.0f , 2.0f });
+    REQUIRE(scaled.value()->advance == 18.0f);
+    REQUIRE(cache.kerning    (handle, 20, U'A', U'B') == -2.0f);
+    REQUIRE(cache.line_height(handle, 20)             == 24.0f);
+    const auto& scaled_region = cache.atlas().region(scaled.value()->handle.value());
+    REQUIRE(pixel(cache.atlas().page_surface(scaled_region.page), scaled_region.area.x + 15, scaled_region.area.y + 19) == std::array<std::uint8_t, 4> {255, 0, 0, 255});
+
+    // Spaces have no pixels, missing codepoints fall back to '?'.
+    REQUIRE(!cache.glyph(handle, 10, U' ').value()->handle.has_value());
+    REQUIRE(cache.glyph(handle, 10, U'Z').value()->advance == 7.0f);
+    REQUIRE(cache.size() == 4);
+
+    REQUIRE(!cache.glyph(handle + 1, 10, U'A').has_value());
+    REQUIRE(!cache.glyph(handle    , 0 , U'A').has_value());
+
+    // Clearing releases the pages of the atlas.
+    REQUIRE(cache.atlas().page_count() > 0);
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.atlas().page_count() == 0);
+    REQUIRE(cache.glyph(handle, 10, U'A').has_value());
+    REQUIRE(cache.atlas().page_count() == 1);
+  }
+
+  SUBCASE("Layout")
+  {
+    // The cache is declared after the renderer, since its textures must be destroyed before the renderer.
+    auto             target   = sdl::make_surface({64, 32}).value();
+    auto             renderer = sdl::make_renderer(target).value();
+    sdl::glyph_cache cache({64, 64});
+    sdl::text_style  style;
+    style.font = cache.add_font(font.value());
+    style.size = 10;
+
+    // A, kerned B (by -1), space, A.
+    std::vector<sdl::sprite> sprites;
+    auto layout = sdl::layout_text(cache, renderer, "AB A", {2.0f, 3.0f}, style, sprites);
+    REQUIRE(layout.has_value());
+    REQUIRE(layout->lines  == 1);
+    REQUIRE(layout->glyphs == 3);
+    REQUIRE(sprites.size() == 3);
+    REQUIRE(sprites[0].destination.x == 2.0f);
+    REQUIRE(sprites[0].destination.y == 4.0f);
+    REQUIRE(sprites[1].destination.x == 2.0f + 9.0f - 1.0f + 1.0f);
+    REQUIRE(sprites[2].destination.x == 2.0f + 9.0f - 1.0f + 9.0f + 4.0f);
+    REQUIRE(layout->bounds.w == 9.0f - 1.0f + 9.0f + 4.0f + 9.0f);
+    REQUIRE(layout->bounds.h == 12.0f);
+    for (const auto& current : sprites)
+      REQUIRE(current.texture == cache.atlas().page_texture(0));
+
+    // Lines are wrapped at spaces, and broken at newlines.
+    sprites.clear();
+    style.max_width = 20.0f;
+    layout = sdl::layout_text(cache, renderer, "AB A\nA", {0.0f, 0.0f}, style, sprites);
+    REQUIRE(layout.has_value());
+    REQUIRE(layout->lines  == 3);
+    REQUIRE(sprites.size() == 4);
+    REQUIRE(sprites[2].destination.x == 0.0f);
+    REQUIRE(sprites[2].destination.y == 13.0f);
+    REQUIRE(sprites[3].destination.y == 25.0f);
+
+    style.max_width = 0.0f;
+    style.alignment = sdl::text_alignment::right;
+    sprites.clear();
+    layout = sdl::layout_text(cache, renderer, "AB\nA", {0.0f, 0.0f}, style, sprites);
+    REQUIRE(layout.has_value());
+    REQUIRE(sprites[2].destination.x == 8.0f);
+
+    // The sprites are drawn with a single draw call.
+    style.alignment = sdl::text_alignment::left;
+    sdl::sprite_batch batch;
+    REQUIRE(renderer.set_draw_color({0, 0, 0, 255}).has_value());
+    REQUIRE(renderer.clear().has_value());
+    REQUIRE(sdl::layout_text(cache, renderer, "AB?", {0.0f, 0.0f}, style, batch).has_value());
+    REQUIRE(batch.flush(renderer).has_value());
+    REQUIRE(batch.statistics().draw_calls == 1);
+    REQUIRE(pixel(target, 1 , 2) == std::array<std::uint8_t, 4> {255, 0  , 0  , 255});
+    REQUIRE(pixel(target, 12, 2) == std::array<std::uint8_t, 4> {0  , 255, 0  , 255});
+    REQUIRE(pixel(target, 19, 2) == std::array<std::uint8_t, 4> {0  , 0  , 255, 255});
+    REQUIRE(pixel(target, 1 , 0) == std::array<std::uint8_t, 4> {0  , 0  , 0  , 255});
+  }
+}
\ No newline at end of file
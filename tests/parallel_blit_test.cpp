@@ -0,0 +1,111 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+
+#include <sdl/parallel_blit.hpp>
+#include <sdl/surface.hpp>
+
+TEST_CASE("Parallel Blit Test")
+{
+  std::mt19937 generator(7);
+  const auto randomize = [&] (const sdl::surface& surface)
+  {
+    for (std::int32_t y = 0; y < surface.size()[1]; ++y)
+      for (auto& value : surface.row(y))
+        value = static_cast<std::byte>(generator());
+  };
+  const auto equal     = [ ] (const sdl::surface& lhs, const sdl::surface& rhs)
+  {
+    for (std::int32_t y = 0; y < lhs.size()[1]; ++y)
+      if (std::memcmp(lhs.row(y).data(), rhs.row(y).data(), lhs.row(y).size()) != 0)
+        return false;
+    return true;
+  };
+
+  struct scenario
+  {
+    std::uint32_t                   source_format   ;
+    std::uint32_t                   target_format   ;
+    sdl::native_point               position        ;
+    std::optional<sdl::native_rect> source_rectangle;
+    bool                            color_key       ;
+    std::uint8_t                    alpha           ;
+  };
+  const scenario scenarios[]
+  {
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, {  0,   0}, std::nullopt                      , false, 255},
+    {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, {-13,  21}, std::nullopt                      , false, 100},
+    {SDL_PIXELFORMAT_RGB24   , SDL_PIXELFORMAT_ARGB8888, { 17, -40}, sdl::native_rect {-5, 3, 150, 200}, true , 255},
+    {SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565  , { 50,  60}, sdl::native_rect {10, 10, 90, 190}, false, 200}
+  };
+
+  for (const auto& current : scenarios)
+    for (const std::size_t thread_count : {1, 2, 4, 7})
+      for (const std::int32_t minimum_band_height : {1, 3, 64})
+      {
+        auto source   = sdl::make_surface({140, 230}, current.source_format).value();
+        auto expected = sdl::make_surface({160, 200}, current.target_format).value();
+        auto actual   = sdl::make_surface({160, 200}, current.target_format).value();
+        randomize(source);
+        randomize(expected);
+        for (std::int32_t y = 0; y < 200; ++y)
+          std::memcpy(actual.row(y).data(), expected.row(y).data(), expected.row(y).size());
+
+        REQUIRE(source.set_alpha_mod(current.alpha).has_value());
+        if (current.color_key)
+          REQUIRE(source.set_color_key(source.map_rgba({0, 0, 0, 255})).has_value());
+        REQUIRE(expected.set_clip_rect(sdl::native_rect {5, 0, 150, 190}));
+        REQUIRE(actual  .set_clip_rect(sdl::native_rect {5, 0, 150, 190}));
+
+        // A small band size yields many bands.
+        auto blitter = sdl::make_parallel_blitter(thread_count, minimum_band_height, 4096);
+        REQUIRE(blitter.has_value());
+        REQUIRE(blitter.value()->thread_count() == thread_count);
+
+        const auto serial   = source.blit(expected, current.position, current.source_rectangle);
+        const auto parallel = blitter.value()->blit(source, actual, current.position, current.source_rectangle);
+        REQUIRE(serial  .has_value());
+        REQUIRE(parallel.has_value());
+        REQUIRE(sdl::rect_equals(serial.value(), parallel.value()));
+        REQUIRE(equal(expected, actual));
+      }
+
+  SUBCASE("Overlapping source and destination")
+  {
+    // Scrolling within a surface is blitted serially, since the bands would read rows which other bands have written.
+    auto blitter  = sdl::make_parallel_blitter(4, 1, 4096).value();
+    auto expected = sdl::make_surface({64, 300}).value();
+    auto actual   = sdl::make_surface({64, 300}).value();
+    randomize(expected);
+    for (std::int32_t y = 0; y < 300; ++y)
+      std::memcpy(actual.row(y).data(), expected.row(y).data(), expected.row(y).size());
+
+    const auto serial   = expected.blit(expected, {0, 20}, sdl::native_rect {0, 0, 64, 280});
+    const auto parallel = blitter->blit(actual  , actual  , {0, 20}, sdl::native_rect {0, 0, 64, 280});
+    REQUIRE(serial  .has_value());
+    REQUIRE(parallel.has_value());
+    REQUIRE(sdl::rect_equals(serial.value(), parallel.value()));
+    REQUIRE(equal(expected, actual));
+  }
+
+  SUBCASE("Errors and degenerate rectangles")
+  {
+    auto blitter = sdl::make_parallel_blitter(3).value();
+    auto source  = sdl::make_surface({8, 8}).value();
+    auto target  = sdl::make_surface({8, 8}).value();
+
+    const auto outside = blitter->blit(source, target, {100, 100});
+    REQUIRE(outside.has_value());
+    REQUIRE(outside->w == 0);
+    REQUIRE(outside->h == 0);
+
+    REQUIRE(source.lock().has_value());
+    REQUIRE(!blitter->blit(source, target).has_value());
+    source.unlock();
+    REQUIRE(!blitter->blit(nullptr, std::nullopt, target.native()).has_value());
+  }
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <sdl/pixel_conversion.hpp>
+#include <sdl/pixels.hpp>
+#include <sdl/surface.hpp>
+
+TEST_CASE("Pixel Conversion Test")
+{
+  std::vector<const sdl::pixel_conversion_kernels*> kernels {&sdl::pixel_conversion_kernels_scalar};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  if (sdl::has_sse2 ())
+    kernels.push_back(&sdl::pixel_conversion_kernels_sse2 );
+  if (sdl::has_sse41())
+    kernels.push_back(&sdl::pixel_conversion_kernels_ssse3);
+  if (sdl::has_avx2 ())
+    kernels.push_back(&sdl::pixel_conversion_kernels_avx2 );
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+  if (sdl::has_neon ())
+    kernels.push_back(&sdl::pixel_conversion_kernels_neon );
+#endif
+
+  std::mt19937 generator(42);
+  const auto random_bytes = [&] (const std::size_t size)
+  {
+    std::vector<std::uint8_t> result(size);
+    for (auto& value : result)
+      value = static_cast<std::uint8_t>(generator());
+    return result;
+  };
+
+  // The widths cover the vector widths and the scalar tails.
+  constexpr std::array<std::int32_t, 12> widths {1, 2, 3, 5, 8, 15, 16, 17, 31, 32, 33, 67};
+
+  REQUIRE(!sdl::has_vectorized_pixel_conversion(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888));
+  REQUIRE(!sdl::has_vectorized_pixel_conversion(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB24   ));
+  REQUIRE(!sdl::has_vectorized_pixel_conversion(SDL_PIXELFORMAT_RGB565  , SDL_PIXELFORMAT_ARGB8888));
+  REQUIRE(!sdl::has_vectorized_pixel_conversion(SDL_PIXELFORMAT_NV12    , SDL_PIXELFORMAT_RGBA8888));
+
+  SUBCASE("RGB")
+  {
+    constexpr std::array<std::uint32_t, 8> sources      {SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888};
+    constexpr std::array<std::uint32_t, 4> destinations {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888};
+
+    for (const auto source_format : sources)
+      for (const auto destination_format : destinations)
+        for (const auto width : widths)
+        {
+          if (source_format == destination_format)
+            continue;
+          REQUIRE(sdl::has_vectorized_pixel_conversion(source_format, destination_format));
+
+          // The pitches are padded to catch writes beyond the rows, whereas the last source row ends at the end of the buffer
+          // to catch reads beyond it.
+          constexpr std::int32_t height            = 3;
+          const std::int32_t     row_size          = width * static_cast<std::int32_t>(sdl::bytes_per_pixel(source_format));
+          const std::int32_t     source_pitch      = row_size + 5;
+          const std::int32_t     destination_pitch = width * 4 + 8;
+          const auto             source            = random_bytes(static_cast<std::size_t>(source_pitch * (height - 1) + row_size));
+
+          std::vector<std::uint8_t> expected(static_cast<std::size_t>(destination_pitch * height), 0xCD);
+          REQUIRE(SDL_ConvertPixels(width, height, source_format, source.data(), source_pitch, destination_format, expected.data(), destination_pitch) == 0);
+
+          const auto source_name      = sdl::get_pixel_format_name(source_format     );
+          const auto destination_name = sdl::get_pixel_format_name(destination_format);
+          for (const auto current : kernels)
+          {
+            CAPTURE(current->name);
+            CAPTURE(source_name);
+            CAPTURE(destination_name);
+            CAPTURE(width);
+
+            std::vector<std::uint8_t> actual(expected.size(), 0xCD);
+            REQUIRE(sdl::convert_pixels_vectorized(*current, {width, height}, source_format, source.data(), source_pitch, destination_format, actual.data(), destination_pitch));
+            REQUIRE(actual == expected);
+          }
+        }
+  }
+
+  SUBCASE("YUV")
+  {
+    constexpr std::array<std::uint32_t, 4>                     sources      {SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21};
+    constexpr std::array<std::uint32_t, 2>                     destinations {SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888};
+    constexpr std::array<SDL_YUV_CONVERSION_MODE, 3>           modes        {SDL_YUV_CONVERSION_JPEG, SDL_YUV_CONVERSION_BT601, SDL_YUV_CONVERSION_BT709};
+
+    for (const auto mode : modes)
+    {
+      sdl::set_yuv_conversion_mode(static_cast<sdl::yuv_conversion_mode>(mode));
+      for (const auto source_format : sources)
+        for (const auto destination_format : destinations)
+          for (const auto width : widths)
+            for (const auto height : {1, 4, 5})
+            {
+              const std::int32_t source_pitch      = width + 3;
+              const std::int32_t destination_pitch = width * 4 + 8;
+              auto               source            = random_bytes(static_cast<std::size_t>(source_pitch * height + (source_pitch + 1) / 2 * 2 * ((height + 1) / 2)));
+
+              // SDL wraps around where the kernels saturate, hence the samples are restricted to the range where neither
+              // occurs: Luma in [16, 235] and chroma in [80, 176]. The luma plane precedes the chroma in each format.
+              for (std::size_t i = 0; i < source.size(); ++i)
+                source[i] = static_cast<std::uint8_t>(i < static_cast<std::size_t>(source_pitch * height) ? 16 + source[i] % 220 : 80 + source[i] % 97);
+
+              std::vector<std::uint8_t> expected(static_cast<std::size_t>(destination_pitch * height), 0xCD);
+              REQUIRE(SDL_ConvertPixels(width, height, source_format, source.data(), source_pitch, destination_format, expected.data(), destination_pitch) == 0);
+
+              const auto source_name = sdl::get_pixel_format_name(source_format);
+              for (const auto current : kernels)
+              {
+                CAPTURE(current->name);
+                CAPTURE(source_name);
+                CAPTURE(mode);
+                CAPTURE(width);
+                CAPTURE(height);
+
+                std::vector<std::uint8_t> actual(expected.size(), 0xCD);
+                REQUIRE(sdl::convert_pixels_vectorized(*current, {width, height}, source_format, source.data(), source_pitch, destination_format, actual.data(), destination_pitch));
+                REQUIRE(actual == expected);
+              }
+            }
+    }
+    sdl::set_yuv_conversion_mode(sdl::yuv_conversion_mode::bt601);
+
+    // Out of that range, the vectorized kernels saturate exactly like the scalar kernel.
+    constexpr std::int32_t    width  = 67;
+    constexpr std::int32_t    height = 5;
+    const auto                source = random_bytes(static_cast<std::size_t>(width * height + (width + 1) / 2 * 2 * ((height + 1) / 2)));
+    std::vector<std::uint8_t> expected(static_cast<std::size_t>(width * height * 4));
+    REQUIRE(sdl::convert_pixels_vectorized(sdl::pixel_conversion_kernels_scalar, {width, height}, SDL_PIXELFORMAT_NV12, source.data(), width, SDL_PIXELFORMAT_ARGB8888, expected.data(), width * 4));
+    for (const auto current : kernels)
+    {
+      CAPTURE(current->name);
+      std::vector<std::uint8_t> actual(expected.size());
+      REQUIRE(sdl::convert_pixels_vectorized(*current, {width, height}, SDL_PIXELFORMAT_NV12, source.data(), width, SDL_PIXELFORMAT_ARGB8888, actual.data(), width * 4));
+      REQUIRE(actual == expected);
+    }
+  }
+
+  SUBCASE("Surface")
+  {
+    auto source = sdl::make_surface({19, 7}, SDL_PIXELFORMAT_RGB24).value();
+    for (std::int32_t y = 0; y < 7; ++y)
+      for (auto& value : source.row(y))
+        value = static_cast<std::byte>(generator());
+    REQUIRE(source.set_alpha_mod(128).has_value());
+
+    const auto converted = source.convert(SDL_PIXELFORMAT_ARGB8888);
+    REQUIRE(converted.has_value());
+    REQUIRE(converted->alpha_mod () == 128);
+    REQUIRE(converted->blend_mode() == sdl::blend_mode::blend);
+    for (std::int32_t y = 0; y < 7; ++y)
+      for (std::int32_t x = 0; x < 19; ++x)
+      {
+        const auto pixel = converted->row(y).subspan(static_cast<std::size_t>(x) * 4, 4);
+        const auto input = source    .row(y).subspan(static_cast<std::size_t>(x) * 3, 3);
+        REQUIRE(pixel[0] == input[2]);
+        REQUIRE(pixel[1] == input[1]);
+        REQUIRE(pixel[2] == input[0]);
+        REQUIRE(pixel[3] == std::byte {255});
+      }
+
+    // As in `SDL_ConvertSurface`, blending is removed unless both formats have alpha or the alpha is modulated, whereas
+    // the other blend modes are retained.
+    REQUIRE(source.set_alpha_mod (255).has_value());
+    REQUIRE(source.set_blend_mode(sdl::blend_mode::blend).has_value());
+    REQUIRE(source.convert(SDL_PIXELFORMAT_ARGB8888)->blend_mode() == sdl::blend_mode::none);
+    REQUIRE(source.set_blend_mode(sdl::blend_mode::add).has_value());
+    REQUIRE(source.convert(SDL_PIXELFORMAT_ARGB8888)->blend_mode() == sdl::blend_mode::add);
+  }
+}
\ No newline at end of file
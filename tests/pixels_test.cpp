@@ -0,0 +1,85 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <sdl/pixels.hpp>
+
+TEST_CASE("Pixels Test")
+{
+  SUBCASE("Pixel formats")
+  {
+    REQUIRE(sdl::bytes_per_pixel(SDL_PIXELFORMAT_RGB24) == 3);
+    REQUIRE(sdl::is_pixel_format_alpha  (SDL_PIXELFORMAT_ARGB8888));
+    REQUIRE(!sdl::is_pixel_format_alpha (SDL_PIXELFORMAT_XRGB8888));
+    REQUIRE(sdl::is_pixel_format_fourcc (SDL_PIXELFORMAT_NV12));
+    REQUIRE(sdl::is_pixel_format_indexed(SDL_PIXELFORMAT_INDEX8));
+
+    const auto masks = sdl::pixel_format_enum_to_masks(SDL_PIXELFORMAT_ARGB8888);
+    REQUIRE(masks.has_value());
+    REQUIRE(masks->alpha == 0xFF000000);
+    REQUIRE(sdl::masks_to_pixel_format_enum(masks.value()) == SDL_PIXELFORMAT_ARGB8888);
+    REQUIRE(sdl::get_pixel_format_name(SDL_PIXELFORMAT_RGB24) == "SDL_PIXELFORMAT_RGB24");
+
+    const auto format = sdl::alloc_format(SDL_PIXELFORMAT_ABGR8888);
+    REQUIRE(format.has_value());
+    REQUIRE(sdl::map_rgba(format.value(), {1, 2, 3, 4}) == 0x04030201);
+    REQUIRE(sdl::get_rgba(format.value(), 0x04030201) == std::array<std::uint8_t, 4> {1, 2, 3, 4});
+    sdl::free_format(format.value());
+  }
+
+  SUBCASE("Pixel format cache")
+  {
+    auto& cache = sdl::get_pixel_format_cache();
+    cache.trim();
+    REQUIRE(cache.size() == 0);
+
+    const sdl::native_pixel_format* native;
+    {
+      auto format = sdl::make_pixel_format(SDL_PIXELFORMAT_ABGR8888);
+      REQUIRE(format.has_value());
+      REQUIRE(format->format         () == SDL_PIXELFORMAT_ABGR8888);
+      REQUIRE(format->bytes_per_pixel() == 4);
+      REQUIRE(format->use_count      () == 1);
+      REQUIRE(format->map_rgba({1, 2, 3, 4}) == 0x04030201);
+      REQUIRE(format->get_rgba(0x04030201) == std::array<std::uint8_t, 4> {1, 2, 3, 4});
+      native = format->native();
+
+      // Handles of the same format share the native format.
+      const auto copy  = format.value();
+      const auto other = sdl::pixel_format(SDL_PIXELFORMAT_ABGR8888);
+      REQUIRE(copy .native() == native);
+      REQUIRE(other.native() == native);
+      REQUIRE(format->use_count() == 3);
+
+      auto moved = std::move(format.value());
+      REQUIRE(moved.use_count() == 3);
+      REQUIRE(!format->native());
+      REQUIRE(cache.trim() == 0);
+    }
+
+    // The format is retained without handles, until it is trimmed.
+    REQUIRE(cache.size() == 1);
+    REQUIRE(sdl::pixel_format(SDL_PIXELFORMAT_ABGR8888).native() == native);
+    REQUIRE(cache.trim() == 1);
+    REQUIRE(cache.size() == 0);
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i)
+      threads.emplace_back([ ]
+      {
+        for (std::size_t j = 0; j < 1000; ++j)
+        {
+          const sdl::pixel_format format(j % 2 ? SDL_PIXELFORMAT_ARGB8888 : SDL_PIXELFORMAT_RGB24);
+          auto                    copy = format;
+          REQUIRE(copy.map_rgb({255, 0, 0}) == (j % 2 ? 0xFFFF0000u : 0x000000FFu));
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.trim() == 2);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <sdl/render.hpp>
+#include <sdl/sprite_batch.hpp>
+#include <sdl/surface.hpp>
+
+TEST_CASE("Render Test")
+{
+  const auto equal = [ ] (const sdl::surface& lhs, const sdl::surface& rhs)
+  {
+    for (std::int32_t y = 0; y < lhs.size()[1]; ++y)
+      if (std::memcmp(lhs.row(y).data(), rhs.row(y).data(), lhs.row(y).size()) != 0)
+        return false;
+    return true;
+  };
+
+  SUBCASE("Renderer and textures")
+  {
+    auto target   = sdl::make_surface({64, 48}).value();
+    auto renderer = sdl::make_renderer(target);
+    REQUIRE(renderer.has_value());
+    REQUIRE(renderer->output_size().value() == std::array<std::int32_t, 2> {64, 48});
+
+    REQUIRE(renderer->set_draw_color({255, 0, 0, 255}).has_value());
+    REQUIRE(renderer->clear().has_value());
+    REQUIRE(renderer->set_draw_color({0, 0, 255, 255}).has_value());
+    REQUIRE(renderer->fill_rect(sdl::native_rect {8, 8, 4, 4}).has_value());
+    REQUIRE(renderer->set_clip_rect(sdl::native_rect {0, 0, 16, 16}).has_value());
+    REQUIRE(renderer->clip_rect().has_value());
+    REQUIRE(renderer->set_clip_rect().has_value());
+    REQUIRE(!renderer->clip_rect().has_value());
+
+    auto pixels = sdl::make_surface({64, 48}).value();
+    REQUIRE(renderer->read_pixels(pixels).has_value());
+    REQUIRE(sdl::get_rgba(pixels.pixel_format(), reinterpret_cast<const std::uint32_t*>(pixels.row(0 ).data())[0 ]) == std::array<std::uint8_t, 4> {255, 0, 0  , 255});
+    REQUIRE(sdl::get_rgba(pixels.pixel_format(), reinterpret_cast<const std::uint32_t*>(pixels.row(10).data())[10]) == std::array<std::uint8_t, 4> {0  , 0, 255, 255});
+
+    auto texture = sdl::make_texture(renderer.value(), {4, 2}, SDL_PIXELFORMAT_ARGB8888, sdl::texture_access::streaming);
+    REQUIRE(texture.has_value());
+    const auto info = texture->info();
+    REQUIRE(info.has_value());
+    REQUIRE(info->format == SDL_PIXELFORMAT_ARGB8888);
+    REQUIRE(info->access == sdl::texture_access::streaming);
+    REQUIRE(info->size   == std::array<std::int32_t, 2> {4, 2});
+
+    const auto lock = texture->lock();
+    REQUIRE(lock.has_value());
+    for (std::int32_t y = 0; y < 2; ++y)
+      for (std::int32_t x = 0; x < 4; ++x)
+        reinterpret_cast<std::uint32_t*>(static_cast<std::byte*>(lock->pixels) + y * lock->pitch)[x] = 0xFF00FF00;
+    texture->unlock();
+
+    REQUIRE(texture->set_blend_mode(sdl::blend_mode::none).has_value());
+    REQUIRE(texture->blend_mode().value() == sdl::blend_mode::none);
+    REQUIRE(texture->set_color_mod({255, 255, 255}).has_value());
+    REQUIRE(texture->set_alpha_mod(255).has_value());
+    REQUIRE(renderer->copy(texture.value(), sdl::native_frect {20, 20, 8, 4}).has_value());
+    REQUIRE(renderer->read_pixels(pixels).has_value());
+    REQUIRE(sdl::get_rgba(pixels.pixel_format(), reinterpret_cast<const std::uint32_t*>(pixels.row(23).data())[27]) == std::array<std::uint8_t, 4> {0, 255, 0, 255});
+
+    // Rendering to a target texture.
+    auto canvas = sdl::make_texture(renderer.value(), {8, 8}, SDL_PIXELFORMAT_ARGB8888, sdl::texture_access::target).value();
+    REQUIRE(renderer->set_target(&canvas).has_value());
+    REQUIRE(renderer->output_size().value() == std::array<std::int32_t, 2> {8, 8});
+    REQUIRE(renderer->set_target().has_value());
+    REQUIRE(renderer->output_size().value() == std::array<std::int32_t, 2> {64, 48});
+
+    REQUIRE(!sdl::make_texture(renderer.value(), std::array<std::int32_t, 2> {0, 0}).has_value());
+  }
+
+  SUBCASE("Sprite batch")
+  {
+    std::mt19937 generator(11);
+
+    auto expected = sdl::make_surface({96, 80}).value();
+    auto actual   = sdl::make_surface({96, 80}).value();
+    auto reference_renderer = sdl::make_renderer(expected).value();
+    auto batch_renderer     = sdl::make_renderer(actual  ).value();
+
+    // The same textures on both renderers.
+    std::array<sdl::texture, 3> reference_textures {sdl::texture(nullptr), sdl::texture(nullptr), sdl::texture(nullptr)};
+    std::array<sdl::texture, 3> batch_textures     {sdl::texture(nullptr), sdl::texture(nullptr), sdl::texture(nullptr)};
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      auto image = sdl::make_surface({16, 16}).value();
+      for (std::int32_t y = 0; y < 16; ++y)
+        for (auto& value : image.row(y))
+          value = static_cast<std::byte>(generator());
+      reference_textures[i] = sdl::make_texture(reference_renderer, image).value();
+      batch_textures    [i] = sdl::make_texture(batch_renderer    , image).value();
+    }
+
+    struct sprite_description
+    {
+      std::size_t                 texture;
+      sdl::native_rect            source ;
+      sdl::native_rect            target ;
+      std::array<std::uint8_t, 4> color  ;
+      sdl::blend_mode             mode   ;
+      sdl::renderer_flip          flip   ;
+    };
+    std::vector<sprite_description> descriptions;
+    for (std::size_t i = 0; i < 60; ++i)
+    {
+      const auto x = static_cast<std::int32_t>(generator() % 12);
+      const auto y = static_cast<std::int32_t>(generator() % 12);
+      descriptions.push_back(
+      {
+        i % 3,
+        sdl::native_rect {x, y, 4, 4},
+        sdl::native_rect {static_cast<std::int32_t>(generator() % 90) - 4, static_cast<std::int32_t>(generator() % 74) - 4, i % 4 ? 4 : 8, i % 5 ? 4 : 8},
+        {static_cast<std::uint8_t>(generator()), 255, static_cast<std::uint8_t>(generator()), static_cast<std::uint8_t>(i % 2 ? 255 : generator())},
+        i % 7 ? sdl::blend_mode::blend : sdl::blend_mode::none,
+        i % 6 ? sdl::renderer_flip::none : sdl::renderer_flip::horizontal | sdl::renderer_flip::vertical
+      });
+    }
+
+    for (const auto mode : {sdl::sprite_sort_mode::deferred, sdl::sprite_sort_mode::texture})
+    {
+      REQUIRE(reference_renderer.set_draw_color({40, 80, 120, 255}).has_value());
+      REQUIRE(batch_renderer    .set_draw_color({40, 80, 120, 255}).has_value());
+      REQUIRE(reference_renderer.clear().has_value());
+      REQUIRE(batch_renderer    .clear().has_value());
+
+      // With sorting by texture, the reference renders the sprites in the order of the batch.
+      auto ordered = descriptions;
+      if (mode == sdl::sprite_sort_mode::texture)
+        std::ranges::stable_sort(ordered, [&] (const auto& lhs, const auto& rhs)
+        {
+          return std::tuple(batch_textures[lhs.texture].native(), lhs.mode) < std::tuple(batch_textures[rhs.texture].native(), rhs.mode);
+        });
+      for (const auto& current : ordered)
+      {
+        const auto& texture = reference_textures[current.texture];
+        REQUIRE(texture.set_color_mod ({current.color[0], current.color[1], current.color[2]}).has_value());
+        REQUIRE(texture.set_alpha_mod (current.color[3]).has_value());
+        REQUIRE(texture.set_blend_mode(current.mode    ).has_value());
+        REQUIRE(sdl::render_copy_ex(reference_renderer.native(), texture.native(), current.source, current.target, 0.0, std::nullopt, current.flip).has_value());
+      }
+
+      sdl::sprite_batch batch(mode, 4);
+      for (const auto& current : descriptions)
+      {
+        const auto& target = current.target;
+        batch.draw(sdl::sprite
+        {
+          batch_textures[current.texture].native(),
+          sdl::native_frect {static_cast<float>(target.x), static_cast<float>(target.y), static_cast<float>(target.w), static_cast<float>(target.h)},
+          current.source,
+          current.color,
+          current.mode,
+          current.flip
+        });
+      }
+      REQUIRE(batch.size() == descriptions.size());
+      REQUIRE(batch.flush(batch_renderer).has_value());
+      REQUIRE(batch.empty());
+      REQUIRE(batch.statistics().sprites == descriptions.size());
+
+      // The texture pointers are ordered arbitrarily, hence only the number of groups is known.
+      if (mode == sdl::sprite_sort_mode::texture)
+        REQUIRE(batch.statistics().draw_calls == 6);
+      else
+        REQUIRE(batch.statistics().draw_calls == descriptions.size());
+
+      // The blend modes of the textures are restored.
+      for (const auto& texture : batch_textures)
+        REQUIRE(texture.blend_mode().value() == sdl::blend_mode::blend);
+
+      REQUIRE(equal(expected, actual));
+    }
+  }
+
+  SUBCASE("Untextured sprites and layers")
+  {
+    auto actual         = sdl::make_surface({16, 16}).value();
+    auto batch_renderer = sdl::make_renderer(actual).value();
+
+    sdl::sprite_batch batch;
+    batch.draw(sdl::sprite {nullptr, sdl::native_frect {0, 0, 8, 8}, std::nullopt, {255, 0, 0, 255}, sdl::blend_mode::none, sdl::renderer_flip::none, 0.0f, 1});
+    batch.draw(sdl::sprite {nullptr, sdl::native_frect {0, 0, 8, 8}, std::nullopt, {0, 255, 0, 255}, sdl::blend_mode::none, sdl::renderer_flip::none, 0.0f, 0});
+    batch.draw(sdl::sprite {nullptr, sdl::native_frect {4, 4, 8, 8}, std::nullopt, {0, 0, 255, 255}, sdl::blend_mode::none, sdl::renderer_flip::none, 0.0f, 1});
+    REQUIRE(batch_renderer.set_blend_mode(sdl::blend_mode::add).has_value());
+    REQUIRE(batch.flush(batch_renderer).has_value());
+    // The sprites are sorted by layer, and share a single group since the triangles are rendered in order.
+    REQUIRE(batch.statistics().draw_calls == 1);
+    REQUIRE(batch_renderer.blend_mode().value() == sdl::blend_mode::add);
+
+    // The green sprite of layer 0 is covered by the sprites of layer 1.
+    const auto row = reinterpret_cast<const std::uint32_t*>(actual.row(2).data());
+    REQUIRE(sdl::get_rgba(actual.pixel_format(), row[2]) == std::array<std::uint8_t, 4> {255, 0, 0, 255});
+    REQUIRE(sdl::get_rgba(actual.pixel_format(), reinterpret_cast<const std::uint32_t*>(actual.row(6).data())[6]) == std::array<std::uint8_t, 4> {0, 0, 255, 255});
+
+    REQUIRE(batch.flush(batch_renderer).has_value());
+    REQUIRE(batch.statistics().draw_calls == 0);
+  }
+}
\ No newline at end of file
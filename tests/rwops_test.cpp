@@ -0,0 +1,482 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sdl/async_rw_reader.hpp>
+#include <sdl/buffered_rw_ops.hpp>
+#include <sdl/compressed_rw_ops.hpp>
+#include <sdl/dynamic_memory_rw_ops.hpp>
+#include <sdl/mapped_file.hpp>
+#include <sdl/rwops.hpp>
+
+TEST_CASE("RW Ops Test")
+{
+  const auto filepath = (std::filesystem::temp_directory_path() / "sdl_rwops_test.bin").string();
+
+  std::vector<std::uint32_t> values(1024);
+  std::iota(values.begin(), values.end(), 0u);
+  {
+    auto file = sdl::make_rw_ops(filepath, "wb");
+    REQUIRE(file.has_value());
+    REQUIRE(file->write(values.data(), sizeof(std::uint32_t), values.size()).value() == values.size());
+  }
+
+  SUBCASE("Mapped file")
+  {
+    auto mapped = sdl::make_mapped_file(filepath);
+    REQUIRE(mapped.has_value());
+    REQUIRE(mapped->size() == values.size() * sizeof(std::uint32_t));
+    REQUIRE(std::ranges::equal(mapped->data(), std::as_bytes(std::span(values))));
+
+    auto ops = sdl::make_mapped_rw_ops(filepath);
+    REQUIRE(ops.has_value());
+    REQUIRE(ops->size().value() == static_cast<std::int64_t>(mapped->size()));
+
+    std::uint32_t value {};
+    REQUIRE(ops->seek(16, sdl::seek_mode::set).value() == 16);
+    REQUIRE(ops->read(&value, sizeof(value), 1).value() == 1);
+    REQUIRE(value == 4u);
+    REQUIRE(ops->seek(-4, sdl::seek_mode::end).value() == ops->size().value() - 4);
+    REQUIRE(ops->read(&value, sizeof(value), 1).value() == 1);
+    REQUIRE(value == 1023u);
+    REQUIRE(!ops->read (&value, sizeof(value), 1));
+    REQUIRE(!ops->write(&value, sizeof(value), 1));
+
+    const sdl::mapped_file_source source(std::make_shared<const sdl::mapped_file>(sdl::make_mapped_file(filepath).value()));
+    REQUIRE(source.read_at(4, &value, sizeof(value)).value() == sizeof(value));
+    REQUIRE(value == 1u);
+    REQUIRE(!source.read_at(-4, &value, sizeof(value)).has_value());
+
+    REQUIRE(!sdl::make_mapped_file("sdl_rwops_test_nonexistent.bin"));
+  }
+
+  SUBCASE("Buffered rw_ops")
+  {
+    auto file = sdl::make_rw_ops(filepath, "r+b");
+    REQUIRE(file.has_value());
+
+    auto ops = sdl::make_buffered_rw_ops(file->native(), 64);
+    REQUIRE(ops.has_value());
+    for (std::uint32_t i = 0; i < 32; ++i)
+      REQUIRE(ops->read_le_integer<std::uint32_t>().value() == i);
+    REQUIRE(ops->tell().value() == 128);
+
+    // Seeks within the buffer, reads larger than the buffer, and writes after reads.
+    REQUIRE(ops->seek(-8, sdl::seek_mode::cur).value() == 120);
+    REQUIRE(ops->read_le_integer<std::uint32_t>().value() == 30u);
+    std::vector<std::uint32_t> large(64);
+    REQUIRE(ops->read(large.data(), sizeof(std::uint32_t), large.size()).value() == large.size());
+    REQUIRE(large.front() == 31u);
+    REQUIRE(large.back () == 94u);
+    REQUIRE(ops->write_le_integer<std::uint32_t>(42u).has_value());
+    REQUIRE(ops->seek(95 * sizeof(std::uint32_t)).value() == 95 * sizeof(std::uint32_t));
+    REQUIRE(ops->read_le_integer<std::uint32_t>().value() == 42u);
+
+    // The native rw_ops shares the state of the buffer.
+    REQUIRE(sdl::write_le32(ops->native(), 43u).has_value());
+    REQUIRE(ops->flush().has_value());
+    REQUIRE(file->seek(96 * sizeof(std::uint32_t)).value() == 96 * sizeof(std::uint32_t));
+    std::uint32_t value {};
+    REQUIRE(file->read(&value, sizeof(value), 1).value() == 1);
+    REQUIRE(value == 43u);
+  }
+
+  SUBCASE("Async rw_ops reader")
+  {
+    auto file = sdl::make_rw_ops(filepath, "rb");
+    REQUIRE(file.has_value());
+    std::vector<std::uint32_t> memory(values);
+    auto memory_ops = sdl::make_rw_ops(std::span(memory));
+    REQUIRE(memory_ops.has_value());
+
+    for (auto [source, backend] : {std::pair(file->native(), sdl::async_rw_backend::automatic), std::pair(memory_ops->native(), sdl::async_rw_backend::thread_pool)})
+    {
+      auto reader = sdl::make_async_rw_reader(source, 2, 8, backend);
+      REQUIRE(reader.has_value());
+
+      std::vector<std::uint32_t>                                 results(values.size());
+      std::vector<std::future<sdl::async_read_result>>           futures;
+      for (std::size_t i = 0; i < results.size() / 2; i += 16)
+        futures.push_back((*reader)->read(static_cast<std::int64_t>(i * sizeof(std::uint32_t)), std::as_writable_bytes(std::span(results).subspan(i, 16))));
+
+      std::size_t callbacks = 0;
+      for (std::size_t i = results.size() / 2; i < results.size(); i += 16)
+        (*reader)->read(static_cast<std::int64_t>(i * sizeof(std::uint32_t)), std::as_writable_bytes(std::span(results).subspan(i, 16)), [&] (const sdl::async_read_result& result)
+        {
+          REQUIRE(result.value() == 16 * sizeof(std::uint32_t));
+          ++callbacks;
+        });
+
+      for (auto& future : futures)
+        REQUIRE(future.get().value() == 16 * sizeof(std::uint32_t));
+      (*reader)->wait();
+      REQUIRE(callbacks == results.size() / 32);
+      REQUIRE((*reader)->pending() == 0);
+      REQUIRE(results == values);
+
+      std::uint32_t past_end {};
+      REQUIRE((*reader)->read(static_cast<std::int64_t>(values.size() * sizeof(std::uint32_t)), std::as_writable_bytes(std::span(&past_end, 1))).get().value() == 0);
+      std::array<std::uint32_t, 4> across_end {};
+      REQUIRE((*reader)->read(static_cast<std::int64_t>((values.size() - 2) * sizeof(std::uint32_t)), std::as_writable_bytes(std::span(across_end))).get().value() == 2 * sizeof(std::uint32_t));
+      REQUIRE(across_end[1] == values.back());
+    }
+
+    // Far more reads than the queues hold are in flight at once.
+    auto reader = sdl::make_async_rw_reader(file->native(), 1, 1);
+    REQUIRE(reader.has_value());
+    std::vector<std::uint32_t>                       results(values.size());
+    std::vector<std::future<sdl::async_read_result>> futures;
+    for (std::size_t i = 0; i < results.size(); ++i)
+      futures.push_back((*reader)->read(static_cast<std::int64_t>(i * sizeof(std::uint32_t)), std::as_writable_bytes(std::span(results).subspan(i, 1))));
+    (*reader)->wait();
+    for (auto& future : futures)
+      REQUIRE(future.get().value() == sizeof(std::uint32_t));
+    REQUIRE(results == values);
+  }
+
+  SUBCASE("Vectored rw_ops")
+  {
+    std::vector<std::uint32_t> memory(values.size());
+    auto file       = sdl::make_rw_ops(filepath, "r+b");
+    auto memory_ops = sdl::make_rw_ops(std::span(memory));
+    auto mapped_ops = sdl::make_mapped_rw_ops(filepath);
+    REQUIRE(file      .has_value());
+    REQUIRE(memory_ops.has_value());
+    REQUIRE(mapped_ops.has_value());
+
+    const std::array<std::span<const std::byte>, 3> sources {
+      std::as_bytes(std::span(values).subspan(0  , 10 )),
+      std::as_bytes(std::span(values).subspan(10 , 0  )),
+      std::as_bytes(std::span(values).subspan(10 , 502))};
+    REQUIRE(memory_ops->write_v(sources).value() == 512 * sizeof(std::uint32_t));
+    REQUIRE(std::equal(values.begin(), values.begin() + 512, memory.begin()));
+
+    REQUIRE(file->seek(4).has_value());
+    REQUIRE(file->write_v(sources).value() == 512 * sizeof(std::uint32_t));
+    REQUIRE(file->tell().value() == 4 + 512 * sizeof(std::uint32_t));
+
+    for (auto* ops : {&file.value(), &memory_ops.value(), &mapped_ops.value()})
+    {
+      std::vector<std::uint32_t> first(3), second(5);
+      const std::array<std::span<std::byte>, 2> destinations {std::as_writable_bytes(std::span(first)), std::as_writable_bytes(std::span(second))};
+      REQUIRE(ops->seek(ops == &memory_ops.value() ? 4 : 8).has_value()); // The file and its mapping are shifted by the write above.
+      REQUIRE(ops->read_v(destinations).value() == 8 * sizeof(std::uint32_t));
+      REQUIRE(first  == std::vector<std::uint32_t>{1, 2, 3});
+      REQUIRE(second == std::vector<std::uint32_t>{4, 5, 6, 7, 8});
+
+      REQUIRE(ops->seek(-8, sdl::seek_mode::end).has_value());
+      REQUIRE(ops->read_v(destinations).value() == 8);
+    }
+  }
+
+  SUBCASE("Endian arrays")
+  {
+    // Every kernel is checked against the scalar swap, with lengths covering the vector bodies and the scalar tails.
+    for (std::size_t count : {0, 1, 7, 15, 16, 33, 100})
+    {
+      std::vector<std::uint16_t> shorts(count);
+      std::vector<std::uint64_t> longs (count);
+      std::iota(shorts.begin(), shorts.end(), std::uint16_t(0x0102));
+      std::iota(longs .begin(), longs .end(), std::uint64_t(0x0102030405060708));
+      auto expected_shorts = shorts;
+      auto expected_longs  = longs ;
+      std::ranges::transform(expected_shorts, expected_shorts.begin(), [ ] (const auto value) { return SDL_Swap16(value); });
+      std::ranges::transform(expected_longs , expected_longs .begin(), [ ] (const auto value) { return SDL_Swap64(value); });
+
+      sdl::byteswap_array(std::span(shorts));
+      sdl::byteswap_array(std::span(longs ));
+      REQUIRE(shorts == expected_shorts);
+      REQUIRE(longs  == expected_longs );
+    }
+
+    auto file = sdl::make_rw_ops(filepath, "rb");
+    REQUIRE(file.has_value());
+
+    std::vector<std::uint32_t> little(values.size()), big(values.size());
+    REQUIRE(file->read_le_array(std::span(little)).value() == values.size());
+    REQUIRE(file->seek(0).has_value());
+    REQUIRE(file->read_be_array(std::span(big   )).value() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      REQUIRE(little[i] == sdl::byteswap_le(values[i]));
+      REQUIRE(big   [i] == sdl::byteswap_be(values[i]));
+    }
+
+    std::vector<std::byte> memory(values.size() * sizeof(float) + 8);
+    auto memory_ops = sdl::make_rw_ops(std::span(memory));
+    REQUIRE(memory_ops.has_value());
+
+    std::vector<float> floats(values.size());
+    std::ranges::transform(values, floats.begin(), [ ] (const auto value) { return static_cast<float>(value) * 0.5f; });
+    REQUIRE(memory_ops->write_be_array(std::span<const float>(floats)).has_value());
+    REQUIRE(memory_ops->seek(0).has_value());
+
+    std::vector<float> read_floats(values.size() + 4);
+    REQUIRE(memory_ops->read_be_array(std::span(read_floats)).value() == values.size() + 2); // Short read.
+    REQUIRE(std::equal(floats.begin(), floats.end(), read_floats.begin()));
+    REQUIRE(memory_ops->read_be_array(std::span(read_floats)).has_value() == false);
+  }
+
+  SUBCASE("Dynamic memory rw_ops")
+  {
+    auto ops = sdl::make_dynamic_memory_rw_ops(100);
+    REQUIRE(ops.has_value());
+    REQUIRE(ops->write(values.data(), sizeof(std::uint32_t), values.size()).value() == values.size());
+    REQUIRE(ops->size().value() == static_cast<std::int64_t>(values.size() * sizeof(std::uint32_t)));
+    REQUIRE(ops->source()->capacity() == 41 * 100);
+    REQUIRE(std::ranges::equal(ops->contiguous(), std::as_bytes(std::span(values))));
+
+    const auto chunks = ops->chunks();
+    REQUIRE(chunks.size()        == 41);
+    REQUIRE(chunks.back().size() == 96);
+
+    std::vector<std::uint32_t> memory(values.size());
+    auto memory_ops = sdl::make_rw_ops(std::span(memory));
+    REQUIRE(memory_ops.has_value());
+    REQUIRE(memory_ops->write_v(chunks).value() == values.size() * sizeof(std::uint32_t));
+    REQUIRE(memory == values);
+
+    std::vector<std::uint32_t> read(10);
+    REQUIRE(ops->seek(98).has_value());
+    REQUIRE(ops->read(read.data(), sizeof(std::uint32_t), read.size()).value() == read.size());
+    std::vector<std::uint32_t> expected(read.size());
+    std::memcpy(expected.data(), reinterpret_cast<const std::byte*>(values.data()) + 98, expected.size() * sizeof(std::uint32_t)); // Straddles a chunk.
+    REQUIRE(read == expected);
+
+    // Seeking past the end and writing fills the gap with zeros.
+    const std::uint32_t marker = 0xDEADBEEF;
+    REQUIRE(ops->seek(8, sdl::seek_mode::end).has_value());
+    REQUIRE(ops->write(&marker, sizeof(marker), 1).has_value());
+    const auto data = ops->contiguous();
+    REQUIRE(data.size() == values.size() * sizeof(std::uint32_t) + 12);
+    REQUIRE(std::all_of(data.end() - 12, data.end() - 4, [ ] (const std::byte value) { return value == std::byte{0}; }));
+
+    ops->clear();
+    REQUIRE(ops->size().value() == 0);
+    REQUIRE(ops->read(read.data(), sizeof(std::uint32_t), 1).has_value() == false);
+  }
+
+  SUBCASE("Compressed rw_ops")
+  {
+    std::vector<std::byte> noise(3000);
+    std::ranges::generate(noise, [state = 1u] () mutable { return static_cast<std::byte>((state = state * 1664525u + 1013904223u) >> 24); });
+
+    for (const auto level : {0, 1, 9})
+    {
+      auto sink = sdl::make_dynamic_memory_rw_ops(4096);
+      REQUIRE(sink.has_value());
+      {
+        auto ops = sdl::make_compressed_rw_ops(sink->native(), sdl::compressed_rw_mode::write, level, 1000);
+        REQUIRE(ops.has_value());
+        REQUIRE(ops->write(values.data(), sizeof(std::uint32_t), values.size()).has_value());
+        REQUIRE(ops->write(noise .data(), 1, noise.size()).has_value());
+        REQUIRE(ops->size().value() == static_cast<std::int64_t>(values.size() * sizeof(std::uint32_t) + noise.size()));
+        REQUIRE(ops->seek(100).has_value() == false);
+        REQUIRE(ops->source()->block_count() == 7);
+        REQUIRE(ops->source()->compressed_size() <= 12 + 7 * (8 + 1000)); // Incompressible blocks are stored.
+      }
+
+      REQUIRE(sink->seek(0).has_value());
+      auto ops = sdl::make_compressed_rw_ops(sink->native(), sdl::compressed_rw_mode::read);
+      REQUIRE(ops.has_value());
+      REQUIRE(ops->source()->block_count() == 8);
+      REQUIRE(ops->size().value() == static_cast<std::int64_t>(values.size() * sizeof(std::uint32_t) + noise.size()));
+
+      std::vector<std::uint32_t> read(values.size());
+      REQUIRE(ops->read(read.data(), sizeof(std::uint32_t), read.size()).value() == read.size());
+      REQUIRE(read == values);
+      std::vector<std::byte> read_noise(noise.size());
+      REQUIRE(ops->read(read_noise.data(), 1, read_noise.size()).value() == read_noise.size());
+      REQUIRE(read_noise == noise);
+
+      // Seeking loads the block containing the position.
+      std::uint32_t value;
+      REQUIRE(ops->seek(999 * sizeof(std::uint32_t)).has_value());
+      REQUIRE(ops->read(&value, sizeof(value), 1).value() == 1);
+      REQUIRE(value == 999);
+      REQUIRE(ops->seek(249 * sizeof(std::uint32_t)).has_value()); // Straddles two blocks.
+      REQUIRE(ops->read(&value, sizeof(value), 1).value() == 1);
+      REQUIRE(value == 249);
+      REQUIRE(ops->write(&value, sizeof(value), 1).has_value() == false);
+    }
+
+    std::string text;
+    for (std::size_t i = 0; i < 1000; ++i)
+      text += "token" + std::to_string(i % 37) + " ";
+    std::vector<std::byte> compressed;
+    sdl::lz_compress(std::as_bytes(std::span(text)), compressed, 1);
+    REQUIRE(compressed.size() < text.size() / 10);
+    std::vector<std::byte> decompressed(text.size());
+    REQUIRE(sdl::lz_decompress(compressed, decompressed).value() == text.size());
+    REQUIRE(std::ranges::equal(decompressed, std::as_bytes(std::span(text))));
+
+    std::vector<std::byte> corrupt(16, std::byte{0xFF});
+    std::vector<std::byte> output (64);
+    REQUIRE(sdl::lz_decompress(corrupt, output).has_value() == false);
+
+    auto empty = sdl::make_dynamic_memory_rw_ops();
+    REQUIRE(sdl::make_compressed_rw_ops(empty->native(), sdl::compressed_rw_mode::read).has_value() == false);
+
+    // Corrupt trailers are reported, rather than trusted for allocations. The trailer holds the index offset, the block
+    // count and the size, followed by the magic.
+    std::vector<std::byte> stream(8192);
+    {
+      auto sink = sdl::make_rw_ops(std::span(stream));
+      auto ops  = sdl::make_compressed_rw_ops(sink->native(), sdl::compressed_rw_mode::write, 1, 1000);
+      REQUIRE(ops->write(values.data(), sizeof(std::uint32_t), values.size()).has_value());
+      REQUIRE(ops->source()->close().has_value());
+      stream.resize(static_cast<std::size_t>(sink->tell().value()));
+    }
+    const auto patch = [&] (const std::size_t field, const std::uint64_t value)
+    {
+      auto copy = stream;
+      for (std::size_t i = 0; i < 8; ++i)
+        copy[copy.size() - 28 + field * 8 + i] = static_cast<std::byte>(value >> (8 * i));
+      auto source = sdl::make_rw_ops(std::span(copy));
+      return sdl::make_compressed_rw_ops(source->native(), sdl::compressed_rw_mode::read).has_value();
+    };
+    REQUIRE(patch(1, 5));
+    REQUIRE(!patch(1, 0x1FFFFFFFFFFFFFFF)); // Block count.
+    REQUIRE(!patch(2, 0xFFFFFFFFFFFFFFFF)); // Size.
+    REQUIRE(!patch(0, 0xFFFFFFFFFFFFFFF0)); // Index offset.
+    REQUIRE(!patch(0, 4));
+
+    // Corrupt block headers are reported, rather than trusted for allocations. The first block header follows the 12 byte
+    // stream header, and holds the stored and the raw size of the block.
+    const auto patch_block = [&] (const std::uint32_t stored_size)
+    {
+      auto copy = stream;
+      for (std::size_t i = 0; i < 4; ++i)
+        copy[12 + i] = static_cast<std::byte>(stored_size >> (8 * i));
+      auto          source = sdl::make_rw_ops(std::span(copy));
+      auto          ops    = sdl::make_compressed_rw_ops(source->native(), sdl::compressed_rw_mode::read);
+      std::uint32_t value;
+      return ops.has_value() && ops->read(&value, sizeof(value), 1).has_value();
+    };
+    REQUIRE(patch_block(static_cast<std::uint32_t>(stream[12]) | static_cast<std::uint32_t>(stream[13]) << 8 | static_cast<std::uint32_t>(stream[14]) << 16 | static_cast<std::uint32_t>(stream[15]) << 24));
+    REQUIRE(!patch_block(0x7FFFFFF0)); // Beyond the next block.
+    REQUIRE(!patch_block(1000));       // Not smaller than the raw size.
+
+    // Failing to write a block keeps the size of the buffered data.
+    std::vector<std::byte> small(40);
+    auto small_sink = sdl::make_rw_ops(std::span(small));
+    auto small_ops  = sdl::make_compressed_rw_ops(small_sink->native(), sdl::compressed_rw_mode::write, 0, 16);
+    REQUIRE(small_ops->write(noise.data(), 1, 40).has_value() == false);
+    REQUIRE(small_ops->size().value() == 32);
+    REQUIRE(small_ops->source()->block_count() == 1);
+    REQUIRE(small_ops->source()->close().has_value() == false); // Before the destructor, which requires closing to succeed.
+  }
+
+  SUBCASE("Typed rw_ops")
+  {
+    struct triple
+    {
+      std::uint32_t x, y, z;
+    };
+
+    auto file = sdl::make_rw_ops(filepath, "rb");
+    REQUIRE(file.has_value());
+
+    // The file holds 341 complete triples, the remaining 4 bytes are left in the stream.
+    std::vector<triple> triples(400);
+    REQUIRE(file->read_as(std::span(triples)).value() == 341);
+    REQUIRE(file->tell().value() == 341 * sizeof(triple));
+    REQUIRE(triples[10].x == 30);
+    REQUIRE(triples[10].z == 32);
+    REQUIRE(file->read_le_integer<std::uint32_t>().value() == sdl::byteswap_le(values.back()));
+    REQUIRE(file->read_as(std::span(triples)).has_value() == false);
+
+    REQUIRE(file->seek(0).has_value());
+    auto buffered = sdl::make_buffered_rw_ops(file->native(), 64);
+    REQUIRE(buffered.has_value());
+    std::array<std::uint32_t, 4> quad {};
+    for (std::size_t i = 0; i < 32; ++i)
+    {
+      REQUIRE(buffered->read_as(std::span<std::uint32_t>(quad)).value() == quad.size());
+      REQUIRE(quad[3] == values[i * 4 + 3]);
+    }
+
+    std::vector<std::byte> memory(sizeof(triple) * 2);
+    auto memory_ops = sdl::make_rw_ops(std::span(memory));
+    REQUIRE(memory_ops.has_value());
+    REQUIRE(memory_ops->write_as(std::span<const triple>(triples.data(), 2)).value() == 2);
+    REQUIRE(memory_ops->write_as(std::span<const triple>(triples.data(), 1)).has_value() == false);
+  }
+
+  SUBCASE("Sliced rw_ops")
+  {
+    auto file   = sdl::make_rw_ops(filepath, "rb");
+    auto mapped = sdl::make_mapped_rw_ops(filepath);
+    auto memory = sdl::make_rw_ops(std::span<const std::uint32_t>(values));
+    REQUIRE(file  .has_value());
+    REQUIRE(mapped.has_value());
+    REQUIRE(memory.has_value());
+
+    for (auto* ops : {&file.value(), &mapped.value(), &memory.value()})
+    {
+      auto slice = ops->slice(100 * sizeof(std::uint32_t), 10 * sizeof(std::uint32_t));
+      REQUIRE(slice.has_value());
+      REQUIRE(slice->size().value() == 10 * sizeof(std::uint32_t));
+
+      std::vector<std::uint32_t> read(20);
+      REQUIRE(slice->read_as(std::span(read)).value() == 10);
+      REQUIRE(std::equal(read.begin(), read.begin() + 10, values.begin() + 100));
+      REQUIRE(slice->seek(100).value() == 10 * sizeof(std::uint32_t)); // Seeks are bounded.
+      REQUIRE(slice->seek(-4, sdl::seek_mode::end).has_value());
+      REQUIRE(slice->read_le_integer<std::uint32_t>().value() == sdl::byteswap_le(values[109]));
+
+      // Nested slices, and slices past the end of the parent are clamped.
+      auto nested = slice->slice(8, 100);
+      REQUIRE(nested.has_value());
+      REQUIRE(nested->size().value() == 32);
+      REQUIRE(nested->read_le_integer<std::uint32_t>().value() == sdl::byteswap_le(values[102]));
+      REQUIRE(ops->slice(values.size() * sizeof(std::uint32_t) + 4, 4)->size().value() == 0);
+      REQUIRE(ops->slice(-1, 4).has_value() == false);
+
+      // Slices read positionally, without moving the parent.
+      REQUIRE(ops->tell().value() == 0);
+    }
+
+    // Concurrent readers over disjoint regions of a file and of its mapping.
+    for (auto* ops : {&file.value(), &mapped.value()})
+    {
+      std::vector<std::future<bool>> futures;
+      for (std::size_t i = 0; i < 4; ++i)
+        futures.push_back(std::async(std::launch::async, [&, i]
+        {
+          auto slice = ops->slice(static_cast<std::int64_t>(i * 256 * sizeof(std::uint32_t)), 256 * sizeof(std::uint32_t));
+          std::vector<std::uint32_t> read(256);
+          return slice.has_value() && slice->read_as(std::span(read)).value_or(0) == 256 && std::equal(read.begin(), read.end(), values.begin() + i * 256);
+        }));
+      for (auto& future : futures)
+        REQUIRE(future.get());
+    }
+
+    // Positional writes to files do not move them either.
+    auto writable = sdl::make_rw_ops(filepath, "r+b");
+    REQUIRE(writable.has_value());
+    const std::uint32_t value = 0xDEADBEEF;
+    auto                window = writable->slice(8, 8);
+    REQUIRE(window->seek(4).has_value());
+    REQUIRE(window->write(&value, sizeof(value), 1).value() == 1);
+    REQUIRE(window->write(&value, sizeof(value), 1).has_value() == false); // Beyond the end of the window.
+    REQUIRE(writable->tell().value() == 0);
+    std::uint32_t read {};
+    REQUIRE(sdl::rw_read_at(writable->native(), 12, &read, sizeof(read)).value() == sizeof(read));
+    REQUIRE(read == value);
+  }
+
+  std::remove(filepath.c_str());
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <sdl/assert.hpp>
 #include <sdl/atomic.hpp>
+#include <sdl/events.hpp>
 #include <sdl/hidapi.hpp>
 #include <sdl/log.hpp>
 #include <sdl/mouse.hpp>
@@ -80,10 +81,7 @@ TEST_CASE("SDL Test")
   sdl::rw_ops rops(std::span<std::uint32_t>(values));
 
   const auto window = SDL_CreateWindow("Test", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 640, 480, SDL_WINDOW_SHOWN);
-  bool       quit   = false;
-  SDL_Event  event;
-  while (quit == false)
-    while (SDL_PollEvent(&event))
-      if (event.type == SDL_QUIT)
-        quit = true;
+  sdl::event_queue events;
+  while (!events.contains(SDL_QUIT))
+    events.poll();
 }
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <sdl/render.hpp>
+#include <sdl/streaming_texture.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/thread.hpp>
+
+TEST_CASE("Streaming Texture Test")
+{
+  constexpr std::array<std::int32_t, 2> size {32, 16};
+
+  const auto write = [&] (const sdl::streaming_frame& frame, const std::uint32_t value)
+  {
+    for (std::int32_t y = 0; y < frame.size[1]; ++y)
+      for (std::int32_t x = 0; x < frame.size[0]; ++x)
+        reinterpret_cast<std::uint32_t*>(static_cast<std::byte*>(frame.pixels) + y * frame.pitch)[x] = value;
+  };
+  // Draws the texture and returns the value of its pixels, or 0 if they are not uniform (i.e. torn).
+  const auto read  = [&] (const sdl::renderer& renderer, const sdl::surface& target, sdl::native_texture* texture)
+  {
+    REQUIRE(sdl::render_copy(renderer.native(), texture).has_value());
+    const auto value = reinterpret_cast<const std::uint32_t*>(target.row(0).data())[0];
+    for (std::int32_t y = 0; y < size[1]; ++y)
+      for (std::int32_t x = 0; x < size[0]; ++x)
+        if (reinterpret_cast<const std::uint32_t*>(target.row(y).data())[x] != value)
+          return std::uint32_t {0};
+    return value;
+  };
+
+  SUBCASE("Mailbox")
+  {
+    // The ring is declared after the renderer, since its textures must be destroyed before the renderer.
+    auto target   = sdl::make_surface(size).value();
+    auto renderer = sdl::make_renderer(target).value();
+    auto ring     = sdl::make_streaming_texture_ring(renderer, size, SDL_PIXELFORMAT_ARGB8888, 3, sdl::streaming_mode::mailbox);
+    REQUIRE(ring.has_value());
+    auto& stream  = *ring.value();
+    REQUIRE(stream.count() == 3);
+
+    // Nothing is mapped nor displayed before the first update.
+    REQUIRE(!stream.begin_write().has_value());
+    REQUIRE(stream.update().value() == nullptr);
+    for (std::size_t i = 0; i < stream.count(); ++i)
+      REQUIRE(stream.state(i) == sdl::streaming_texture_state::mapped);
+
+    // The newest of the written frames is displayed, the others are dropped.
+    for (std::uint32_t value = 1; value <= 3; ++value)
+    {
+      const auto frame = stream.begin_write();
+      REQUIRE(frame.has_value());
+      REQUIRE(frame->size   == size);
+      REQUIRE(frame->format == SDL_PIXELFORMAT_ARGB8888);
+      write(frame.value(), 0xFF000000 | value);
+      stream.end_write(frame.value());
+    }
+    auto texture = stream.update();
+    REQUIRE(texture.has_value());
+    REQUIRE(texture.value() != nullptr);
+    REQUIRE(read(renderer, target, texture.value()) == 0xFF000003);
+    REQUIRE(stream.statistics().submitted == 3);
+    REQUIRE(stream.statistics().displayed == 1);
+    REQUIRE(stream.statistics().dropped   == 2);
+
+    // The producer never waits: the oldest written frame is reclaimed when none is mapped.
+    for (std::uint32_t value = 4; value <= 7; ++value)
+    {
+      const auto frame = stream.begin_write();
+      REQUIRE(frame.has_value());
+      write(frame.value(), 0xFF000000 | value);
+      stream.end_write(frame.value());
+    }
+    REQUIRE(stream.statistics().dropped == 4);
+    REQUIRE(read(renderer, target, stream.current()) == 0xFF000003);
+    REQUIRE(read(renderer, target, stream.update().value()) == 0xFF000007);
+    REQUIRE(stream.statistics().dropped == 5);
+    REQUIRE(stream.statistics().starved == 1);
+
+    // Canceled frames are not displayed.
+    const auto frame = stream.begin_write();
+    REQUIRE(frame.has_value());
+    stream.cancel_write(frame.value());
+    REQUIRE(read(renderer, target, stream.update().value()) == 0xFF000007);
+    REQUIRE(stream.statistics().displayed == 2);
+
+    stream.close();
+    REQUIRE(!stream.begin_write().has_value());
+  }
+
+  SUBCASE("Fifo")
+  {
+    auto target   = sdl::make_surface(size).value();
+    auto renderer = sdl::make_renderer(target).value();
+    auto stream   = sdl::make_streaming_texture_ring(renderer, size, SDL_PIXELFORMAT_ARGB8888, 2, sdl::streaming_mode::fifo).value();
+    REQUIRE(stream->update().has_value());
+
+    // Each written frame is displayed, in order. The producer is starved while all textures are written.
+    for (std::uint32_t value = 1; value <= 2; ++value)
+    {
+      const auto frame = stream->begin_write();
+      REQUIRE(frame.has_value());
+      write(frame.value(), 0xFF000000 | value);
+      stream->end_write(frame.value());
+    }
+    REQUIRE(!stream->begin_write(std::chrono::milliseconds(1)).has_value());
+    REQUIRE(stream->statistics().starved == 1);
+
+    REQUIRE(read(renderer, target, stream->update().value()) == 0xFF000001);
+    REQUIRE(read(renderer, target, stream->update().value()) == 0xFF000002);
+    REQUIRE(stream->statistics().dropped   == 0);
+    REQUIRE(stream->statistics().displayed == 2);
+
+    // Failing to create textures (e.g. of an invalid size) is reported.
+    REQUIRE(!sdl::make_streaming_texture_ring(renderer, {0, 0}).has_value());
+  }
+
+  SUBCASE("Producer thread")
+  {
+    for (const auto mode : {sdl::streaming_mode::mailbox, sdl::streaming_mode::fifo})
+    {
+      auto target   = sdl::make_surface(size).value();
+      auto renderer = sdl::make_renderer(target).value();
+      auto stream   = sdl::make_streaming_texture_ring(renderer, size, SDL_PIXELFORMAT_ARGB8888, 3, mode).value();
+
+      // The producer writes increasing values, while the render thread draws the displayed textures.
+      {
+        auto producer = sdl::make_thread([&]
+        {
+          for (std::uint32_t value = 1; value <= 200; )
+            if (const auto frame = stream->begin_write(std::chrono::milliseconds(10)))
+            {
+              write(frame.value(), 0xFF000000 | value++);
+              stream->end_write(frame.value());
+            }
+          return 0;
+        }, "streaming_texture_producer");
+        REQUIRE(producer.has_value());
+
+        std::uint32_t previous = 0;
+        while (previous != (0xFF000000 | 200))
+        {
+          const auto texture = stream->update();
+          REQUIRE(texture.has_value());
+          if (!texture.value())
+            continue;
+
+          // Each displayed frame is complete, and newer than the previous one.
+          const auto value = read(renderer, target, texture.value());
+          REQUIRE(value != 0);
+          REQUIRE(value >= previous);
+          if (mode == sdl::streaming_mode::fifo && value != previous)
+            REQUIRE(value == (previous ? previous + 1 : 0xFF000001));
+          previous = value;
+        }
+      }
+
+      const auto statistics = stream->statistics();
+      REQUIRE(statistics.submitted == 200);
+      REQUIRE(statistics.displayed + statistics.dropped == 200);
+      if (mode == sdl::streaming_mode::fifo)
+        REQUIRE(statistics.dropped == 0);
+      REQUIRE(statistics.maximum_latency >= statistics.average_latency);
+    }
+  }
+}
\ No newline at end of file
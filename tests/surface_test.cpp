@@ -0,0 +1,138 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <sdl/surface.hpp>
+
+TEST_CASE("Surface Test")
+{
+  const auto get_pixel = [ ] (const sdl::surface& surface, const std::int32_t x, const std::int32_t y)
+  {
+    std::uint32_t result;
+    std::memcpy(&result, surface.row(y).data() + x * sizeof(std::uint32_t), sizeof(std::uint32_t));
+    return result;
+  };
+
+  SUBCASE("Creation")
+  {
+    auto surface = sdl::make_surface({16, 8});
+    REQUIRE(surface.has_value());
+    REQUIRE(surface->size      () == std::array<std::int32_t, 2> {16, 8});
+    REQUIRE(surface->format    () == SDL_PIXELFORMAT_ARGB8888);
+    REQUIRE(surface->pitch     () >= 16 * 4);
+    REQUIRE(surface->allocation() == sdl::surface_allocation::sdl);
+    REQUIRE(surface->row(3).size() == 16 * 4);
+
+    // The rows of SIMD-allocated surfaces start at aligned addresses.
+    auto aligned = sdl::make_surface({13, 3}, SDL_PIXELFORMAT_RGB24, sdl::surface_allocation::simd);
+    REQUIRE(aligned.has_value());
+    REQUIRE(aligned->allocation() == sdl::surface_allocation::simd);
+    REQUIRE(aligned->pitch() % sdl::simd_get_alignment() == 0);
+    for (std::int32_t y = 0; y < 3; ++y)
+      REQUIRE(reinterpret_cast<std::uintptr_t>(aligned->row(y).data()) % sdl::simd_get_alignment() == 0);
+
+    // The rows of formats with less than a byte per pixel are the bits rounded up to bytes.
+    const auto packed = sdl::make_surface({13, 3}, SDL_PIXELFORMAT_INDEX4MSB, sdl::surface_allocation::simd);
+    REQUIRE(packed.has_value());
+    REQUIRE(packed->pitch() >= 7);
+    REQUIRE(packed->pitch() % sdl::simd_get_alignment() == 0);
+    for (std::int32_t y = 0; y < 3; ++y)
+      REQUIRE(packed->row(y).size() == 7);
+
+    // Surfaces may wrap existing pixels without copying.
+    std::vector<std::uint32_t> pixels(4 * 4);
+    auto wrapped = sdl::make_surface(std::as_writable_bytes(std::span(pixels)), {4, 4}, 16);
+    REQUIRE(wrapped.has_value());
+    REQUIRE(wrapped->fill(0xFF00FF00).has_value());
+    REQUIRE(pixels[15] == 0xFF00FF00);
+    REQUIRE(!sdl::make_surface(std::as_writable_bytes(std::span(pixels)), {4, 8}, 16).has_value());
+
+    // Moving transfers the ownership.
+    auto moved = std::move(aligned.value());
+    REQUIRE(moved  .native());
+    REQUIRE(!aligned->native());
+
+    // Referenced native surfaces are not freed.
+    {
+      sdl::surface reference(moved.native(), false);
+      REQUIRE(reference.size() == std::array<std::int32_t, 2> {13, 3});
+    }
+    REQUIRE(moved.lock().has_value());
+    moved.unlock();
+  }
+
+  SUBCASE("Fill and blit")
+  {
+    auto source      = sdl::make_surface({4, 4}).value();
+    auto destination = sdl::make_surface({8, 8}).value();
+    const auto red   = source.map_rgba({255, 0, 0, 255});
+    const auto blue  = source.map_rgba({0, 0, 255, 255});
+
+    const std::array<sdl::native_rect, 2> rectangles {sdl::native_rect {0, 0, 2, 4}, sdl::native_rect {2, 0, 2, 4}};
+    REQUIRE(source.fill(red , std::span(rectangles).first(1)).has_value());
+    REQUIRE(source.fill(blue, rectangles[1]).has_value());
+    REQUIRE(get_pixel(source, 1, 1) == red );
+    REQUIRE(get_pixel(source, 3, 1) == blue);
+
+    // The color key skips the blue half, and the destination rectangle is clipped.
+    REQUIRE(destination.fill(0xFF000000).has_value());
+    REQUIRE(source.set_color_key(blue).has_value());
+    REQUIRE(source.color_key() == blue);
+    REQUIRE(source.set_blend_mode(sdl::blend_mode::none).has_value());
+    REQUIRE(source.blend_mode() == sdl::blend_mode::none);
+    const auto clipped = source.blit(destination, {6, 6});
+    REQUIRE(clipped.has_value());
+    REQUIRE(clipped->w == 2);
+    REQUIRE(clipped->h == 2);
+    REQUIRE(get_pixel(destination, 6, 6) == red);
+    REQUIRE(get_pixel(destination, 5, 5) == 0xFF000000);
+
+    REQUIRE(source.set_color_key(std::nullopt).has_value());
+    REQUIRE(!source.color_key().has_value());
+    REQUIRE(source.blit(destination, {0, 0}, sdl::native_rect {2, 0, 2, 2}).has_value());
+    REQUIRE(get_pixel(destination, 0, 0) == blue);
+    REQUIRE(get_pixel(destination, 2, 0) == 0xFF000000);
+
+    // Scaled blits cover the target rectangle.
+    REQUIRE(source.blit_scaled(destination).has_value());
+    REQUIRE(get_pixel(destination, 0, 7) == red );
+    REQUIRE(get_pixel(destination, 7, 0) == blue);
+
+    // Clipping restricts fills and blits.
+    REQUIRE(destination.set_clip_rect(sdl::native_rect {0, 0, 4, 4}));
+    REQUIRE(destination.fill(0xFFFFFFFF).has_value());
+    REQUIRE(get_pixel(destination, 3, 3) == 0xFFFFFFFF);
+    REQUIRE(get_pixel(destination, 4, 4) == blue);
+    REQUIRE(sdl::rect_equals(destination.clip_rect(), sdl::native_rect {0, 0, 4, 4}));
+  }
+
+  SUBCASE("Modulation and conversion")
+  {
+    auto surface = sdl::make_surface({2, 2}).value();
+    REQUIRE(surface.fill(surface.map_rgba({10, 20, 30, 255})).has_value());
+
+    REQUIRE(surface.set_color_mod({128, 64, 32}).has_value());
+    REQUIRE(surface.color_mod() == std::array<std::uint8_t, 3> {128, 64, 32});
+    REQUIRE(surface.set_alpha_mod(100).has_value());
+    REQUIRE(surface.alpha_mod() == 100);
+
+    const auto converted = surface.convert(SDL_PIXELFORMAT_ABGR8888);
+    REQUIRE(converted.has_value());
+    REQUIRE(converted->format() == SDL_PIXELFORMAT_ABGR8888);
+    REQUIRE(static_cast<std::uint8_t>(converted->row(1)[0]) == 10);
+    REQUIRE(static_cast<std::uint8_t>(converted->row(1)[2]) == 30);
+
+    const auto duplicate = surface.duplicate();
+    REQUIRE(duplicate.has_value());
+    REQUIRE(std::memcmp(duplicate->row(1).data(), surface.row(1).data(), surface.row(1).size()) == 0);
+
+    std::array<std::uint8_t, 2 * 3> rgb {};
+    REQUIRE(sdl::convert_pixels({2, 1}, surface.format(), surface.row(0).data(), surface.pitch(), SDL_PIXELFORMAT_RGB24, rgb.data(), 6).has_value());
+    REQUIRE(rgb == std::array<std::uint8_t, 6> {10, 20, 30, 10, 20, 30});
+  }
+}
\ No newline at end of file
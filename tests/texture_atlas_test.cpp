@@ -0,0 +1,151 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <sdl/rect_packer.hpp>
+#include <sdl/render.hpp>
+#include <sdl/surface.hpp>
+#include <sdl/texture_atlas.hpp>
+
+TEST_CASE("Texture Atlas Test")
+{
+  SUBCASE("Rect packer")
+  {
+    std::mt19937     generator(5);
+    sdl::rect_packer packer({256, 256});
+
+    const auto overlaps = [ ] (const std::vector<sdl::rectangle<std::int32_t>>& rectangles)
+    {
+      for (std::size_t i = 0; i < rectangles.size(); ++i)
+        for (std::size_t j = i + 1; j < rectangles.size(); ++j)
+          if (rectangles[i].intersects(rectangles[j]))
+            return true;
+      return false;
+    };
+
+    std::vector<sdl::rectangle<std::int32_t>> placed;
+    for (std::size_t i = 0; i < 1000; ++i)
+      if (const auto result = packer.insert({static_cast<std::int32_t>(4 + generator() % 28), static_cast<std::int32_t>(4 + generator() % 28)}))
+      {
+        REQUIRE(result->x >= 0);
+        REQUIRE(result->y >= 0);
+        REQUIRE(result->x + result->w <= 256);
+        REQUIRE(result->y + result->h <= 256);
+        placed.push_back(result.value());
+      }
+    REQUIRE(!overlaps(placed));
+    REQUIRE(packer.count() == placed.size());
+    REQUIRE(packer.occupancy() > 0.8);
+    REQUIRE(!packer.insert({257, 1}).has_value());
+    REQUIRE(!packer.insert({0  , 1}).has_value());
+
+    // Evicting and inserting again, as a cache would.
+    for (std::size_t iteration = 0; iteration < 2000; ++iteration)
+    {
+      const auto index = generator() % placed.size();
+      packer.erase(placed[index]);
+      placed.erase(placed.begin() + static_cast<std::ptrdiff_t>(index));
+      if (const auto result = packer.insert({static_cast<std::int32_t>(4 + generator() % 28), static_cast<std::int32_t>(4 + generator() % 28)}))
+        placed.push_back(result.value());
+    }
+    REQUIRE(!overlaps(placed));
+    REQUIRE(packer.count() == placed.size());
+    for (const auto& free : packer.free_rectangles())
+      for (const auto& used : placed)
+        REQUIRE(!free.intersects(used));
+
+    // An empty packer is reset, hence fits the whole area again.
+    for (const auto& current : placed)
+      packer.erase(current);
+    REQUIRE(packer.count    () == 0);
+    REQUIRE(packer.used_area() == 0);
+    REQUIRE(packer.insert({256, 256}).has_value());
+  }
+
+  SUBCASE("Texture atlas")
+  {
+    // The atlas is declared after the renderer, since its textures must be destroyed before the renderer.
+    auto               target   = sdl::make_surface({32, 32}).value();
+    auto               renderer = sdl::make_renderer(target).value();
+    sdl::texture_atlas atlas({64, 64}, SDL_PIXELFORMAT_ARGB8888, 1);
+
+    std::vector<sdl::surface> images;
+    for (std::int32_t i = 0; i < 12; ++i)
+    {
+      auto image = sdl::make_surface({10 + i, 20}, i % 2 ? SDL_PIXELFORMAT_RGB24 : SDL_PIXELFORMAT_ARGB8888).value();
+      REQUIRE(image.fill(image.map_rgba({static_cast<std::uint8_t>(i * 20), 0, 255, 255})).has_value());
+      images.push_back(std::move(image));
+    }
+    std::vector<const sdl::surface*> pointers;
+    for (const auto& image : images)
+      pointers.push_back(&image);
+
+    const auto handles = atlas.insert(pointers);
+    REQUIRE(handles.has_value());
+    REQUIRE(atlas.size() == images.size());
+    REQUIRE(atlas.page_count() > 1);
+
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+      const auto& region = atlas.region(handles->at(i));
+      REQUIRE(region.area.w == images[i].size()[0]);
+      REQUIRE(region.area.h == images[i].size()[1]);
+      REQUIRE(region.area.x >= 1);
+      REQUIRE(region.area.y >= 1);
+      REQUIRE(region.area.x + region.area.w <= 63);
+      REQUIRE(region.area.y + region.area.h <= 63);
+      REQUIRE(region.uv.x == static_cast<float>(region.area.x) / 64.0f);
+      REQUIRE(region.uv.w == static_cast<float>(region.area.w) / 64.0f);
+
+      // The pixels are converted to the format of the atlas, and the padding is transparent.
+      const auto& page = atlas.page_surface(region.page);
+      const auto  row  = reinterpret_cast<const std::uint32_t*>(page.row(region.area.y).data());
+      REQUIRE(sdl::get_rgba(page.pixel_format(), row[region.area.x    ]) == std::array<std::uint8_t, 4> {static_cast<std::uint8_t>(i * 20), 0, 255, 255});
+      REQUIRE(sdl::get_rgba(page.pixel_format(), row[region.area.x - 1])[3] == 0);
+    }
+
+    // Erased areas and handles are reused.
+    const auto erased = atlas.region(handles->at(3));
+    atlas.erase(handles->at(3));
+    REQUIRE(!atlas.contains(handles->at(3)));
+    const auto reinserted = atlas.insert(images[3]);
+    REQUIRE(reinserted.has_value());
+    REQUIRE(reinserted.value() == handles->at(3));
+    REQUIRE(atlas.region(reinserted.value()).page == erased.page);
+
+    // A source rectangle of a larger image, e.g. a glyph of a font sheet.
+    const auto part = atlas.insert(images[11], sdl::native_rect {2, 2, 4, 4});
+    REQUIRE(part.has_value());
+    REQUIRE(atlas.region(part.value()).area.w == 4);
+    REQUIRE(!atlas.insert(images[11], sdl::native_rect {20, 0, 4, 4}).has_value());
+    REQUIRE(!atlas.insert(sdl::make_surface({64, 64}).value()).has_value());
+
+    // The pages are uploaded to textures, which render the regions.
+    REQUIRE(atlas.upload(renderer).has_value());
+    for (std::size_t i = 0; i < atlas.page_count(); ++i)
+      REQUIRE(atlas.page_texture(i));
+
+    const auto& region = atlas.region(handles->at(5));
+    REQUIRE(renderer.set_draw_color({0, 0, 0, 255}).has_value());
+    REQUIRE(renderer.clear().has_value());
+    REQUIRE(sdl::render_copy(renderer.native(), atlas.page_texture(region.page), region.area, sdl::native_rect {0, 0, region.area.w, region.area.h}).has_value());
+    REQUIRE(sdl::get_rgba(target.pixel_format(), reinterpret_cast<const std::uint32_t*>(target.row(4).data())[4]) == std::array<std::uint8_t, 4> {100, 0, 255, 255});
+
+    // Clearing retains the pages for reuse, whereas resetting releases them.
+    const auto pages = atlas.page_count();
+    atlas.clear();
+    REQUIRE(atlas.size() == 0);
+    REQUIRE(atlas.occupancy() == 0.0);
+    REQUIRE(atlas.page_count() == pages);
+    REQUIRE(atlas.insert(images[0]).has_value());
+    atlas.reset();
+    REQUIRE(atlas.size() == 0);
+    REQUIRE(atlas.page_count() == 0);
+    REQUIRE(atlas.insert(images[0]).has_value());
+    REQUIRE(atlas.page_count() == 1);
+  }
+}
\ No newline at end of file
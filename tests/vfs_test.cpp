@@ -0,0 +1,101 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sdl/rwops.hpp>
+#include <sdl/vfs.hpp>
+
+TEST_CASE("VFS Test")
+{
+  const auto directory = std::filesystem::temp_directory_path() / "sdl_vfs_test";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory / "textures");
+
+  const std::string first  = "packed first";
+  const std::string second = "packed second";
+  const std::string third  = "packed override";
+  const std::string loose  = "loose override";
+  {
+    const std::vector<sdl::pack_entry> entries {
+      {"readme.txt"        , std::as_bytes(std::span(first ))},
+      {"textures/wall.raw" , std::as_bytes(std::span(second))}};
+    auto pack = sdl::make_rw_ops((directory / "a.pack").string(), "wb");
+    REQUIRE(pack.has_value());
+    REQUIRE(sdl::write_pack(pack->native(), entries).has_value());
+  }
+  {
+    const std::vector<sdl::pack_entry> entries {
+      {"textures/wall.raw" , std::as_bytes(std::span(third ))},
+      {"textures/floor.raw", std::as_bytes(std::span(third ))}};
+    auto pack = sdl::make_rw_ops((directory / "b.pack").string(), "wb");
+    REQUIRE(pack.has_value());
+    REQUIRE(sdl::write_pack(pack->native(), entries).has_value());
+  }
+  {
+    const std::vector<sdl::pack_entry> entries {
+      {"nested.txt"        , std::as_bytes(std::span(first ))}};
+    auto pack = sdl::make_rw_ops((directory / "textures" / "nested.pack").string(), "wb");
+    REQUIRE(pack.has_value());
+    REQUIRE(sdl::write_pack(pack->native(), entries).has_value());
+  }
+  {
+    auto file = sdl::make_rw_ops((directory / "textures" / "floor.raw").string(), "wb");
+    REQUIRE(file.has_value());
+    REQUIRE(file->write(loose.data(), 1, loose.size()).has_value());
+  }
+
+  const auto read_all = [ ] (sdl::rw_ops& ops)
+  {
+    std::string result(static_cast<std::size_t>(ops.size().value()), '\0');
+    if (!result.empty())
+      REQUIRE(ops.read(result.data(), 1, result.size()).value() == result.size());
+    return result;
+  };
+
+  {
+    sdl::vfs vfs;
+    REQUIRE(vfs.mount_directory(directory).has_value());
+    REQUIRE(vfs.entries().size() == 3);
+    REQUIRE(vfs.list("textures/").size() == 2);
+    REQUIRE(vfs.exists("readme.txt"));
+    REQUIRE(!vfs.exists("a.pack"));
+    REQUIRE(!vfs.exists("textures/nested.pack")); // Pack archives in subdirectories are neither mounted nor exposed.
+    REQUIRE(!vfs.exists("nested.txt"));
+
+    auto readme = vfs.open("readme.txt");
+    REQUIRE(readme.has_value());
+    REQUIRE(read_all(readme.value()) == first);
+    std::string tail(100, '\0');
+    REQUIRE(readme->seek(7).value() == 7);
+    REQUIRE(readme->read(tail.data(), 1, tail.size()).value() == first.size() - 7); // The window ends with the entry.
+    REQUIRE(tail.starts_with("first"));
+
+    auto wall  = vfs.open("textures/wall.raw");
+    auto floor = vfs.open("textures/floor.raw");
+    REQUIRE(wall .has_value());
+    REQUIRE(floor.has_value());
+    REQUIRE(read_all(wall .value()) == third);
+    REQUIRE(read_all(floor.value()) == loose);
+    REQUIRE(vfs.find("textures/floor.raw")->type == sdl::vfs::entry_type::loose);
+
+    const auto data = vfs.data("readme.txt");
+    REQUIRE(data.has_value());
+    REQUIRE(std::string(reinterpret_cast<const char*>(data->data()), data->size()) == first);
+
+    REQUIRE(vfs.open("missing.txt").has_value() == false);
+
+    std::vector<std::byte> garbage(32, std::byte{1});
+    {
+      auto file = sdl::make_rw_ops((directory / "corrupt.bin").string(), "wb");
+      REQUIRE(file->write(garbage.data(), 1, garbage.size()).has_value());
+    }
+    REQUIRE(vfs.mount_pack(directory / "corrupt.bin").has_value() == false);
+  }
+
+  std::filesystem::remove_all(directory);
+}
\ No newline at end of file